@@ -13,6 +13,14 @@
 #include <summarystatsreduce.h>
 #include <transform.h>
 #include <scalar.h>
+#include <scan.h>
+#include <topk.h>
+#include <histogram.h>
+#include <fusion.h>
+#include <random.h>
+#include <scatter.h>
+#include <permute.h>
+#include <conv2d.h>
 #include <pointercast.h>
 /**
  * Native op executioner:
@@ -214,6 +222,381 @@ public:
                        T *extraParams) {
         return functions::reduce::ReduceFunction<T>::execScalar(opNum, x,xShapeInfo,extraParams);
     }
+
+    /**
+     *
+     * @param opNum
+     * @param x
+     * @param xStride
+     * @param segmentOffsets
+     * @param numSegments
+     * @param extraParams
+     * @param result
+     */
+    static void execReduceSegmented(int opNum,
+                                    T *x,
+                                    int xStride,
+                                    Nd4jIndex *segmentOffsets,
+                                    int numSegments,
+                                    T *extraParams,
+                                    T *result) {
+        functions::reduce::ReduceFunction<T>::execSegmented(opNum, x, xStride, segmentOffsets, numSegments, extraParams, result);
+    }
+
+    /**
+     *
+     * @param opNum
+     * @param x
+     * @param xShapeInfo
+     * @param extraParams
+     * @param result
+     * @param resultShapeInfo
+     * @param dimension
+     * @param dimensionLength
+     * @param exclusive
+     * @param reverse
+     * @param tadShapeInfo
+     * @param tadOffsets
+     */
+    static void execScan(int opNum,
+                         T *x,
+                         int *xShapeInfo,
+                         T *extraParams,
+                         T *result,
+                         int *resultShapeInfo,
+                         int *dimension,
+                         int dimensionLength,
+                         bool exclusive, bool reverse, int *tadShapeInfo, int *tadOffsets) {
+        functions::scan::Scan<T>::exec(opNum, x, xShapeInfo, extraParams, result, resultShapeInfo, dimension, dimensionLength, exclusive, reverse, tadShapeInfo, tadOffsets);
+    }
+
+    /**
+     *
+     * @param x
+     * @param xShapeInfo
+     * @param dimension
+     * @param dimensionLength
+     * @param k
+     * @param largest
+     * @param values
+     * @param indices
+     * @param tadShapeInfo
+     * @param tadOffsets
+     */
+    static void execTopK(T *x,
+                         int *xShapeInfo,
+                         int *dimension,
+                         int dimensionLength,
+                         int k,
+                         bool largest,
+                         T *values,
+                         T *indices, int *tadShapeInfo, int *tadOffsets) {
+        functions::topk::TopK<T>::exec(x, xShapeInfo, dimension, dimensionLength, k, largest, values, indices, tadShapeInfo, tadOffsets);
+    }
+
+    /**
+     *
+     * @param x
+     * @param xShapeInfo
+     * @param dimension
+     * @param dimensionLength
+     * @param numBins
+     * @param min
+     * @param max
+     * @param binEdges
+     * @param result
+     * @param tadShapeInfo
+     * @param tadOffsets
+     */
+    static void execHistogram(T *x,
+                              int *xShapeInfo,
+                              int *dimension,
+                              int dimensionLength,
+                              int numBins,
+                              T min,
+                              T max,
+                              T *binEdges,
+                              T *result, int *tadShapeInfo, int *tadOffsets) {
+        functions::histogram::Histogram<T>::exec(x, xShapeInfo, dimension, dimensionLength, numBins, min, max, binEdges, result, tadShapeInfo, tadOffsets);
+    }
+
+    /**
+     *
+     * @param x
+     * @param xShapeInfo
+     * @param result
+     * @param resultShapeInfo
+     * @param program
+     * @param numOps
+     */
+    static void execFused(T *x,
+                          int *xShapeInfo,
+                          T *result,
+                          int *resultShapeInfo,
+                          functions::fusion::FusedOp<T> *program,
+                          int numOps) {
+        functions::fusion::Fusion<T>::exec(x, xShapeInfo, result, resultShapeInfo, program, numOps);
+    }
+
+    /**
+     *
+     * @param opNum
+     * @param dx
+     * @param xShapeInfo
+     * @param y
+     * @param yShapeInfo
+     * @param result
+     * @param resultShapeInfo
+     * @param extraParams
+     */
+    static void execPairwiseTransformBroadcast(int opNum,
+                                               T *dx,
+                                               int *xShapeInfo,
+                                               T *y,
+                                               int *yShapeInfo,
+                                               T *result,
+                                               int *resultShapeInfo,
+                                               T *extraParams) {
+        functions::pairwise_transforms::PairWiseTransform<T>::execBroadcast(opNum, dx, xShapeInfo, y, yShapeInfo, result, resultShapeInfo, extraParams);
+    }
+
+    /**
+     *
+     * @param opNum
+     * @param seed
+     * @param offset
+     * @param x
+     * @param xShapeInfo
+     * @param result
+     * @param resultShapeInfo
+     * @param extraParams
+     */
+    static void execRandom(int opNum,
+                           Nd4jIndex seed,
+                           Nd4jIndex offset,
+                           T *x,
+                           int *xShapeInfo,
+                           T *result,
+                           int *resultShapeInfo,
+                           T *extraParams) {
+        functions::random::RandomFunction<T>::exec(opNum, seed, offset, x, xShapeInfo, result, resultShapeInfo, extraParams);
+    }
+
+    /**
+     *
+     * @param opNum
+     * @param target
+     * @param targetShapeInfo
+     * @param updates
+     * @param updatesShapeInfo
+     * @param indices
+     * @param extraParams
+     */
+    static void execScatter(int opNum,
+                            T *target,
+                            int *targetShapeInfo,
+                            T *updates,
+                            int *updatesShapeInfo,
+                            Nd4jIndex *indices,
+                            T *extraParams) {
+        functions::scatter::Scatter<T>::exec(opNum, target, targetShapeInfo, updates, updatesShapeInfo, indices, extraParams);
+    }
+
+    /**
+     *
+     * @param input
+     * @param inputShapeInfo
+     * @param weights
+     * @param weightsShapeInfo
+     * @param bias
+     * @param output
+     * @param outputShapeInfo
+     * @param strideH
+     * @param strideW
+     * @param padH
+     * @param padW
+     */
+    static void execConv2d(T *input,
+                           int *inputShapeInfo,
+                           T *weights,
+                           int *weightsShapeInfo,
+                           T *bias,
+                           T *output,
+                           int *outputShapeInfo,
+                           int strideH,
+                           int strideW,
+                           int padH,
+                           int padW) {
+        functions::convolution::Conv2D<T>::forward(input, inputShapeInfo, weights, weightsShapeInfo, bias, output, outputShapeInfo, strideH, strideW, padH, padW);
+    }
+
+    /**
+     *
+     * @param input
+     * @param inputShapeInfo
+     * @param weights
+     * @param weightsShapeInfo
+     * @param epsilon
+     * @param epsilonShapeInfo
+     * @param inputGrad
+     * @param inputGradShapeInfo
+     * @param weightsGrad
+     * @param weightsGradShapeInfo
+     * @param biasGrad
+     * @param strideH
+     * @param strideW
+     * @param padH
+     * @param padW
+     */
+    static void execConv2dBackprop(T *input,
+                                   int *inputShapeInfo,
+                                   T *weights,
+                                   int *weightsShapeInfo,
+                                   T *epsilon,
+                                   int *epsilonShapeInfo,
+                                   T *inputGrad,
+                                   int *inputGradShapeInfo,
+                                   T *weightsGrad,
+                                   int *weightsGradShapeInfo,
+                                   T *biasGrad,
+                                   int strideH,
+                                   int strideW,
+                                   int padH,
+                                   int padW) {
+        functions::convolution::Conv2D<T>::backward(input, inputShapeInfo, weights, weightsShapeInfo, epsilon, epsilonShapeInfo, inputGrad, inputGradShapeInfo, weightsGrad, weightsGradShapeInfo, biasGrad, strideH, strideW, padH, padW);
+    }
+
+    /**
+     *
+     * @param opNum
+     * @param x
+     * @param xShapeInfo
+     * @param mask
+     * @param maskShapeInfo
+     * @param condition
+     * @param extraParams
+     * @param result
+     * @param dimension
+     * @param dimensionLength
+     * @param tadShapeInfo
+     * @param tadOffsets
+     */
+    static void execReduceMasked(int opNum,
+                                 T *x,
+                                 int *xShapeInfo,
+                                 T *mask,
+                                 int *maskShapeInfo,
+                                 T *condition,
+                                 T *extraParams,
+                                 T *result,
+                                 int *dimension,
+                                 int dimensionLength, int *tadShapeInfo, int *tadOffsets) {
+        functions::reduce::ReduceFunction<T>::execMasked(opNum, x, xShapeInfo, mask, maskShapeInfo, condition, extraParams, result, dimension, dimensionLength, tadShapeInfo, tadOffsets);
+    }
+
+    /**
+     *
+     * @param opNum
+     * @param x
+     * @param xShapeInfo
+     * @param mask
+     * @param maskShapeInfo
+     * @param condition
+     * @param extraParams
+     * @param result
+     * @param dimension
+     * @param dimensionLength
+     * @param biasCorrected
+     * @param tadShapeInfo
+     * @param tadOffsets
+     */
+    static void execSummaryStatsMasked(int opNum,
+                                       T *x,
+                                       int *xShapeInfo,
+                                       T *mask,
+                                       int *maskShapeInfo,
+                                       T *condition,
+                                       T *extraParams,
+                                       T *result,
+                                       int *dimension,
+                                       int dimensionLength, bool biasCorrected, int *tadShapeInfo, int *tadOffsets) {
+        functions::summarystats::SummaryStatsReduce<T>::execMasked(opNum, biasCorrected, x, xShapeInfo, mask, maskShapeInfo, condition, extraParams, result, dimension, dimensionLength, tadShapeInfo, tadOffsets);
+    }
+
+    /**
+     *
+     * @param opNum
+     * @param x
+     * @param xShapeInfo
+     * @param mask
+     * @param maskShapeInfo
+     * @param condition
+     * @param extraParams
+     * @param result
+     * @param dimension
+     * @param dimensionLength
+     * @param tadShapeInfo
+     * @param tadOffsets
+     */
+    static void execIndexReduceMasked(int opNum,
+                                      T *x,
+                                      int *xShapeInfo,
+                                      T *mask,
+                                      int *maskShapeInfo,
+                                      T *condition,
+                                      T *extraParams,
+                                      T *result,
+                                      int *dimension,
+                                      int dimensionLength, int *tadShapeInfo, int *tadOffsets) {
+        functions::indexreduce::IndexReduce<T>::execMasked(opNum, x, xShapeInfo, mask, maskShapeInfo, condition, extraParams, result, dimension, dimensionLength, tadShapeInfo, tadOffsets);
+    }
+
+    /**
+     *
+     * @param state
+     * @param x
+     * @param xShapeInfo
+     * @param extraParams
+     */
+    static void execAccumulateReductionState(functions::reduce::ReductionState<T> *state,
+                                             T *x,
+                                             int *xShapeInfo,
+                                             T *extraParams) {
+        functions::reduce::ReduceFunction<T>::accumulateState(state, x, xShapeInfo, extraParams);
+    }
+
+    /**
+     *
+     * @param state
+     * @param other
+     * @param extraParams
+     */
+    static void execMergeReductionState(functions::reduce::ReductionState<T> *state,
+                                        functions::reduce::ReductionState<T> *other,
+                                        T *extraParams) {
+        functions::reduce::ReduceFunction<T>::mergeState(state, other, extraParams);
+    }
+
+    /**
+     *
+     * @param state
+     * @param extraParams
+     * @return
+     */
+    static T execFinalizeReductionState(functions::reduce::ReductionState<T> *state,
+                                        T *extraParams) {
+        return functions::reduce::ReduceFunction<T>::finalizeState(state, extraParams);
+    }
+
+    /**
+     *
+     * @param state
+     * @param result
+     */
+    static void execFinalizeSummaryState(functions::reduce::ReductionState<T> *state,
+                                         T *result) {
+        functions::reduce::ReduceFunction<T>::finalizeSummary(state, result);
+    }
     /**
      *
      * @param opNum
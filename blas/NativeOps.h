@@ -168,6 +168,9 @@ public:
             Nd4jPointer extraParams);
 
     /**
+     * Standard deviation (opNum 9) and variance (opNum 10) come from
+     * running moments on cpu: extraParams isn't read for them, the
+     * mean is computed in the same pass and no bias term is applied.
      *
      * @param opNum
      * @param x
@@ -184,6 +187,9 @@ public:
                             Nd4jPointer resultShapeInfo);
 
     /**
+     * Standard deviation (opNum 9) and variance (opNum 10) come from
+     * running moments on cpu: extraParams isn't read for them, the
+     * mean is computed in the same pass and no bias term is applied.
      *
      * @param opNum
      * @param x
@@ -201,6 +207,9 @@ public:
                             Nd4jPointer dimension,int dimensionLength);
 
     /**
+     * Standard deviation (opNum 9) and variance (opNum 10) come from
+     * running moments on cpu: extraParams isn't read for them, the
+     * mean is computed in the same pass and no bias term is applied.
      *
      * @param opNum
      * @param x
@@ -609,6 +618,9 @@ public:
                                     Nd4jPointer extraParams);
 
     /**
+     * Standard deviation (opNum 9) and variance (opNum 10) come from
+     * running moments on cpu: extraParams isn't read for them, the
+     * mean is computed in the same pass and no bias term is applied.
      *
      * @param opNum
      * @param x
@@ -632,6 +644,9 @@ public:
                            Nd4jPointer resultShapeInfo);
 
     /**
+     * Standard deviation (opNum 9) and variance (opNum 10) come from
+     * running moments on cpu: extraParams isn't read for them, the
+     * mean is computed in the same pass and no bias term is applied.
      *
      * @param opNum
      * @param x
@@ -657,6 +672,9 @@ public:
                            Nd4jPointer dimension,int dimensionLength);
 
     /**
+     * Standard deviation (opNum 9) and variance (opNum 10) come from
+     * running moments on cpu: extraParams isn't read for them, the
+     * mean is computed in the same pass and no bias term is applied.
      *
      * @param opNum
      * @param x
@@ -674,6 +692,697 @@ public:
                                 Nd4jPointer xShapeInfo,
                                 Nd4jPointer extraParams);
 
+    /**
+     * Reduces variable length segments of x in one call.
+     * Segment i covers elements [segmentOffsets[i], segmentOffsets[i + 1])
+     * of x and its result is stored in result[i].
+     *
+     * @param opNum the reduce op
+     * @param x the input buffer
+     * @param xStride the element wise stride of x
+     * @param extraParams the extra params for the op
+     * @param result the results, numSegments entries
+     * @param segmentOffsets numSegments + 1 element (long) offsets
+     * @param numSegments the number of segments
+     */
+    void   execReduceSegmentedDouble(Nd4jPointer *extraPointers,int opNum,
+                                     Nd4jPointer x,
+                                     int xStride,
+                                     Nd4jPointer extraParams,
+                                     Nd4jPointer result,
+                                     Nd4jPointer segmentOffsets,
+                                     int numSegments);
+
+    void   execReduceSegmentedFloat(Nd4jPointer *extraPointers,int opNum,
+                                    Nd4jPointer x,
+                                    int xStride,
+                                    Nd4jPointer extraParams,
+                                    Nd4jPointer result,
+                                    Nd4jPointer segmentOffsets,
+                                    int numSegments);
+
+    void   execReduceSegmentedHalf(Nd4jPointer *extraPointers,int opNum,
+                                   Nd4jPointer x,
+                                   int xStride,
+                                   Nd4jPointer extraParams,
+                                   Nd4jPointer result,
+                                   Nd4jPointer segmentOffsets,
+                                   int numSegments);
+
+    /**
+     * Inclusive or exclusive scan along dimensions:
+     * 0 - cumulative sum, 1 - cumulative product,
+     * 2 - cumulative max, 3 - cumulative min
+     *
+     * extraPointers[0] and extraPointers[1] may hold
+     * precomputed tad shape information and offsets for x
+     *
+     * @param opNum the scan op
+     * @param x the input
+     * @param xShapeInfo the shape information for the input
+     * @param extraParams the extra params for the op
+     * @param result the result, same shape as the input
+     * @param resultShapeInfo the shape information for the result
+     * @param dimension the dimensions to scan along, MAX_DIMENSION scans the whole array
+     * @param dimensionLength the number of dimensions
+     * @param exclusive whether to leave out the current element
+     * @param reverse whether to scan from the last element to the first
+     */
+    void   execScanDouble(Nd4jPointer *extraPointers,int opNum,
+                          Nd4jPointer x,
+                          Nd4jPointer xShapeInfo,
+                          Nd4jPointer extraParams,
+                          Nd4jPointer result,
+                          Nd4jPointer resultShapeInfo,
+                          Nd4jPointer dimension,int dimensionLength,
+                          bool exclusive, bool reverse);
+
+    void   execScanFloat(Nd4jPointer *extraPointers,int opNum,
+                         Nd4jPointer x,
+                         Nd4jPointer xShapeInfo,
+                         Nd4jPointer extraParams,
+                         Nd4jPointer result,
+                         Nd4jPointer resultShapeInfo,
+                         Nd4jPointer dimension,int dimensionLength,
+                         bool exclusive, bool reverse);
+
+    void   execScanHalf(Nd4jPointer *extraPointers,int opNum,
+                        Nd4jPointer x,
+                        Nd4jPointer xShapeInfo,
+                        Nd4jPointer extraParams,
+                        Nd4jPointer result,
+                        Nd4jPointer resultShapeInfo,
+                        Nd4jPointer dimension,int dimensionLength,
+                        bool exclusive, bool reverse);
+
+    /**
+     * K largest (or smallest) values per tad and their indices
+     * within the tad, sorted best first. Ties go to the lower index.
+     *
+     * extraPointers[0] and extraPointers[1] may hold
+     * precomputed tad shape information and offsets for x
+     *
+     * @param x the input
+     * @param xShapeInfo the shape information for the input
+     * @param dimension the dimensions to search along, MAX_DIMENSION for the whole array
+     * @param dimensionLength the number of dimensions
+     * @param k the number of elements per tad, slots past the tad length get value 0 and index -1
+     * @param largest true for the largest, false for the smallest elements
+     * @param values numTads * k values
+     * @param indices numTads * k indices
+     */
+    void   execTopKDouble(Nd4jPointer *extraPointers,
+                          Nd4jPointer x,
+                          Nd4jPointer xShapeInfo,
+                          Nd4jPointer dimension,int dimensionLength,
+                          int k,
+                          bool largest,
+                          Nd4jPointer values,
+                          Nd4jPointer indices);
+
+    void   execTopKFloat(Nd4jPointer *extraPointers,
+                         Nd4jPointer x,
+                         Nd4jPointer xShapeInfo,
+                         Nd4jPointer dimension,int dimensionLength,
+                         int k,
+                         bool largest,
+                         Nd4jPointer values,
+                         Nd4jPointer indices);
+
+    void   execTopKHalf(Nd4jPointer *extraPointers,
+                        Nd4jPointer x,
+                        Nd4jPointer xShapeInfo,
+                        Nd4jPointer dimension,int dimensionLength,
+                        int k,
+                        bool largest,
+                        Nd4jPointer values,
+                        Nd4jPointer indices);
+
+    /**
+     * Histogram of every tad, numBins counts per tad.
+     *
+     * Bins are equal width over [min, max] or given by numBins + 1
+     * ascending binEdges. With min == max and no edges every tad is
+     * binned over its own range. Values outside the range are not counted.
+     *
+     * extraPointers[0] and extraPointers[1] may hold
+     * precomputed tad shape information and offsets for x
+     *
+     * @param x the input
+     * @param xShapeInfo the shape information for the input
+     * @param dimension the dimensions to bin along, MAX_DIMENSION for the whole array
+     * @param dimensionLength the number of dimensions
+     * @param numBins the number of bins
+     * @param min the lower edge of the first bin
+     * @param max the upper edge of the last bin
+     * @param binEdges optional numBins + 1 bin edges
+     * @param result numTads * numBins counts
+     */
+    void   execHistogramDouble(Nd4jPointer *extraPointers,
+                               Nd4jPointer x,
+                               Nd4jPointer xShapeInfo,
+                               Nd4jPointer dimension,int dimensionLength,
+                               int numBins,
+                               double min,
+                               double max,
+                               Nd4jPointer binEdges,
+                               Nd4jPointer result);
+
+    void   execHistogramFloat(Nd4jPointer *extraPointers,
+                              Nd4jPointer x,
+                              Nd4jPointer xShapeInfo,
+                              Nd4jPointer dimension,int dimensionLength,
+                              int numBins,
+                              float min,
+                              float max,
+                              Nd4jPointer binEdges,
+                              Nd4jPointer result);
+
+    void   execHistogramHalf(Nd4jPointer *extraPointers,
+                             Nd4jPointer x,
+                             Nd4jPointer xShapeInfo,
+                             Nd4jPointer dimension,int dimensionLength,
+                             int numBins,
+                             float min,
+                             float max,
+                             Nd4jPointer binEdges,
+                             Nd4jPointer result);
+
+    /**
+     * Reduce, summary stats and index reduce ops restricted to selected
+     * elements of every tad, in a single pass over x.
+     *
+     * Elements are selected by mask (same shape as x, non zero entries
+     * are used) or, when mask is null, by condition: {compare, eps, mode}
+     * encoded as for MatchCondition. A mask of any other shape than x
+     * is rejected. Reductions of tads without selected elements give
+     * the value of an empty input (e.g. -MAX_FLOAT for max), summary
+     * stats give 0, index reductions return -1 for them and otherwise
+     * the position within the tad.
+     *
+     * extraPointers[0] and extraPointers[1] may hold
+     * precomputed tad shape information and offsets for x
+     *
+     * @param opNum the op number
+     * @param x the input
+     * @param xShapeInfo the shape information for the input
+     * @param mask optional mask
+     * @param maskShapeInfo the shape information for the mask
+     * @param condition the condition, used without a mask
+     * @param extraParams the extra params for the op
+     * @param result one value per tad
+     * @param dimension the dimensions to reduce along, MAX_DIMENSION for the whole array
+     * @param dimensionLength the number of dimensions
+     */
+    void   execReduceMaskedDouble(Nd4jPointer *extraPointers,int opNum,
+                                  Nd4jPointer x,
+                                  Nd4jPointer xShapeInfo,
+                                  Nd4jPointer mask,
+                                  Nd4jPointer maskShapeInfo,
+                                  Nd4jPointer condition,
+                                  Nd4jPointer extraParams,
+                                  Nd4jPointer result,
+                                  Nd4jPointer dimension,int dimensionLength);
+
+    void   execReduceMaskedFloat(Nd4jPointer *extraPointers,int opNum,
+                                 Nd4jPointer x,
+                                 Nd4jPointer xShapeInfo,
+                                 Nd4jPointer mask,
+                                 Nd4jPointer maskShapeInfo,
+                                 Nd4jPointer condition,
+                                 Nd4jPointer extraParams,
+                                 Nd4jPointer result,
+                                 Nd4jPointer dimension,int dimensionLength);
+
+    void   execReduceMaskedHalf(Nd4jPointer *extraPointers,int opNum,
+                                Nd4jPointer x,
+                                Nd4jPointer xShapeInfo,
+                                Nd4jPointer mask,
+                                Nd4jPointer maskShapeInfo,
+                                Nd4jPointer condition,
+                                Nd4jPointer extraParams,
+                                Nd4jPointer result,
+                                Nd4jPointer dimension,int dimensionLength);
+
+    void   execSummaryStatsMaskedDouble(Nd4jPointer *extraPointers,int opNum,
+                                        Nd4jPointer x,
+                                        Nd4jPointer xShapeInfo,
+                                        Nd4jPointer mask,
+                                        Nd4jPointer maskShapeInfo,
+                                        Nd4jPointer condition,
+                                        Nd4jPointer extraParams,
+                                        Nd4jPointer result,
+                                        Nd4jPointer dimension,int dimensionLength,
+                                        bool biasCorrected);
+
+    void   execSummaryStatsMaskedFloat(Nd4jPointer *extraPointers,int opNum,
+                                       Nd4jPointer x,
+                                       Nd4jPointer xShapeInfo,
+                                       Nd4jPointer mask,
+                                       Nd4jPointer maskShapeInfo,
+                                       Nd4jPointer condition,
+                                       Nd4jPointer extraParams,
+                                       Nd4jPointer result,
+                                       Nd4jPointer dimension,int dimensionLength,
+                                       bool biasCorrected);
+
+    void   execSummaryStatsMaskedHalf(Nd4jPointer *extraPointers,int opNum,
+                                      Nd4jPointer x,
+                                      Nd4jPointer xShapeInfo,
+                                      Nd4jPointer mask,
+                                      Nd4jPointer maskShapeInfo,
+                                      Nd4jPointer condition,
+                                      Nd4jPointer extraParams,
+                                      Nd4jPointer result,
+                                      Nd4jPointer dimension,int dimensionLength,
+                                      bool biasCorrected);
+
+    void   execIndexReduceMaskedDouble(Nd4jPointer *extraPointers,int opNum,
+                                       Nd4jPointer x,
+                                       Nd4jPointer xShapeInfo,
+                                       Nd4jPointer mask,
+                                       Nd4jPointer maskShapeInfo,
+                                       Nd4jPointer condition,
+                                       Nd4jPointer extraParams,
+                                       Nd4jPointer result,
+                                       Nd4jPointer dimension,int dimensionLength);
+
+    void   execIndexReduceMaskedFloat(Nd4jPointer *extraPointers,int opNum,
+                                      Nd4jPointer x,
+                                      Nd4jPointer xShapeInfo,
+                                      Nd4jPointer mask,
+                                      Nd4jPointer maskShapeInfo,
+                                      Nd4jPointer condition,
+                                      Nd4jPointer extraParams,
+                                      Nd4jPointer result,
+                                      Nd4jPointer dimension,int dimensionLength);
+
+    void   execIndexReduceMaskedHalf(Nd4jPointer *extraPointers,int opNum,
+                                     Nd4jPointer x,
+                                     Nd4jPointer xShapeInfo,
+                                     Nd4jPointer mask,
+                                     Nd4jPointer maskShapeInfo,
+                                     Nd4jPointer condition,
+                                     Nd4jPointer extraParams,
+                                     Nd4jPointer result,
+                                     Nd4jPointer dimension,int dimensionLength);
+
+    /**
+     * Runs a chain of element wise ops as one pass over x, the output
+     * of every step is the input of the next one (see fusion.h).
+     *
+     * Step i is a transform (opTypes[i] == 0), scalar (1) or pairwise (2)
+     * op with number opNums[i]. Scalar steps use scalars[i], pairwise steps
+     * use operands[i] (same shape as x) as the second argument, extraParams[i]
+     * may be null. Transforms that need the whole array can't be fused.
+     *
+     * @param x the input
+     * @param xShapeInfo the shape information for the input
+     * @param result the result buffer
+     * @param resultShapeInfo the shape information for the result
+     * @param numOps the number of steps
+     * @param opTypes numOps op types (int)
+     * @param opNums numOps op numbers (int)
+     * @param scalars numOps scalars
+     * @param operands numOps pairwise operands, null for other steps
+     * @param operandShapeInfos numOps pairwise operand shape information
+     * @param extraParams numOps extra params
+     */
+    void   execFusedDouble(Nd4jPointer *extraPointers,
+                           Nd4jPointer x,
+                           Nd4jPointer xShapeInfo,
+                           Nd4jPointer result,
+                           Nd4jPointer resultShapeInfo,
+                           int numOps,
+                           Nd4jPointer opTypes,
+                           Nd4jPointer opNums,
+                           Nd4jPointer scalars,
+                           Nd4jPointer *operands,
+                           Nd4jPointer *operandShapeInfos,
+                           Nd4jPointer *extraParams);
+
+    void   execFusedFloat(Nd4jPointer *extraPointers,
+                          Nd4jPointer x,
+                          Nd4jPointer xShapeInfo,
+                          Nd4jPointer result,
+                          Nd4jPointer resultShapeInfo,
+                          int numOps,
+                          Nd4jPointer opTypes,
+                          Nd4jPointer opNums,
+                          Nd4jPointer scalars,
+                          Nd4jPointer *operands,
+                          Nd4jPointer *operandShapeInfos,
+                          Nd4jPointer *extraParams);
+
+    void   execFusedHalf(Nd4jPointer *extraPointers,
+                         Nd4jPointer x,
+                         Nd4jPointer xShapeInfo,
+                         Nd4jPointer result,
+                         Nd4jPointer resultShapeInfo,
+                         int numOps,
+                         Nd4jPointer opTypes,
+                         Nd4jPointer opNums,
+                         Nd4jPointer scalars,
+                         Nd4jPointer *operands,
+                         Nd4jPointer *operandShapeInfos,
+                         Nd4jPointer *extraParams);
+
+    /**
+     * Pairwise transform with numpy style broadcasting: x and y are
+     * aligned on their last dimension and size 1 (or missing) dimensions
+     * are repeated, without materialising the expanded operand.
+     *
+     * @param opNum the op number
+     * @param dx the first operand
+     * @param xShapeInfo the shape information for the first operand
+     * @param y the second operand
+     * @param yShapeInfo the shape information for the second operand
+     * @param result the result buffer
+     * @param resultShapeInfo the shape information for the result, the broadcast shape
+     * @param extraParams the extra params for the op
+     */
+    void   execPairwiseTransformBroadcastDouble(Nd4jPointer *extraPointers,int opNum,
+                                                Nd4jPointer dx,
+                                                Nd4jPointer xShapeInfo,
+                                                Nd4jPointer y,
+                                                Nd4jPointer yShapeInfo,
+                                                Nd4jPointer result,
+                                                Nd4jPointer resultShapeInfo,
+                                                Nd4jPointer extraParams);
+
+    void   execPairwiseTransformBroadcastFloat(Nd4jPointer *extraPointers,int opNum,
+                                               Nd4jPointer dx,
+                                               Nd4jPointer xShapeInfo,
+                                               Nd4jPointer y,
+                                               Nd4jPointer yShapeInfo,
+                                               Nd4jPointer result,
+                                               Nd4jPointer resultShapeInfo,
+                                               Nd4jPointer extraParams);
+
+    void   execPairwiseTransformBroadcastHalf(Nd4jPointer *extraPointers,int opNum,
+                                              Nd4jPointer dx,
+                                              Nd4jPointer xShapeInfo,
+                                              Nd4jPointer y,
+                                              Nd4jPointer yShapeInfo,
+                                              Nd4jPointer result,
+                                              Nd4jPointer resultShapeInfo,
+                                              Nd4jPointer extraParams);
+
+    /**
+     * Random fills and dropout (see random.h). The numbers drawn only
+     * depend on seed, offset and the shape of result, so they are
+     * reproducible regardless of the number of threads.
+     *
+     * @param opNum the op number
+     * @param seed the seed of the stream
+     * @param offset the counter of the first element, the previous offset
+     * plus the previous length continues a stream
+     * @param x the input for the dropout ops, null for the distributions
+     * @param xShapeInfo the shape information for the input
+     * @param result the result buffer
+     * @param resultShapeInfo the shape information for the result
+     * @param extraParams the parameters of the distribution
+     */
+    void   execRandomDouble(Nd4jPointer *extraPointers,
+                            int opNum,
+                            Nd4jIndex seed,
+                            Nd4jIndex offset,
+                            Nd4jPointer x,
+                            Nd4jPointer xShapeInfo,
+                            Nd4jPointer result,
+                            Nd4jPointer resultShapeInfo,
+                            Nd4jPointer extraParams);
+
+    void   execRandomFloat(Nd4jPointer *extraPointers,
+                           int opNum,
+                           Nd4jIndex seed,
+                           Nd4jIndex offset,
+                           Nd4jPointer x,
+                           Nd4jPointer xShapeInfo,
+                           Nd4jPointer result,
+                           Nd4jPointer resultShapeInfo,
+                           Nd4jPointer extraParams);
+
+    void   execRandomHalf(Nd4jPointer *extraPointers,
+                          int opNum,
+                          Nd4jIndex seed,
+                          Nd4jIndex offset,
+                          Nd4jPointer x,
+                          Nd4jPointer xShapeInfo,
+                          Nd4jPointer result,
+                          Nd4jPointer resultShapeInfo,
+                          Nd4jPointer extraParams);
+
+    /**
+     * Scatters rows of updates into the rows of target picked by indices
+     * (target[indices[i]] = op(target[indices[i]], updates[i]), see scatter.h).
+     * Indices may repeat, the result doesn't depend on the number of threads.
+     *
+     * @param opNum the op number
+     * @param target the array updated in place
+     * @param targetShapeInfo the shape information for the target
+     * @param updates the update rows, one per index
+     * @param updatesShapeInfo the shape information for the updates
+     * @param indices the target row of every update row
+     * @param extraParams the extra params for the op
+     */
+    void   execScatterDouble(Nd4jPointer *extraPointers,
+                             int opNum,
+                             Nd4jPointer target,
+                             Nd4jPointer targetShapeInfo,
+                             Nd4jPointer updates,
+                             Nd4jPointer updatesShapeInfo,
+                             Nd4jPointer indices,
+                             Nd4jPointer extraParams);
+
+    void   execScatterFloat(Nd4jPointer *extraPointers,
+                            int opNum,
+                            Nd4jPointer target,
+                            Nd4jPointer targetShapeInfo,
+                            Nd4jPointer updates,
+                            Nd4jPointer updatesShapeInfo,
+                            Nd4jPointer indices,
+                            Nd4jPointer extraParams);
+
+    void   execScatterHalf(Nd4jPointer *extraPointers,
+                           int opNum,
+                           Nd4jPointer target,
+                           Nd4jPointer targetShapeInfo,
+                           Nd4jPointer updates,
+                           Nd4jPointer updatesShapeInfo,
+                           Nd4jPointer indices,
+                           Nd4jPointer extraParams);
+
+    /**
+     * 2d convolution of an NCHW input, packing tiles of the im2col
+     * matrix on the fly instead of materialising it (see conv2d.h)
+     *
+     * @param input the input [n, c, h, w]
+     * @param inputShapeInfo the shape information for the input
+     * @param weights the kernels [outC, c, kH, kW]
+     * @param weightsShapeInfo the shape information for the weights
+     * @param bias outC contiguous values, or null
+     * @param output the result buffer [n, outC, outH, outW]
+     * @param outputShapeInfo the shape information for the result
+     * @param strideH the vertical stride
+     * @param strideW the horizontal stride
+     * @param padH the zero padding above and below the input
+     * @param padW the zero padding left and right of the input
+     */
+    void   execConv2dDouble(Nd4jPointer *extraPointers,
+                            Nd4jPointer input,
+                            Nd4jPointer inputShapeInfo,
+                            Nd4jPointer weights,
+                            Nd4jPointer weightsShapeInfo,
+                            Nd4jPointer bias,
+                            Nd4jPointer output,
+                            Nd4jPointer outputShapeInfo,
+                            int strideH,
+                            int strideW,
+                            int padH,
+                            int padW);
+
+    void   execConv2dFloat(Nd4jPointer *extraPointers,
+                           Nd4jPointer input,
+                           Nd4jPointer inputShapeInfo,
+                           Nd4jPointer weights,
+                           Nd4jPointer weightsShapeInfo,
+                           Nd4jPointer bias,
+                           Nd4jPointer output,
+                           Nd4jPointer outputShapeInfo,
+                           int strideH,
+                           int strideW,
+                           int padH,
+                           int padW);
+
+    void   execConv2dHalf(Nd4jPointer *extraPointers,
+                          Nd4jPointer input,
+                          Nd4jPointer inputShapeInfo,
+                          Nd4jPointer weights,
+                          Nd4jPointer weightsShapeInfo,
+                          Nd4jPointer bias,
+                          Nd4jPointer output,
+                          Nd4jPointer outputShapeInfo,
+                          int strideH,
+                          int strideW,
+                          int padH,
+                          int padW);
+
+    /**
+     * Gradients of execConv2d for the gradient epsilon of its output.
+     * inputGrad, weightsGrad and biasGrad may each be null to skip them,
+     * the others are overwritten
+     *
+     * @param input the input of the forward pass [n, c, h, w]
+     * @param inputShapeInfo the shape information for the input
+     * @param weights the kernels [outC, c, kH, kW]
+     * @param weightsShapeInfo the shape information for the weights
+     * @param epsilon the gradient of the output [n, outC, outH, outW]
+     * @param epsilonShapeInfo the shape information for epsilon
+     * @param inputGrad the gradient of the input, shaped like the input
+     * @param inputGradShapeInfo the shape information for inputGrad
+     * @param weightsGrad the gradient of the weights, shaped like the weights
+     * @param weightsGradShapeInfo the shape information for weightsGrad
+     * @param biasGrad outC contiguous values for the gradient of the bias
+     * @param strideH the vertical stride
+     * @param strideW the horizontal stride
+     * @param padH the zero padding above and below the input
+     * @param padW the zero padding left and right of the input
+     */
+    void   execConv2dBackpropDouble(Nd4jPointer *extraPointers,
+                                    Nd4jPointer input,
+                                    Nd4jPointer inputShapeInfo,
+                                    Nd4jPointer weights,
+                                    Nd4jPointer weightsShapeInfo,
+                                    Nd4jPointer epsilon,
+                                    Nd4jPointer epsilonShapeInfo,
+                                    Nd4jPointer inputGrad,
+                                    Nd4jPointer inputGradShapeInfo,
+                                    Nd4jPointer weightsGrad,
+                                    Nd4jPointer weightsGradShapeInfo,
+                                    Nd4jPointer biasGrad,
+                                    int strideH,
+                                    int strideW,
+                                    int padH,
+                                    int padW);
+
+    void   execConv2dBackpropFloat(Nd4jPointer *extraPointers,
+                                   Nd4jPointer input,
+                                   Nd4jPointer inputShapeInfo,
+                                   Nd4jPointer weights,
+                                   Nd4jPointer weightsShapeInfo,
+                                   Nd4jPointer epsilon,
+                                   Nd4jPointer epsilonShapeInfo,
+                                   Nd4jPointer inputGrad,
+                                   Nd4jPointer inputGradShapeInfo,
+                                   Nd4jPointer weightsGrad,
+                                   Nd4jPointer weightsGradShapeInfo,
+                                   Nd4jPointer biasGrad,
+                                   int strideH,
+                                   int strideW,
+                                   int padH,
+                                   int padW);
+
+    void   execConv2dBackpropHalf(Nd4jPointer *extraPointers,
+                                  Nd4jPointer input,
+                                  Nd4jPointer inputShapeInfo,
+                                  Nd4jPointer weights,
+                                  Nd4jPointer weightsShapeInfo,
+                                  Nd4jPointer epsilon,
+                                  Nd4jPointer epsilonShapeInfo,
+                                  Nd4jPointer inputGrad,
+                                  Nd4jPointer inputGradShapeInfo,
+                                  Nd4jPointer weightsGrad,
+                                  Nd4jPointer weightsGradShapeInfo,
+                                  Nd4jPointer biasGrad,
+                                  int strideH,
+                                  int strideW,
+                                  int padH,
+                                  int padW);
+
+    /**
+     * Reductions over data that arrives in chunks.
+     *
+     * createReductionState returns an empty partial reduction for the
+     * given reduce op, accumulateReductionState folds x into it, states
+     * built from different chunks (of the same op) can be combined with
+     * mergeReductionState, finalizeReductionState returns the reduction
+     * of everything seen so far and can be called any number of times.
+     * States have to be released with destroyReductionState.
+     *
+     * Counts are kept as 64 bit integers and variance/standard deviation
+     * use exact running moments (their extraParams aren't read), so
+     * results are the same (up to rounding) as a single reduction over
+     * the concatenated data.
+     *
+     * opNum -1 creates a summary state, which keeps count, mean, variance,
+     * min and max together and is read with finalizeSummaryState.
+     * States of different ops can't be merged.
+     */
+    Nd4jPointer createReductionStateDouble(int opNum);
+
+    void   accumulateReductionStateDouble(Nd4jPointer *extraPointers,
+                                          Nd4jPointer state,
+                                          Nd4jPointer x,
+                                          Nd4jPointer xShapeInfo,
+                                          Nd4jPointer extraParams);
+
+    void   mergeReductionStateDouble(Nd4jPointer state,
+                                     Nd4jPointer other,
+                                     Nd4jPointer extraParams);
+
+    double finalizeReductionStateDouble(Nd4jPointer state,
+                                        Nd4jPointer extraParams);
+
+    void   destroyReductionStateDouble(Nd4jPointer state);
+
+    Nd4jPointer createReductionStateFloat(int opNum);
+
+    void   accumulateReductionStateFloat(Nd4jPointer *extraPointers,
+                                         Nd4jPointer state,
+                                         Nd4jPointer x,
+                                         Nd4jPointer xShapeInfo,
+                                         Nd4jPointer extraParams);
+
+    void   mergeReductionStateFloat(Nd4jPointer state,
+                                    Nd4jPointer other,
+                                    Nd4jPointer extraParams);
+
+    float  finalizeReductionStateFloat(Nd4jPointer state,
+                                       Nd4jPointer extraParams);
+
+    void   destroyReductionStateFloat(Nd4jPointer state);
+
+    Nd4jPointer createReductionStateHalf(int opNum);
+
+    void   accumulateReductionStateHalf(Nd4jPointer *extraPointers,
+                                        Nd4jPointer state,
+                                        Nd4jPointer x,
+                                        Nd4jPointer xShapeInfo,
+                                        Nd4jPointer extraParams);
+
+    void   mergeReductionStateHalf(Nd4jPointer state,
+                                   Nd4jPointer other,
+                                   Nd4jPointer extraParams);
+
+    float  finalizeReductionStateHalf(Nd4jPointer state,
+                                      Nd4jPointer extraParams);
+
+    void   destroyReductionStateHalf(Nd4jPointer state);
+
+    /**
+     * Writes {count, mean, variance, min, max} of a summary
+     * state (opNum -1) to result, the variance is bias corrected
+     */
+    void   finalizeSummaryStateDouble(Nd4jPointer state,
+                                      Nd4jPointer result);
+
+    void   finalizeSummaryStateFloat(Nd4jPointer state,
+                                     Nd4jPointer result);
+
+    void   finalizeSummaryStateHalf(Nd4jPointer state,
+                                    Nd4jPointer result);
+
     /**
      *
      * @param opNum
@@ -1104,6 +1813,21 @@ public:
 
     void setOmpNumThreads(int threads);
 
+    /**
+     * Selects how reductions combine partial results:
+     * 0 - default, fastest, the result may depend on the number of threads
+     * 1 - deterministic: fixed size blocks merged in a fixed pairwise tree
+     * 2 - deterministic with Neumaier compensated summation
+     *
+     * @param mode the reduction mode
+     */
+    void setReductionMode(int mode);
+
+    /**
+     * Returns the current reduction mode
+     */
+    int getReductionMode();
+
 
 
     Nd4jPointer createContext();
@@ -1069,6 +1069,1133 @@ float NativeOps::execReduceScalarHalf(
     // no-op
 }
 
+/**
+ *
+ * @param opNum
+ * @param x
+ * @param xStride
+ * @param extraParams
+ * @param result
+ * @param segmentOffsets
+ * @param numSegments
+ */
+void   NativeOps::execReduceSegmentedDouble(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        int xStride,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer segmentOffsets,
+        int numSegments) {
+    double *xPointer = reinterpret_cast<double *>(x);
+    double *extraParamsPointer = reinterpret_cast<double *>(extraParams);
+    double *resultPointer = reinterpret_cast<double *>(result);
+    Nd4jIndex *segmentOffsetsPointer = reinterpret_cast<Nd4jIndex *>(segmentOffsets);
+    NativeOpExcutioner<double>::execReduceSegmented(opNum, xPointer, xStride, segmentOffsetsPointer, numSegments, extraParamsPointer, resultPointer);
+}
+
+void   NativeOps::execReduceSegmentedFloat(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        int xStride,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer segmentOffsets,
+        int numSegments) {
+    float *xPointer = reinterpret_cast<float *>(x);
+    float *extraParamsPointer = reinterpret_cast<float *>(extraParams);
+    float *resultPointer = reinterpret_cast<float *>(result);
+    Nd4jIndex *segmentOffsetsPointer = reinterpret_cast<Nd4jIndex *>(segmentOffsets);
+    NativeOpExcutioner<float>::execReduceSegmented(opNum, xPointer, xStride, segmentOffsetsPointer, numSegments, extraParamsPointer, resultPointer);
+}
+
+void   NativeOps::execReduceSegmentedHalf(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        int xStride,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer segmentOffsets,
+        int numSegments) {
+    // no-op
+}
+
+/**
+ *
+ * @param opNum
+ * @param x
+ * @param xShapeInfo
+ * @param extraParams
+ * @param result
+ * @param resultShapeInfo
+ * @param dimension
+ * @param dimensionLength
+ * @param exclusive
+ * @param reverse
+ */
+void   NativeOps::execScanDouble(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        bool exclusive,
+        bool reverse) {
+    double *xPointer = reinterpret_cast<double *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    double *resultPointer = reinterpret_cast<double *>(result);
+    int *resultShapeInfoPointer = reinterpret_cast<int *>(resultShapeInfo);
+    double *extraParamsPointer = reinterpret_cast<double *>(extraParams);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<double>::execScan(
+            opNum,
+            xPointer,
+            xShapeInfoPointer,
+            extraParamsPointer,
+            resultPointer,
+            resultShapeInfoPointer,
+            dimensionPointer,
+            dimensionLength,
+            exclusive,
+            reverse,
+            tadShapeInfo,
+            tadOffsets);
+}
+
+void   NativeOps::execScanFloat(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        bool exclusive,
+        bool reverse) {
+    float *xPointer = reinterpret_cast<float *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    float *resultPointer = reinterpret_cast<float *>(result);
+    int *resultShapeInfoPointer = reinterpret_cast<int *>(resultShapeInfo);
+    float *extraParamsPointer = reinterpret_cast<float *>(extraParams);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<float>::execScan(
+            opNum,
+            xPointer,
+            xShapeInfoPointer,
+            extraParamsPointer,
+            resultPointer,
+            resultShapeInfoPointer,
+            dimensionPointer,
+            dimensionLength,
+            exclusive,
+            reverse,
+            tadShapeInfo,
+            tadOffsets);
+}
+
+void   NativeOps::execScanHalf(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        bool exclusive,
+        bool reverse) {
+    // no-op
+}
+
+/**
+ *
+ * @param x
+ * @param xShapeInfo
+ * @param dimension
+ * @param dimensionLength
+ * @param k
+ * @param largest
+ * @param values
+ * @param indices
+ */
+void   NativeOps::execTopKDouble(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        int k,
+        bool largest,
+        Nd4jPointer values,
+        Nd4jPointer indices) {
+    double *xPointer = reinterpret_cast<double *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    double *valuesPointer = reinterpret_cast<double *>(values);
+    double *indicesPointer = reinterpret_cast<double *>(indices);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<double>::execTopK(xPointer, xShapeInfoPointer, dimensionPointer, dimensionLength, k, largest, valuesPointer, indicesPointer, tadShapeInfo, tadOffsets);
+}
+
+void   NativeOps::execTopKFloat(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        int k,
+        bool largest,
+        Nd4jPointer values,
+        Nd4jPointer indices) {
+    float *xPointer = reinterpret_cast<float *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    float *valuesPointer = reinterpret_cast<float *>(values);
+    float *indicesPointer = reinterpret_cast<float *>(indices);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<float>::execTopK(xPointer, xShapeInfoPointer, dimensionPointer, dimensionLength, k, largest, valuesPointer, indicesPointer, tadShapeInfo, tadOffsets);
+}
+
+void   NativeOps::execTopKHalf(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        int k,
+        bool largest,
+        Nd4jPointer values,
+        Nd4jPointer indices) {
+    // no-op
+}
+
+/**
+ *
+ * @param x
+ * @param xShapeInfo
+ * @param dimension
+ * @param dimensionLength
+ * @param numBins
+ * @param min
+ * @param max
+ * @param binEdges
+ * @param result
+ */
+void   NativeOps::execHistogramDouble(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        int numBins,
+        double min,
+        double max,
+        Nd4jPointer binEdges,
+        Nd4jPointer result) {
+    double *xPointer = reinterpret_cast<double *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    double *binEdgesPointer = reinterpret_cast<double *>(binEdges);
+    double *resultPointer = reinterpret_cast<double *>(result);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<double>::execHistogram(xPointer, xShapeInfoPointer, dimensionPointer, dimensionLength, numBins, min, max, binEdgesPointer, resultPointer, tadShapeInfo, tadOffsets);
+}
+
+void   NativeOps::execHistogramFloat(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        int numBins,
+        float min,
+        float max,
+        Nd4jPointer binEdges,
+        Nd4jPointer result) {
+    float *xPointer = reinterpret_cast<float *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    float *binEdgesPointer = reinterpret_cast<float *>(binEdges);
+    float *resultPointer = reinterpret_cast<float *>(result);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<float>::execHistogram(xPointer, xShapeInfoPointer, dimensionPointer, dimensionLength, numBins, min, max, binEdgesPointer, resultPointer, tadShapeInfo, tadOffsets);
+}
+
+void   NativeOps::execHistogramHalf(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        int numBins,
+        float min,
+        float max,
+        Nd4jPointer binEdges,
+        Nd4jPointer result) {
+    // no-op
+}
+
+/**
+ *
+ * @param opNum
+ * @param x
+ * @param xShapeInfo
+ * @param mask
+ * @param maskShapeInfo
+ * @param condition
+ * @param extraParams
+ * @param result
+ * @param dimension
+ * @param dimensionLength
+ */
+void   NativeOps::execReduceMaskedDouble(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer mask,
+        Nd4jPointer maskShapeInfo,
+        Nd4jPointer condition,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer dimension,
+        int dimensionLength) {
+    double *xPointer = reinterpret_cast<double *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    double *maskPointer = reinterpret_cast<double *>(mask);
+    int *maskShapeInfoPointer = reinterpret_cast<int *>(maskShapeInfo);
+    double *conditionPointer = reinterpret_cast<double *>(condition);
+    double *extraParamsPointer = reinterpret_cast<double *>(extraParams);
+    double *resultPointer = reinterpret_cast<double *>(result);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<double>::execReduceMasked(opNum, xPointer, xShapeInfoPointer, maskPointer, maskShapeInfoPointer, conditionPointer, extraParamsPointer, resultPointer, dimensionPointer, dimensionLength, tadShapeInfo, tadOffsets);
+}
+
+void   NativeOps::execReduceMaskedFloat(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer mask,
+        Nd4jPointer maskShapeInfo,
+        Nd4jPointer condition,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer dimension,
+        int dimensionLength) {
+    float *xPointer = reinterpret_cast<float *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    float *maskPointer = reinterpret_cast<float *>(mask);
+    int *maskShapeInfoPointer = reinterpret_cast<int *>(maskShapeInfo);
+    float *conditionPointer = reinterpret_cast<float *>(condition);
+    float *extraParamsPointer = reinterpret_cast<float *>(extraParams);
+    float *resultPointer = reinterpret_cast<float *>(result);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<float>::execReduceMasked(opNum, xPointer, xShapeInfoPointer, maskPointer, maskShapeInfoPointer, conditionPointer, extraParamsPointer, resultPointer, dimensionPointer, dimensionLength, tadShapeInfo, tadOffsets);
+}
+
+void   NativeOps::execReduceMaskedHalf(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer mask,
+        Nd4jPointer maskShapeInfo,
+        Nd4jPointer condition,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer dimension,
+        int dimensionLength) {
+    // no-op
+}
+
+/**
+ *
+ * @param opNum
+ * @param x
+ * @param xShapeInfo
+ * @param mask
+ * @param maskShapeInfo
+ * @param condition
+ * @param extraParams
+ * @param result
+ * @param dimension
+ * @param dimensionLength
+ * @param biasCorrected
+ */
+void   NativeOps::execSummaryStatsMaskedDouble(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer mask,
+        Nd4jPointer maskShapeInfo,
+        Nd4jPointer condition,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        bool biasCorrected) {
+    double *xPointer = reinterpret_cast<double *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    double *maskPointer = reinterpret_cast<double *>(mask);
+    int *maskShapeInfoPointer = reinterpret_cast<int *>(maskShapeInfo);
+    double *conditionPointer = reinterpret_cast<double *>(condition);
+    double *extraParamsPointer = reinterpret_cast<double *>(extraParams);
+    double *resultPointer = reinterpret_cast<double *>(result);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<double>::execSummaryStatsMasked(opNum, xPointer, xShapeInfoPointer, maskPointer, maskShapeInfoPointer, conditionPointer, extraParamsPointer, resultPointer, dimensionPointer, dimensionLength, biasCorrected, tadShapeInfo, tadOffsets);
+}
+
+void   NativeOps::execSummaryStatsMaskedFloat(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer mask,
+        Nd4jPointer maskShapeInfo,
+        Nd4jPointer condition,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        bool biasCorrected) {
+    float *xPointer = reinterpret_cast<float *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    float *maskPointer = reinterpret_cast<float *>(mask);
+    int *maskShapeInfoPointer = reinterpret_cast<int *>(maskShapeInfo);
+    float *conditionPointer = reinterpret_cast<float *>(condition);
+    float *extraParamsPointer = reinterpret_cast<float *>(extraParams);
+    float *resultPointer = reinterpret_cast<float *>(result);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<float>::execSummaryStatsMasked(opNum, xPointer, xShapeInfoPointer, maskPointer, maskShapeInfoPointer, conditionPointer, extraParamsPointer, resultPointer, dimensionPointer, dimensionLength, biasCorrected, tadShapeInfo, tadOffsets);
+}
+
+void   NativeOps::execSummaryStatsMaskedHalf(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer mask,
+        Nd4jPointer maskShapeInfo,
+        Nd4jPointer condition,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer dimension,
+        int dimensionLength,
+        bool biasCorrected) {
+    // no-op
+}
+
+/**
+ *
+ * @param opNum
+ * @param x
+ * @param xShapeInfo
+ * @param mask
+ * @param maskShapeInfo
+ * @param condition
+ * @param extraParams
+ * @param result
+ * @param dimension
+ * @param dimensionLength
+ */
+void   NativeOps::execIndexReduceMaskedDouble(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer mask,
+        Nd4jPointer maskShapeInfo,
+        Nd4jPointer condition,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer dimension,
+        int dimensionLength) {
+    double *xPointer = reinterpret_cast<double *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    double *maskPointer = reinterpret_cast<double *>(mask);
+    int *maskShapeInfoPointer = reinterpret_cast<int *>(maskShapeInfo);
+    double *conditionPointer = reinterpret_cast<double *>(condition);
+    double *extraParamsPointer = reinterpret_cast<double *>(extraParams);
+    double *resultPointer = reinterpret_cast<double *>(result);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<double>::execIndexReduceMasked(opNum, xPointer, xShapeInfoPointer, maskPointer, maskShapeInfoPointer, conditionPointer, extraParamsPointer, resultPointer, dimensionPointer, dimensionLength, tadShapeInfo, tadOffsets);
+}
+
+void   NativeOps::execIndexReduceMaskedFloat(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer mask,
+        Nd4jPointer maskShapeInfo,
+        Nd4jPointer condition,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer dimension,
+        int dimensionLength) {
+    float *xPointer = reinterpret_cast<float *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    float *maskPointer = reinterpret_cast<float *>(mask);
+    int *maskShapeInfoPointer = reinterpret_cast<int *>(maskShapeInfo);
+    float *conditionPointer = reinterpret_cast<float *>(condition);
+    float *extraParamsPointer = reinterpret_cast<float *>(extraParams);
+    float *resultPointer = reinterpret_cast<float *>(result);
+    int *dimensionPointer = reinterpret_cast<int *>(dimension);
+    int *tadShapeInfo = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[0]) : nullptr;
+    int *tadOffsets = extraPointers != nullptr ? reinterpret_cast<int *>(extraPointers[1]) : nullptr;
+
+    NativeOpExcutioner<float>::execIndexReduceMasked(opNum, xPointer, xShapeInfoPointer, maskPointer, maskShapeInfoPointer, conditionPointer, extraParamsPointer, resultPointer, dimensionPointer, dimensionLength, tadShapeInfo, tadOffsets);
+}
+
+void   NativeOps::execIndexReduceMaskedHalf(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer mask,
+        Nd4jPointer maskShapeInfo,
+        Nd4jPointer condition,
+        Nd4jPointer extraParams,
+        Nd4jPointer result,
+        Nd4jPointer dimension,
+        int dimensionLength) {
+    // no-op
+}
+
+/**
+ *
+ * @param x
+ * @param xShapeInfo
+ * @param result
+ * @param resultShapeInfo
+ * @param numOps
+ * @param opTypes
+ * @param opNums
+ * @param scalars
+ * @param *operands
+ * @param *operandShapeInfos
+ * @param *extraParams
+ */
+void   NativeOps::execFusedDouble(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        int numOps,
+        Nd4jPointer opTypes,
+        Nd4jPointer opNums,
+        Nd4jPointer scalars,
+        Nd4jPointer *operands,
+        Nd4jPointer *operandShapeInfos,
+        Nd4jPointer *extraParams) {
+    double *xPointer = reinterpret_cast<double *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    double *resultPointer = reinterpret_cast<double *>(result);
+    int *resultShapeInfoPointer = reinterpret_cast<int *>(resultShapeInfo);
+    int *opTypesPointer = reinterpret_cast<int *>(opTypes);
+    int *opNumsPointer = reinterpret_cast<int *>(opNums);
+    double *scalarsPointer = reinterpret_cast<double *>(scalars);
+
+    functions::fusion::FusedOp<double> *program = new functions::fusion::FusedOp<double>[numOps];
+    for (int i = 0; i < numOps; i++) {
+        program[i].opType = opTypesPointer[i];
+        program[i].opNum = opNumsPointer[i];
+        program[i].scalar = scalarsPointer != nullptr ? scalarsPointer[i] : (double) 0.0;
+        program[i].y = operands != nullptr ? reinterpret_cast<double *>(operands[i]) : nullptr;
+        program[i].yShapeInfo = operandShapeInfos != nullptr ? reinterpret_cast<int *>(operandShapeInfos[i]) : nullptr;
+        program[i].extraParams = extraParams != nullptr ? reinterpret_cast<double *>(extraParams[i]) : nullptr;
+    }
+
+    NativeOpExcutioner<double>::execFused(xPointer, xShapeInfoPointer, resultPointer, resultShapeInfoPointer, program, numOps);
+    delete[] program;
+}
+
+void   NativeOps::execFusedFloat(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        int numOps,
+        Nd4jPointer opTypes,
+        Nd4jPointer opNums,
+        Nd4jPointer scalars,
+        Nd4jPointer *operands,
+        Nd4jPointer *operandShapeInfos,
+        Nd4jPointer *extraParams) {
+    float *xPointer = reinterpret_cast<float *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    float *resultPointer = reinterpret_cast<float *>(result);
+    int *resultShapeInfoPointer = reinterpret_cast<int *>(resultShapeInfo);
+    int *opTypesPointer = reinterpret_cast<int *>(opTypes);
+    int *opNumsPointer = reinterpret_cast<int *>(opNums);
+    float *scalarsPointer = reinterpret_cast<float *>(scalars);
+
+    functions::fusion::FusedOp<float> *program = new functions::fusion::FusedOp<float>[numOps];
+    for (int i = 0; i < numOps; i++) {
+        program[i].opType = opTypesPointer[i];
+        program[i].opNum = opNumsPointer[i];
+        program[i].scalar = scalarsPointer != nullptr ? scalarsPointer[i] : (float) 0.0;
+        program[i].y = operands != nullptr ? reinterpret_cast<float *>(operands[i]) : nullptr;
+        program[i].yShapeInfo = operandShapeInfos != nullptr ? reinterpret_cast<int *>(operandShapeInfos[i]) : nullptr;
+        program[i].extraParams = extraParams != nullptr ? reinterpret_cast<float *>(extraParams[i]) : nullptr;
+    }
+
+    NativeOpExcutioner<float>::execFused(xPointer, xShapeInfoPointer, resultPointer, resultShapeInfoPointer, program, numOps);
+    delete[] program;
+}
+
+void   NativeOps::execFusedHalf(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        int numOps,
+        Nd4jPointer opTypes,
+        Nd4jPointer opNums,
+        Nd4jPointer scalars,
+        Nd4jPointer *operands,
+        Nd4jPointer *operandShapeInfos,
+        Nd4jPointer *extraParams) {
+    // no-op
+}
+
+/**
+ *
+ * @param opNum
+ * @param dx
+ * @param xShapeInfo
+ * @param y
+ * @param yShapeInfo
+ * @param result
+ * @param resultShapeInfo
+ * @param extraParams
+ */
+void   NativeOps::execPairwiseTransformBroadcastDouble(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer dx,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer y,
+        Nd4jPointer yShapeInfo,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        Nd4jPointer extraParams) {
+    double *xPointer = reinterpret_cast<double *>(dx);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    double *yPointer = reinterpret_cast<double *>(y);
+    int *yShapeInfoPointer = reinterpret_cast<int *>(yShapeInfo);
+    double *resultPointer = reinterpret_cast<double *>(result);
+    int *resultShapeInfoPointer = reinterpret_cast<int *>(resultShapeInfo);
+    double *extraParamsPointer = reinterpret_cast<double *>(extraParams);
+    NativeOpExcutioner<double>::execPairwiseTransformBroadcast(opNum, xPointer, xShapeInfoPointer, yPointer, yShapeInfoPointer, resultPointer, resultShapeInfoPointer, extraParamsPointer);
+}
+
+void   NativeOps::execPairwiseTransformBroadcastFloat(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer dx,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer y,
+        Nd4jPointer yShapeInfo,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        Nd4jPointer extraParams) {
+    float *xPointer = reinterpret_cast<float *>(dx);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    float *yPointer = reinterpret_cast<float *>(y);
+    int *yShapeInfoPointer = reinterpret_cast<int *>(yShapeInfo);
+    float *resultPointer = reinterpret_cast<float *>(result);
+    int *resultShapeInfoPointer = reinterpret_cast<int *>(resultShapeInfo);
+    float *extraParamsPointer = reinterpret_cast<float *>(extraParams);
+    NativeOpExcutioner<float>::execPairwiseTransformBroadcast(opNum, xPointer, xShapeInfoPointer, yPointer, yShapeInfoPointer, resultPointer, resultShapeInfoPointer, extraParamsPointer);
+}
+
+void   NativeOps::execPairwiseTransformBroadcastHalf(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer dx,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer y,
+        Nd4jPointer yShapeInfo,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        Nd4jPointer extraParams) {
+    // no-op
+}
+
+/**
+ *
+ * @param opNum
+ * @param seed
+ * @param offset
+ * @param x
+ * @param xShapeInfo
+ * @param result
+ * @param resultShapeInfo
+ * @param extraParams
+ */
+void   NativeOps::execRandomDouble(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jIndex seed,
+        Nd4jIndex offset,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        Nd4jPointer extraParams) {
+    double *xPointer = reinterpret_cast<double *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    double *resultPointer = reinterpret_cast<double *>(result);
+    int *resultShapeInfoPointer = reinterpret_cast<int *>(resultShapeInfo);
+    double *extraParamsPointer = reinterpret_cast<double *>(extraParams);
+    NativeOpExcutioner<double>::execRandom(opNum, seed, offset, xPointer, xShapeInfoPointer, resultPointer, resultShapeInfoPointer, extraParamsPointer);
+}
+
+void   NativeOps::execRandomFloat(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jIndex seed,
+        Nd4jIndex offset,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        Nd4jPointer extraParams) {
+    float *xPointer = reinterpret_cast<float *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    float *resultPointer = reinterpret_cast<float *>(result);
+    int *resultShapeInfoPointer = reinterpret_cast<int *>(resultShapeInfo);
+    float *extraParamsPointer = reinterpret_cast<float *>(extraParams);
+    NativeOpExcutioner<float>::execRandom(opNum, seed, offset, xPointer, xShapeInfoPointer, resultPointer, resultShapeInfoPointer, extraParamsPointer);
+}
+
+void   NativeOps::execRandomHalf(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jIndex seed,
+        Nd4jIndex offset,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer result,
+        Nd4jPointer resultShapeInfo,
+        Nd4jPointer extraParams) {
+    // no-op
+}
+
+/**
+ *
+ * @param opNum
+ * @param target
+ * @param targetShapeInfo
+ * @param updates
+ * @param updatesShapeInfo
+ * @param indices
+ * @param extraParams
+ */
+void   NativeOps::execScatterDouble(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer target,
+        Nd4jPointer targetShapeInfo,
+        Nd4jPointer updates,
+        Nd4jPointer updatesShapeInfo,
+        Nd4jPointer indices,
+        Nd4jPointer extraParams) {
+    double *targetPointer = reinterpret_cast<double *>(target);
+    int *targetShapeInfoPointer = reinterpret_cast<int *>(targetShapeInfo);
+    double *updatesPointer = reinterpret_cast<double *>(updates);
+    int *updatesShapeInfoPointer = reinterpret_cast<int *>(updatesShapeInfo);
+    Nd4jIndex *indicesPointer = reinterpret_cast<Nd4jIndex *>(indices);
+    double *extraParamsPointer = reinterpret_cast<double *>(extraParams);
+    NativeOpExcutioner<double>::execScatter(opNum, targetPointer, targetShapeInfoPointer, updatesPointer, updatesShapeInfoPointer, indicesPointer, extraParamsPointer);
+}
+
+void   NativeOps::execScatterFloat(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer target,
+        Nd4jPointer targetShapeInfo,
+        Nd4jPointer updates,
+        Nd4jPointer updatesShapeInfo,
+        Nd4jPointer indices,
+        Nd4jPointer extraParams) {
+    float *targetPointer = reinterpret_cast<float *>(target);
+    int *targetShapeInfoPointer = reinterpret_cast<int *>(targetShapeInfo);
+    float *updatesPointer = reinterpret_cast<float *>(updates);
+    int *updatesShapeInfoPointer = reinterpret_cast<int *>(updatesShapeInfo);
+    Nd4jIndex *indicesPointer = reinterpret_cast<Nd4jIndex *>(indices);
+    float *extraParamsPointer = reinterpret_cast<float *>(extraParams);
+    NativeOpExcutioner<float>::execScatter(opNum, targetPointer, targetShapeInfoPointer, updatesPointer, updatesShapeInfoPointer, indicesPointer, extraParamsPointer);
+}
+
+void   NativeOps::execScatterHalf(
+        Nd4jPointer *extraPointers,
+        int opNum,
+        Nd4jPointer target,
+        Nd4jPointer targetShapeInfo,
+        Nd4jPointer updates,
+        Nd4jPointer updatesShapeInfo,
+        Nd4jPointer indices,
+        Nd4jPointer extraParams) {
+    // no-op
+}
+
+/**
+ *
+ * @param input
+ * @param inputShapeInfo
+ * @param weights
+ * @param weightsShapeInfo
+ * @param bias
+ * @param output
+ * @param outputShapeInfo
+ * @param strideH
+ * @param strideW
+ * @param padH
+ * @param padW
+ */
+void   NativeOps::execConv2dDouble(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer input,
+        Nd4jPointer inputShapeInfo,
+        Nd4jPointer weights,
+        Nd4jPointer weightsShapeInfo,
+        Nd4jPointer bias,
+        Nd4jPointer output,
+        Nd4jPointer outputShapeInfo,
+        int strideH,
+        int strideW,
+        int padH,
+        int padW) {
+    double *inputPointer = reinterpret_cast<double *>(input);
+    int *inputShapeInfoPointer = reinterpret_cast<int *>(inputShapeInfo);
+    double *weightsPointer = reinterpret_cast<double *>(weights);
+    int *weightsShapeInfoPointer = reinterpret_cast<int *>(weightsShapeInfo);
+    double *biasPointer = reinterpret_cast<double *>(bias);
+    double *outputPointer = reinterpret_cast<double *>(output);
+    int *outputShapeInfoPointer = reinterpret_cast<int *>(outputShapeInfo);
+    NativeOpExcutioner<double>::execConv2d(inputPointer, inputShapeInfoPointer, weightsPointer, weightsShapeInfoPointer, biasPointer, outputPointer, outputShapeInfoPointer, strideH, strideW, padH, padW);
+}
+
+void   NativeOps::execConv2dFloat(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer input,
+        Nd4jPointer inputShapeInfo,
+        Nd4jPointer weights,
+        Nd4jPointer weightsShapeInfo,
+        Nd4jPointer bias,
+        Nd4jPointer output,
+        Nd4jPointer outputShapeInfo,
+        int strideH,
+        int strideW,
+        int padH,
+        int padW) {
+    float *inputPointer = reinterpret_cast<float *>(input);
+    int *inputShapeInfoPointer = reinterpret_cast<int *>(inputShapeInfo);
+    float *weightsPointer = reinterpret_cast<float *>(weights);
+    int *weightsShapeInfoPointer = reinterpret_cast<int *>(weightsShapeInfo);
+    float *biasPointer = reinterpret_cast<float *>(bias);
+    float *outputPointer = reinterpret_cast<float *>(output);
+    int *outputShapeInfoPointer = reinterpret_cast<int *>(outputShapeInfo);
+    NativeOpExcutioner<float>::execConv2d(inputPointer, inputShapeInfoPointer, weightsPointer, weightsShapeInfoPointer, biasPointer, outputPointer, outputShapeInfoPointer, strideH, strideW, padH, padW);
+}
+
+void   NativeOps::execConv2dHalf(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer input,
+        Nd4jPointer inputShapeInfo,
+        Nd4jPointer weights,
+        Nd4jPointer weightsShapeInfo,
+        Nd4jPointer bias,
+        Nd4jPointer output,
+        Nd4jPointer outputShapeInfo,
+        int strideH,
+        int strideW,
+        int padH,
+        int padW) {
+    // no-op
+}
+
+/**
+ *
+ * @param input
+ * @param inputShapeInfo
+ * @param weights
+ * @param weightsShapeInfo
+ * @param epsilon
+ * @param epsilonShapeInfo
+ * @param inputGrad
+ * @param inputGradShapeInfo
+ * @param weightsGrad
+ * @param weightsGradShapeInfo
+ * @param biasGrad
+ * @param strideH
+ * @param strideW
+ * @param padH
+ * @param padW
+ */
+void   NativeOps::execConv2dBackpropDouble(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer input,
+        Nd4jPointer inputShapeInfo,
+        Nd4jPointer weights,
+        Nd4jPointer weightsShapeInfo,
+        Nd4jPointer epsilon,
+        Nd4jPointer epsilonShapeInfo,
+        Nd4jPointer inputGrad,
+        Nd4jPointer inputGradShapeInfo,
+        Nd4jPointer weightsGrad,
+        Nd4jPointer weightsGradShapeInfo,
+        Nd4jPointer biasGrad,
+        int strideH,
+        int strideW,
+        int padH,
+        int padW) {
+    double *inputPointer = reinterpret_cast<double *>(input);
+    int *inputShapeInfoPointer = reinterpret_cast<int *>(inputShapeInfo);
+    double *weightsPointer = reinterpret_cast<double *>(weights);
+    int *weightsShapeInfoPointer = reinterpret_cast<int *>(weightsShapeInfo);
+    double *epsilonPointer = reinterpret_cast<double *>(epsilon);
+    int *epsilonShapeInfoPointer = reinterpret_cast<int *>(epsilonShapeInfo);
+    double *inputGradPointer = reinterpret_cast<double *>(inputGrad);
+    int *inputGradShapeInfoPointer = reinterpret_cast<int *>(inputGradShapeInfo);
+    double *weightsGradPointer = reinterpret_cast<double *>(weightsGrad);
+    int *weightsGradShapeInfoPointer = reinterpret_cast<int *>(weightsGradShapeInfo);
+    double *biasGradPointer = reinterpret_cast<double *>(biasGrad);
+    NativeOpExcutioner<double>::execConv2dBackprop(inputPointer, inputShapeInfoPointer, weightsPointer, weightsShapeInfoPointer, epsilonPointer, epsilonShapeInfoPointer, inputGradPointer, inputGradShapeInfoPointer, weightsGradPointer, weightsGradShapeInfoPointer, biasGradPointer, strideH, strideW, padH, padW);
+}
+
+void   NativeOps::execConv2dBackpropFloat(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer input,
+        Nd4jPointer inputShapeInfo,
+        Nd4jPointer weights,
+        Nd4jPointer weightsShapeInfo,
+        Nd4jPointer epsilon,
+        Nd4jPointer epsilonShapeInfo,
+        Nd4jPointer inputGrad,
+        Nd4jPointer inputGradShapeInfo,
+        Nd4jPointer weightsGrad,
+        Nd4jPointer weightsGradShapeInfo,
+        Nd4jPointer biasGrad,
+        int strideH,
+        int strideW,
+        int padH,
+        int padW) {
+    float *inputPointer = reinterpret_cast<float *>(input);
+    int *inputShapeInfoPointer = reinterpret_cast<int *>(inputShapeInfo);
+    float *weightsPointer = reinterpret_cast<float *>(weights);
+    int *weightsShapeInfoPointer = reinterpret_cast<int *>(weightsShapeInfo);
+    float *epsilonPointer = reinterpret_cast<float *>(epsilon);
+    int *epsilonShapeInfoPointer = reinterpret_cast<int *>(epsilonShapeInfo);
+    float *inputGradPointer = reinterpret_cast<float *>(inputGrad);
+    int *inputGradShapeInfoPointer = reinterpret_cast<int *>(inputGradShapeInfo);
+    float *weightsGradPointer = reinterpret_cast<float *>(weightsGrad);
+    int *weightsGradShapeInfoPointer = reinterpret_cast<int *>(weightsGradShapeInfo);
+    float *biasGradPointer = reinterpret_cast<float *>(biasGrad);
+    NativeOpExcutioner<float>::execConv2dBackprop(inputPointer, inputShapeInfoPointer, weightsPointer, weightsShapeInfoPointer, epsilonPointer, epsilonShapeInfoPointer, inputGradPointer, inputGradShapeInfoPointer, weightsGradPointer, weightsGradShapeInfoPointer, biasGradPointer, strideH, strideW, padH, padW);
+}
+
+void   NativeOps::execConv2dBackpropHalf(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer input,
+        Nd4jPointer inputShapeInfo,
+        Nd4jPointer weights,
+        Nd4jPointer weightsShapeInfo,
+        Nd4jPointer epsilon,
+        Nd4jPointer epsilonShapeInfo,
+        Nd4jPointer inputGrad,
+        Nd4jPointer inputGradShapeInfo,
+        Nd4jPointer weightsGrad,
+        Nd4jPointer weightsGradShapeInfo,
+        Nd4jPointer biasGrad,
+        int strideH,
+        int strideW,
+        int padH,
+        int padW) {
+    // no-op
+}
+
+Nd4jPointer NativeOps::createReductionStateDouble(int opNum) {
+    return reinterpret_cast<Nd4jPointer>(new functions::reduce::ReductionState<double>(opNum));
+}
+
+void   NativeOps::accumulateReductionStateDouble(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer state,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer extraParams) {
+    functions::reduce::ReductionState<double> *statePointer = reinterpret_cast<functions::reduce::ReductionState<double> *>(state);
+    double *xPointer = reinterpret_cast<double *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    double *extraParamsPointer = reinterpret_cast<double *>(extraParams);
+    NativeOpExcutioner<double>::execAccumulateReductionState(statePointer, xPointer, xShapeInfoPointer, extraParamsPointer);
+}
+
+void   NativeOps::mergeReductionStateDouble(
+        Nd4jPointer state,
+        Nd4jPointer other,
+        Nd4jPointer extraParams) {
+    functions::reduce::ReductionState<double> *statePointer = reinterpret_cast<functions::reduce::ReductionState<double> *>(state);
+    functions::reduce::ReductionState<double> *otherPointer = reinterpret_cast<functions::reduce::ReductionState<double> *>(other);
+    double *extraParamsPointer = reinterpret_cast<double *>(extraParams);
+    NativeOpExcutioner<double>::execMergeReductionState(statePointer, otherPointer, extraParamsPointer);
+}
+
+double NativeOps::finalizeReductionStateDouble(
+        Nd4jPointer state,
+        Nd4jPointer extraParams) {
+    functions::reduce::ReductionState<double> *statePointer = reinterpret_cast<functions::reduce::ReductionState<double> *>(state);
+    double *extraParamsPointer = reinterpret_cast<double *>(extraParams);
+    return NativeOpExcutioner<double>::execFinalizeReductionState(statePointer, extraParamsPointer);
+}
+
+void   NativeOps::destroyReductionStateDouble(Nd4jPointer state) {
+    delete reinterpret_cast<functions::reduce::ReductionState<double> *>(state);
+}
+
+Nd4jPointer NativeOps::createReductionStateFloat(int opNum) {
+    return reinterpret_cast<Nd4jPointer>(new functions::reduce::ReductionState<float>(opNum));
+}
+
+void   NativeOps::accumulateReductionStateFloat(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer state,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer extraParams) {
+    functions::reduce::ReductionState<float> *statePointer = reinterpret_cast<functions::reduce::ReductionState<float> *>(state);
+    float *xPointer = reinterpret_cast<float *>(x);
+    int *xShapeInfoPointer = reinterpret_cast<int *>(xShapeInfo);
+    float *extraParamsPointer = reinterpret_cast<float *>(extraParams);
+    NativeOpExcutioner<float>::execAccumulateReductionState(statePointer, xPointer, xShapeInfoPointer, extraParamsPointer);
+}
+
+void   NativeOps::mergeReductionStateFloat(
+        Nd4jPointer state,
+        Nd4jPointer other,
+        Nd4jPointer extraParams) {
+    functions::reduce::ReductionState<float> *statePointer = reinterpret_cast<functions::reduce::ReductionState<float> *>(state);
+    functions::reduce::ReductionState<float> *otherPointer = reinterpret_cast<functions::reduce::ReductionState<float> *>(other);
+    float *extraParamsPointer = reinterpret_cast<float *>(extraParams);
+    NativeOpExcutioner<float>::execMergeReductionState(statePointer, otherPointer, extraParamsPointer);
+}
+
+float NativeOps::finalizeReductionStateFloat(
+        Nd4jPointer state,
+        Nd4jPointer extraParams) {
+    functions::reduce::ReductionState<float> *statePointer = reinterpret_cast<functions::reduce::ReductionState<float> *>(state);
+    float *extraParamsPointer = reinterpret_cast<float *>(extraParams);
+    return NativeOpExcutioner<float>::execFinalizeReductionState(statePointer, extraParamsPointer);
+}
+
+void   NativeOps::destroyReductionStateFloat(Nd4jPointer state) {
+    delete reinterpret_cast<functions::reduce::ReductionState<float> *>(state);
+}
+
+Nd4jPointer NativeOps::createReductionStateHalf(int opNum) {
+    return 0L;
+}
+
+void   NativeOps::accumulateReductionStateHalf(
+        Nd4jPointer *extraPointers,
+        Nd4jPointer state,
+        Nd4jPointer x,
+        Nd4jPointer xShapeInfo,
+        Nd4jPointer extraParams) {
+    // no-op
+}
+
+void   NativeOps::mergeReductionStateHalf(
+        Nd4jPointer state,
+        Nd4jPointer other,
+        Nd4jPointer extraParams) {
+    // no-op
+}
+
+float NativeOps::finalizeReductionStateHalf(
+        Nd4jPointer state,
+        Nd4jPointer extraParams) {
+    return 0.0f;
+}
+
+void   NativeOps::destroyReductionStateHalf(Nd4jPointer state) {
+    // no-op
+}
+
+/**
+ *
+ * @param state
+ * @param result
+ */
+void   NativeOps::finalizeSummaryStateDouble(
+        Nd4jPointer state,
+        Nd4jPointer result) {
+    functions::reduce::ReductionState<double> *statePointer = reinterpret_cast<functions::reduce::ReductionState<double> *>(state);
+    double *resultPointer = reinterpret_cast<double *>(result);
+    NativeOpExcutioner<double>::execFinalizeSummaryState(statePointer, resultPointer);
+}
+
+void   NativeOps::finalizeSummaryStateFloat(
+        Nd4jPointer state,
+        Nd4jPointer result) {
+    functions::reduce::ReductionState<float> *statePointer = reinterpret_cast<functions::reduce::ReductionState<float> *>(state);
+    float *resultPointer = reinterpret_cast<float *>(result);
+    NativeOpExcutioner<float>::execFinalizeSummaryState(statePointer, resultPointer);
+}
+
+void   NativeOps::finalizeSummaryStateHalf(
+        Nd4jPointer state,
+        Nd4jPointer result) {
+    // no-op
+}
+
 /**
  *
  * @param opNum
@@ -1576,6 +2703,25 @@ void   NativeOps::execTransformHalf(
 
 
 
+/**
+ * Copies a view, or an array of the other order, into a
+ * contiguous buffer in the given order
+ */
+template <typename T>
+void flattenPermuted(char order, T *resultPointer, T *inputPointer, int *inputShapeInfoPointer) {
+    int rank = shape::rank(inputShapeInfoPointer);
+    int *xShape = shape::shapeOf(inputShapeInfoPointer);
+    int resultStride[MAX_RANK];
+    int stride = 1;
+    for (int i = 0; i < rank; i++) {
+        int dim = order == 'f' ? i : rank - 1 - i;
+        resultStride[dim] = stride;
+        stride *= xShape[dim];
+    }
+
+    functions::permute::Permute<T>::copy(rank, xShape, inputPointer, shape::stride(inputShapeInfoPointer), resultPointer, resultStride);
+}
+
 template <typename T>
 void flattenGeneric(Nd4jPointer *extraPointers,
                     int offset,
@@ -1588,15 +2734,6 @@ void flattenGeneric(Nd4jPointer *extraPointers,
     int *resultShapeInfoBufferPointer = reinterpret_cast<int *>(resultShapeInfo);
     T *inputPointer = reinterpret_cast<T *>(input);
     int *inputShapeInfoPointer = reinterpret_cast<int *>(inputShapeInfo);
-    int numOnes = 0;
-    int *shape = shape::shapeOf(inputShapeInfoPointer);
-    int wholeRank = shape::rank(inputShapeInfoPointer);
-    for(int i = 0; i < wholeRank; i++) {
-        if(shape[i] == 1)
-            numOnes++;
-    }
-
-
 
     //start at the given offset
     resultPointer += offset;
@@ -1604,26 +2741,6 @@ void flattenGeneric(Nd4jPointer *extraPointers,
     int len = shape::length(inputShapeInfoPointer);
     int resultEleStride = shape::elementWiseStride(resultShapeInfoBufferPointer);
     int inputEleStride = shape::elementWiseStride(inputShapeInfoPointer);
-    int numTads, stride, dimension, dimensionLength;
-    int rank = shape::rank(inputShapeInfoPointer);
-    int *xStride = shape::stride(inputShapeInfoPointer);
-    int *xShape = shape::shapeOf(inputShapeInfoPointer);
-
-    dimensionLength = 1;
-    if(order == 'f') {
-        dimension = 0;
-    }
-    else {
-        dimension = rank - 1;
-    }
-    stride  = xStride[dimension];
-    // numTads is product of length of all dimensions excluding
-    // the one we do the tad on
-    numTads = 1;
-    for (int i = 0; i < rank; i++) {
-        if (i != dimension)
-            numTads *= xShape[i];
-    }
 
     if (inputOrder == order) {
         if (resultEleStride == 1 && inputEleStride == 1) {
@@ -1644,79 +2761,11 @@ void flattenGeneric(Nd4jPointer *extraPointers,
             }
         }
         else {
-            int idx = 0;
-            int rank = shape::rank(inputShapeInfoPointer);
-            int *coord = new int[rank];
-            int *xShape = shape::shapeOf(inputShapeInfoPointer);
-            int *xStride = shape::stride(inputShapeInfoPointer);
-            int len = shape::length(inputShapeInfoPointer);
-            if(order == 'f') {
-                for(int i = 0; i < len; i++) {
-                    shape::ind2sub(rank, xShape, i, coord);
-                    int offset = shape::getOffset(0,xShape,xStride,coord,rank);
-                    resultPointer[idx++] = inputPointer[offset];
-
-                }
-            }
-            else {
-                for(int i = 0; i < len; i++) {
-                    shape::ind2subC(rank, xShape, i, coord);
-                    int offset = shape::getOffset(0,xShape,xStride,coord,rank);
-                    resultPointer[idx++] = inputPointer[offset];
-
-                }
-            }
-
-            delete[] coord;
+            flattenPermuted<T>(order, resultPointer, inputPointer, inputShapeInfoPointer);
         }
     }
     else {
-        int rank = shape::rank(inputShapeInfoPointer);
-        int *xShape = shape::shapeOf(inputShapeInfoPointer);
-        int tadShape = xShape[dimension];
-        shape::TAD tad(inputShapeInfoPointer,&dimension,dimensionLength);
-        tad.createTadOnlyShapeInfo();
-#pragma omp  parallel  for
-        for(int i = 0; i < numTads; i++) {
-
-            int resultOffset;
-
-            if (order == 'f') {
-                // 1. get c ordering coordinates
-                int *cIndexCoordinates = new int[rank - 1];
-                int divisor = 1;
-                for (int dim = rank - 1; dim > 0; dim--) {
-                    cIndexCoordinates[dim - 1] = (i / divisor) % xShape[dim];
-                    divisor *= xShape[dim];
-                }
-
-
-                // 2. convert to f ordering index
-                int fIndex = 0;
-                int multiplier = 1;
-                for (int dim = 1; dim <= rank - 1; dim++) {
-                    fIndex += cIndexCoordinates[dim - 1] * multiplier;
-                    multiplier *= xShape[dim];
-                }
-
-                resultOffset = fIndex * tadShape;
-                delete[] cIndexCoordinates;
-
-            }
-            else {
-                resultOffset = i *  tadShape;
-            }
-
-            int tadOffset = tad.tadOffset(i);
-            for( int j = 0; j < tadShape; j++) {
-
-                // TAD are returned in C ordering always
-                resultPointer[resultOffset + j] = inputPointer[tadOffset + j * stride];
-
-            }
-        }
-
-
+        flattenPermuted<T>(order, resultPointer, inputPointer, inputShapeInfoPointer);
     }
 }
 
@@ -2222,6 +3271,20 @@ void NativeOps::setOmpNumThreads(int threads) {
 
 }
 
+/**
+ * Sets the reduction mode, see nd4j::reduction
+ */
+void NativeOps::setReductionMode(int mode) {
+    nd4j::reduction::setReductionMode(mode);
+}
+
+/**
+ * Returns the current reduction mode
+ */
+int NativeOps::getReductionMode() {
+    return nd4j::reduction::getReductionMode();
+}
+
 Nd4jPointer NativeOps::createContext() {
     return 0L;
 }
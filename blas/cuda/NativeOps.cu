@@ -45,6 +45,27 @@ int getDeviceId(Nd4jPointer ptrToDeviceId) {
     return (int)(Nd4jIndex)ptrToDeviceId;
 }
 
+/**
+ * SoftMax, SoftMaxDerivative and LogSoftMax read the dimensions to run
+ * along from extraParams (a count, then the dimensions). The cuda
+ * kernels only run row wise, so a count of 1 or more is rejected here
+ * rather than silently ignored.
+ */
+template <typename T>
+bool softMaxAlongDimensions(int opNum, T *extraParams, cudaStream_t *stream) {
+	if (opNum < 38 || opNum > 40 || extraParams == nullptr)
+		return false;
+
+	T count;
+	cudaMemcpyAsync(&count, extraParams, sizeof(T), cudaMemcpyDeviceToHost, *stream);
+	checkCudaErrors(cudaStreamSynchronize(*stream));
+	if ((float) count < 1.0f)
+		return false;
+
+	printf("[ERROR] SoftMax op [%i] along dimensions isn't supported on cuda, only row wise\n", opNum);
+	return true;
+}
+
 template <typename T>
 dim3 getOptimalDimensions(Nd4jIndex n,cudaFuncAttributes attributes, cudaDeviceProp properties) {
 
@@ -1614,6 +1635,9 @@ void   NativeOps::execTransformDouble(
 	int *maxShapeBuffer = (int *) maxDimension + 1;
 	double * special = (double *) maxShapeBuffer + (MAX_RANK * 2 + 4);
 
+	if (softMaxAlongDimensions<double>(opNum, extraParamsPointer, stream))
+		return;
+
 	// simple trick to get workaround over reductions into scalar
 	if (opNum >= 38 && opNum <= 41) {
 		if (shape::isVector(hostXShapeInfo) && opNum != 41) {
@@ -4049,6 +4073,9 @@ void   NativeOps::execTransformFloat(Nd4jPointer *extraPointers,int opNum,
 	if (verbose && launchDims.x == 1)
 		printf("AF20 opNum:[%i]\n", opNum);
 
+	if (softMaxAlongDimensions<float>(opNum, extraParamsPointer, stream))
+		return;
+
 	// simple trick to get workaround over reductions into scalar
 	if (opNum >= 38 && opNum <= 41) {
 		if (shape::isVector(hostXShapeInfo) && opNum != 41) {
@@ -4279,6 +4306,9 @@ void   NativeOps::execTransformHalf(Nd4jPointer *extraPointers,int opNum,
 	if (verbose && launchDims.x == 1)
 		printf("AH20 opNum:[%i]\n", opNum);
 
+	if (softMaxAlongDimensions<nd4j::float16>(opNum, extraParamsPointer, stream))
+		return;
+
 	// simple trick to get workaround over reductions into scalar
 	if (opNum >= 38 && opNum <= 41) {
 		if (shape::isVector(hostXShapeInfo) && opNum != 41) {
@@ -5344,6 +5374,242 @@ void NativeOps::setOmpNumThreads(int threads) {
 	maxThreads = threads;
 }
 
+void NativeOps::setReductionMode(int mode) {
+	// no-op
+}
+
+int NativeOps::getReductionMode() {
+	return 0;
+}
+
+void NativeOps::execReduceSegmentedDouble(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, int xStride, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer segmentOffsets, int numSegments) {
+	// no-op
+}
+
+void NativeOps::execReduceSegmentedFloat(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, int xStride, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer segmentOffsets, int numSegments) {
+	// no-op
+}
+
+void NativeOps::execReduceSegmentedHalf(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, int xStride, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer segmentOffsets, int numSegments) {
+	// no-op
+}
+
+void NativeOps::execScanDouble(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer resultShapeInfo, Nd4jPointer dimension, int dimensionLength, bool exclusive, bool reverse) {
+	// no-op
+}
+
+void NativeOps::execScanFloat(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer resultShapeInfo, Nd4jPointer dimension, int dimensionLength, bool exclusive, bool reverse) {
+	// no-op
+}
+
+void NativeOps::execScanHalf(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer resultShapeInfo, Nd4jPointer dimension, int dimensionLength, bool exclusive, bool reverse) {
+	// no-op
+}
+
+void NativeOps::execTopKDouble(Nd4jPointer *extraPointers, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer dimension, int dimensionLength, int k, bool largest, Nd4jPointer values, Nd4jPointer indices) {
+	// no-op
+}
+
+void NativeOps::execTopKFloat(Nd4jPointer *extraPointers, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer dimension, int dimensionLength, int k, bool largest, Nd4jPointer values, Nd4jPointer indices) {
+	// no-op
+}
+
+void NativeOps::execTopKHalf(Nd4jPointer *extraPointers, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer dimension, int dimensionLength, int k, bool largest, Nd4jPointer values, Nd4jPointer indices) {
+	// no-op
+}
+
+void NativeOps::execHistogramDouble(Nd4jPointer *extraPointers, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer dimension, int dimensionLength, int numBins, double min, double max, Nd4jPointer binEdges, Nd4jPointer result) {
+	// no-op
+}
+
+void NativeOps::execHistogramFloat(Nd4jPointer *extraPointers, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer dimension, int dimensionLength, int numBins, float min, float max, Nd4jPointer binEdges, Nd4jPointer result) {
+	// no-op
+}
+
+void NativeOps::execHistogramHalf(Nd4jPointer *extraPointers, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer dimension, int dimensionLength, int numBins, float min, float max, Nd4jPointer binEdges, Nd4jPointer result) {
+	// no-op
+}
+
+void NativeOps::execReduceMaskedDouble(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer mask, Nd4jPointer maskShapeInfo, Nd4jPointer condition, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer dimension, int dimensionLength) {
+	// no-op
+}
+
+void NativeOps::execReduceMaskedFloat(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer mask, Nd4jPointer maskShapeInfo, Nd4jPointer condition, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer dimension, int dimensionLength) {
+	// no-op
+}
+
+void NativeOps::execReduceMaskedHalf(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer mask, Nd4jPointer maskShapeInfo, Nd4jPointer condition, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer dimension, int dimensionLength) {
+	// no-op
+}
+
+void NativeOps::execSummaryStatsMaskedDouble(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer mask, Nd4jPointer maskShapeInfo, Nd4jPointer condition, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer dimension, int dimensionLength, bool biasCorrected) {
+	// no-op
+}
+
+void NativeOps::execSummaryStatsMaskedFloat(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer mask, Nd4jPointer maskShapeInfo, Nd4jPointer condition, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer dimension, int dimensionLength, bool biasCorrected) {
+	// no-op
+}
+
+void NativeOps::execSummaryStatsMaskedHalf(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer mask, Nd4jPointer maskShapeInfo, Nd4jPointer condition, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer dimension, int dimensionLength, bool biasCorrected) {
+	// no-op
+}
+
+void NativeOps::execIndexReduceMaskedDouble(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer mask, Nd4jPointer maskShapeInfo, Nd4jPointer condition, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer dimension, int dimensionLength) {
+	// no-op
+}
+
+void NativeOps::execIndexReduceMaskedFloat(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer mask, Nd4jPointer maskShapeInfo, Nd4jPointer condition, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer dimension, int dimensionLength) {
+	// no-op
+}
+
+void NativeOps::execIndexReduceMaskedHalf(Nd4jPointer *extraPointers, int opNum, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer mask, Nd4jPointer maskShapeInfo, Nd4jPointer condition, Nd4jPointer extraParams, Nd4jPointer result, Nd4jPointer dimension, int dimensionLength) {
+	// no-op
+}
+
+void NativeOps::execFusedDouble(Nd4jPointer *extraPointers, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer result, Nd4jPointer resultShapeInfo, int numOps, Nd4jPointer opTypes, Nd4jPointer opNums, Nd4jPointer scalars, Nd4jPointer *operands, Nd4jPointer *operandShapeInfos, Nd4jPointer *extraParams) {
+	// no-op
+}
+
+void NativeOps::execFusedFloat(Nd4jPointer *extraPointers, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer result, Nd4jPointer resultShapeInfo, int numOps, Nd4jPointer opTypes, Nd4jPointer opNums, Nd4jPointer scalars, Nd4jPointer *operands, Nd4jPointer *operandShapeInfos, Nd4jPointer *extraParams) {
+	// no-op
+}
+
+void NativeOps::execFusedHalf(Nd4jPointer *extraPointers, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer result, Nd4jPointer resultShapeInfo, int numOps, Nd4jPointer opTypes, Nd4jPointer opNums, Nd4jPointer scalars, Nd4jPointer *operands, Nd4jPointer *operandShapeInfos, Nd4jPointer *extraParams) {
+	// no-op
+}
+
+void NativeOps::execPairwiseTransformBroadcastDouble(Nd4jPointer *extraPointers, int opNum, Nd4jPointer dx, Nd4jPointer xShapeInfo, Nd4jPointer y, Nd4jPointer yShapeInfo, Nd4jPointer result, Nd4jPointer resultShapeInfo, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::execPairwiseTransformBroadcastFloat(Nd4jPointer *extraPointers, int opNum, Nd4jPointer dx, Nd4jPointer xShapeInfo, Nd4jPointer y, Nd4jPointer yShapeInfo, Nd4jPointer result, Nd4jPointer resultShapeInfo, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::execPairwiseTransformBroadcastHalf(Nd4jPointer *extraPointers, int opNum, Nd4jPointer dx, Nd4jPointer xShapeInfo, Nd4jPointer y, Nd4jPointer yShapeInfo, Nd4jPointer result, Nd4jPointer resultShapeInfo, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::execRandomDouble(Nd4jPointer *extraPointers, int opNum, Nd4jIndex seed, Nd4jIndex offset, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer result, Nd4jPointer resultShapeInfo, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::execRandomFloat(Nd4jPointer *extraPointers, int opNum, Nd4jIndex seed, Nd4jIndex offset, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer result, Nd4jPointer resultShapeInfo, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::execRandomHalf(Nd4jPointer *extraPointers, int opNum, Nd4jIndex seed, Nd4jIndex offset, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer result, Nd4jPointer resultShapeInfo, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::execScatterDouble(Nd4jPointer *extraPointers, int opNum, Nd4jPointer target, Nd4jPointer targetShapeInfo, Nd4jPointer updates, Nd4jPointer updatesShapeInfo, Nd4jPointer indices, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::execScatterFloat(Nd4jPointer *extraPointers, int opNum, Nd4jPointer target, Nd4jPointer targetShapeInfo, Nd4jPointer updates, Nd4jPointer updatesShapeInfo, Nd4jPointer indices, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::execScatterHalf(Nd4jPointer *extraPointers, int opNum, Nd4jPointer target, Nd4jPointer targetShapeInfo, Nd4jPointer updates, Nd4jPointer updatesShapeInfo, Nd4jPointer indices, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::execConv2dDouble(Nd4jPointer *extraPointers, Nd4jPointer input, Nd4jPointer inputShapeInfo, Nd4jPointer weights, Nd4jPointer weightsShapeInfo, Nd4jPointer bias, Nd4jPointer output, Nd4jPointer outputShapeInfo, int strideH, int strideW, int padH, int padW) {
+	// no-op
+}
+
+void NativeOps::execConv2dFloat(Nd4jPointer *extraPointers, Nd4jPointer input, Nd4jPointer inputShapeInfo, Nd4jPointer weights, Nd4jPointer weightsShapeInfo, Nd4jPointer bias, Nd4jPointer output, Nd4jPointer outputShapeInfo, int strideH, int strideW, int padH, int padW) {
+	// no-op
+}
+
+void NativeOps::execConv2dHalf(Nd4jPointer *extraPointers, Nd4jPointer input, Nd4jPointer inputShapeInfo, Nd4jPointer weights, Nd4jPointer weightsShapeInfo, Nd4jPointer bias, Nd4jPointer output, Nd4jPointer outputShapeInfo, int strideH, int strideW, int padH, int padW) {
+	// no-op
+}
+
+void NativeOps::execConv2dBackpropDouble(Nd4jPointer *extraPointers, Nd4jPointer input, Nd4jPointer inputShapeInfo, Nd4jPointer weights, Nd4jPointer weightsShapeInfo, Nd4jPointer epsilon, Nd4jPointer epsilonShapeInfo, Nd4jPointer inputGrad, Nd4jPointer inputGradShapeInfo, Nd4jPointer weightsGrad, Nd4jPointer weightsGradShapeInfo, Nd4jPointer biasGrad, int strideH, int strideW, int padH, int padW) {
+	// no-op
+}
+
+void NativeOps::execConv2dBackpropFloat(Nd4jPointer *extraPointers, Nd4jPointer input, Nd4jPointer inputShapeInfo, Nd4jPointer weights, Nd4jPointer weightsShapeInfo, Nd4jPointer epsilon, Nd4jPointer epsilonShapeInfo, Nd4jPointer inputGrad, Nd4jPointer inputGradShapeInfo, Nd4jPointer weightsGrad, Nd4jPointer weightsGradShapeInfo, Nd4jPointer biasGrad, int strideH, int strideW, int padH, int padW) {
+	// no-op
+}
+
+void NativeOps::execConv2dBackpropHalf(Nd4jPointer *extraPointers, Nd4jPointer input, Nd4jPointer inputShapeInfo, Nd4jPointer weights, Nd4jPointer weightsShapeInfo, Nd4jPointer epsilon, Nd4jPointer epsilonShapeInfo, Nd4jPointer inputGrad, Nd4jPointer inputGradShapeInfo, Nd4jPointer weightsGrad, Nd4jPointer weightsGradShapeInfo, Nd4jPointer biasGrad, int strideH, int strideW, int padH, int padW) {
+	// no-op
+}
+
+Nd4jPointer NativeOps::createReductionStateDouble(int opNum) {
+	return 0L;
+}
+
+void NativeOps::accumulateReductionStateDouble(Nd4jPointer *extraPointers, Nd4jPointer state, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::mergeReductionStateDouble(Nd4jPointer state, Nd4jPointer other, Nd4jPointer extraParams) {
+	// no-op
+}
+
+double NativeOps::finalizeReductionStateDouble(Nd4jPointer state, Nd4jPointer extraParams) {
+	return 0.0;
+}
+
+void NativeOps::destroyReductionStateDouble(Nd4jPointer state) {
+	// no-op
+}
+
+Nd4jPointer NativeOps::createReductionStateFloat(int opNum) {
+	return 0L;
+}
+
+void NativeOps::accumulateReductionStateFloat(Nd4jPointer *extraPointers, Nd4jPointer state, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::mergeReductionStateFloat(Nd4jPointer state, Nd4jPointer other, Nd4jPointer extraParams) {
+	// no-op
+}
+
+float NativeOps::finalizeReductionStateFloat(Nd4jPointer state, Nd4jPointer extraParams) {
+	return 0.0;
+}
+
+void NativeOps::destroyReductionStateFloat(Nd4jPointer state) {
+	// no-op
+}
+
+Nd4jPointer NativeOps::createReductionStateHalf(int opNum) {
+	return 0L;
+}
+
+void NativeOps::accumulateReductionStateHalf(Nd4jPointer *extraPointers, Nd4jPointer state, Nd4jPointer x, Nd4jPointer xShapeInfo, Nd4jPointer extraParams) {
+	// no-op
+}
+
+void NativeOps::mergeReductionStateHalf(Nd4jPointer state, Nd4jPointer other, Nd4jPointer extraParams) {
+	// no-op
+}
+
+float NativeOps::finalizeReductionStateHalf(Nd4jPointer state, Nd4jPointer extraParams) {
+	return 0.0;
+}
+
+void NativeOps::destroyReductionStateHalf(Nd4jPointer state) {
+	// no-op
+}
+
+void NativeOps::finalizeSummaryStateDouble(Nd4jPointer state, Nd4jPointer result) {
+	// no-op
+}
+
+void NativeOps::finalizeSummaryStateFloat(Nd4jPointer state, Nd4jPointer result) {
+	// no-op
+}
+
+void NativeOps::finalizeSummaryStateHalf(Nd4jPointer state, Nd4jPointer result) {
+	// no-op
+}
+
 void NativeOps::enableVerboseMode(bool reallyEnable) {
 	verbose = reallyEnable;
 }
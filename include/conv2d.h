@@ -0,0 +1,765 @@
+/*
+ * conv2d.h
+ *
+ * 2d convolution of NCHW arrays, forward and backward, without an
+ * im2col buffer: tiles of the im2col matrix are packed on the fly
+ * into panels that stay in L2 and fed to a blocked matrix multiply.
+ */
+
+#ifndef LIBND4J_CONV2D_H
+#define LIBND4J_CONV2D_H
+
+#include <dll.h>
+#include <shape.h>
+#include <omp.h>
+#include <stdio.h>
+#include <isa_dispatch.h>
+
+namespace functions {
+	namespace convolution {
+
+		/**
+		 * Sizes of one convolution: input [n, c, h, w], weights
+		 * [outC, c, kH, kW] and output [n, outC, outH, outW]
+		 */
+		struct Conv2DGeometry {
+			int n;
+			int c;
+			int h;
+			int w;
+			int outC;
+			int kH;
+			int kW;
+			int outH;
+			int outW;
+			int strideH;
+			int strideW;
+			int padH;
+			int padW;
+			// rows (c * kH * kW) and columns per example (outH * outW) of the im2col matrix
+			Nd4jIndex k;
+			Nd4jIndex p;
+		};
+
+		/**
+		 * Every output of an example is the product of the [outC, k]
+		 * weight matrix and the [k, p] im2col matrix of the example, whose
+		 * row (c, ky, kx) and column (oy, ox) is
+		 * input[c, oy * strideH - padH + ky, ox * strideW - padW + kx]
+		 * (zero outside of the input). The gradients are products with
+		 * the same matrix: weightsGrad = epsilon * im2col^T summed over
+		 * examples and inputGrad = col2im(weights^T * epsilon).
+		 *
+		 * Instead of materialising im2col (kH * kW times the input) the
+		 * products are blocked: kc x nc panels of whichever operand comes
+		 * from the input are gathered right before they are used, the
+		 * other operand is packed into strips of mr rows, and a micro
+		 * kernel keeps an mr x nr tile of the result in registers while
+		 * walking the depth of both panels. The results are written (or
+		 * scattered back for the input gradient) straight from that tile.
+		 */
+		template<typename T>
+		class Conv2D {
+		public:
+
+			/**
+			 * output = conv2d(input, weights) + bias
+			 *
+			 * @param input the input [n, c, h, w]
+			 * @param inputShapeInfo the shape information for the input
+			 * @param weights the kernels [outC, c, kH, kW]
+			 * @param weightsShapeInfo the shape information for the weights
+			 * @param bias outC contiguous values, or null
+			 * @param output the result buffer [n, outC, outH, outW]
+			 * @param outputShapeInfo the shape information for the result
+			 * @param strideH the vertical stride
+			 * @param strideW the horizontal stride
+			 * @param padH the zero padding above and below the input
+			 * @param padW the zero padding left and right of the input
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void forward(T *input,
+				int *inputShapeInfo,
+				T *weights,
+				int *weightsShapeInfo,
+				T *bias,
+				T *output,
+				int *outputShapeInfo,
+				int strideH,
+				int strideW,
+				int padH,
+				int padW) {
+				Conv2DGeometry g;
+				if (!geometry(inputShapeInfo, weightsShapeInfo, outputShapeInfo, strideH, strideW, padH, padW, g))
+					return;
+
+				if (g.n < 1 || g.outC < 1 || g.p < 1)
+					return;
+
+				int *inputStrides = shape::stride(inputShapeInfo);
+				int *weightsStrides = shape::stride(weightsShapeInfo);
+				int *outputStrides = shape::stride(outputShapeInfo);
+
+				int *tapY = new int[roundUp(g.k, nr)];
+				int *tapX = new int[roundUp(g.k, nr)];
+				Nd4jIndex *inputTaps = new Nd4jIndex[roundUp(g.k, nr)];
+				Nd4jIndex *weightTaps = new Nd4jIndex[roundUp(g.k, nr)];
+				taps(g, inputStrides, tapY, tapX, inputTaps);
+				taps(g, weightsStrides, tapY, tapX, weightTaps);
+
+				// the weights are the left operand of every product, packed once
+				Nd4jIndex *outCOffsets = rowOffsets(g.outC, weightsStrides[0]);
+				T *packedWeights = new T[roundUp(g.outC, mr) * g.k];
+				packPanel<mr>(weights, outCOffsets, g.outC, weightTaps, g.k, packedWeights);
+
+				const Nd4jIndex numPanels = (g.p + nc - 1) / nc;
+				const Nd4jIndex numTasks = g.n * numPanels;
+
+#pragma omp parallel if (numTasks > 1 && g.n * g.p * g.k * g.outC > minWork)
+				{
+					T *panel = new T[kc * nc];
+					int *windowY = new int[nc];
+					int *windowX = new int[nc];
+					Nd4jIndex *windowOffsets = new Nd4jIndex[nc];
+					Nd4jIndex *pixelOffsets = new Nd4jIndex[nc];
+
+#pragma omp for schedule(dynamic)
+					for (Nd4jIndex t = 0; t < numTasks; t++) {
+						const Nd4jIndex example = t / numPanels;
+						const Nd4jIndex p0 = (t % numPanels) * nc;
+						const Nd4jIndex cols = g.p - p0 < nc ? g.p - p0 : nc;
+
+						windows(g, p0, cols, nc, inputStrides, windowY, windowX, windowOffsets);
+						pixels(g, p0, cols, outputStrides, pixelOffsets);
+
+						for (Nd4jIndex k0 = 0; k0 < g.k; k0 += kc) {
+							const Nd4jIndex depth = g.k - k0 < kc ? g.k - k0 : kc;
+							packColumns(input + example * inputStrides[0], g, inputTaps, tapY, tapX, k0, depth, cols, windowY, windowX, windowOffsets, panel);
+
+							StoreOutput store(output + example * outputStrides[0], outputStrides[1], pixelOffsets, k0 == 0 ? bias : nullptr, k0 == 0);
+							multiplyPanels(g.outC, cols, depth, packedWeights + k0 * mr, mr * g.k, panel, store);
+						}
+					}
+
+					delete[] panel;
+					delete[] windowY;
+					delete[] windowX;
+					delete[] windowOffsets;
+					delete[] pixelOffsets;
+				}
+
+				delete[] packedWeights;
+				delete[] outCOffsets;
+				delete[] weightTaps;
+				delete[] inputTaps;
+				delete[] tapX;
+				delete[] tapY;
+			}
+
+			/**
+			 * Gradients of forward for the gradient epsilon of its output;
+			 * any of inputGrad, weightsGrad and biasGrad may be null to skip
+			 * it. The gradients are overwritten, not accumulated into.
+			 *
+			 * @param input the input of the forward pass [n, c, h, w]
+			 * @param inputShapeInfo the shape information for the input
+			 * @param weights the kernels [outC, c, kH, kW]
+			 * @param weightsShapeInfo the shape information for the weights
+			 * @param epsilon the gradient of the output [n, outC, outH, outW]
+			 * @param epsilonShapeInfo the shape information for epsilon
+			 * @param inputGrad the gradient of the input, shaped like the input
+			 * @param inputGradShapeInfo the shape information for inputGrad
+			 * @param weightsGrad the gradient of the weights, shaped like the weights
+			 * @param weightsGradShapeInfo the shape information for weightsGrad
+			 * @param biasGrad outC contiguous values for the gradient of the bias
+			 * @param strideH the vertical stride
+			 * @param strideW the horizontal stride
+			 * @param padH the zero padding above and below the input
+			 * @param padW the zero padding left and right of the input
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void backward(T *input,
+				int *inputShapeInfo,
+				T *weights,
+				int *weightsShapeInfo,
+				T *epsilon,
+				int *epsilonShapeInfo,
+				T *inputGrad,
+				int *inputGradShapeInfo,
+				T *weightsGrad,
+				int *weightsGradShapeInfo,
+				T *biasGrad,
+				int strideH,
+				int strideW,
+				int padH,
+				int padW) {
+				Conv2DGeometry g;
+				if (!geometry(inputShapeInfo, weightsShapeInfo, epsilonShapeInfo, strideH, strideW, padH, padW, g))
+					return;
+
+				if (inputGrad != nullptr && !shape::shapeEquals(inputShapeInfo, inputGradShapeInfo)) {
+					printf("Conv2D: inputGrad needs the shape of the input\n");
+					return;
+				}
+
+				if (weightsGrad != nullptr && !shape::shapeEquals(weightsShapeInfo, weightsGradShapeInfo)) {
+					printf("Conv2D: weightsGrad needs the shape of the weights\n");
+					return;
+				}
+
+				if (g.n < 1 || g.outC < 1 || g.k < 1)
+					return;
+
+				if (biasGrad != nullptr)
+					biasGradient(g, epsilon, shape::stride(epsilonShapeInfo), biasGrad);
+
+				if (weightsGrad != nullptr)
+					weightsGradient(g, input, shape::stride(inputShapeInfo), epsilon, shape::stride(epsilonShapeInfo), weightsGrad, shape::stride(weightsGradShapeInfo));
+
+				if (inputGrad != nullptr)
+					inputGradient(g, weights, shape::stride(weightsShapeInfo), epsilon, shape::stride(epsilonShapeInfo), inputGrad, shape::stride(inputGradShapeInfo));
+			}
+
+			/**
+			 * Reads the sizes of a convolution from the shapes of the input,
+			 * the weights and the output, false if they don't fit together
+			 */
+			static bool geometry(int *inputShapeInfo, int *weightsShapeInfo, int *outputShapeInfo, int strideH, int strideW, int padH, int padW, Conv2DGeometry &g) {
+				if (shape::rank(inputShapeInfo) != 4 || shape::rank(weightsShapeInfo) != 4 || shape::rank(outputShapeInfo) != 4) {
+					printf("Conv2D: input, weights and output need rank 4\n");
+					return false;
+				}
+
+				if (strideH < 1 || strideW < 1 || padH < 0 || padW < 0) {
+					printf("Conv2D: strides need to be positive and padding not negative\n");
+					return false;
+				}
+
+				int *inputShape = shape::shapeOf(inputShapeInfo);
+				int *weightsShape = shape::shapeOf(weightsShapeInfo);
+				int *outputShape = shape::shapeOf(outputShapeInfo);
+
+				g.n = inputShape[0];
+				g.c = inputShape[1];
+				g.h = inputShape[2];
+				g.w = inputShape[3];
+				g.outC = weightsShape[0];
+				g.kH = weightsShape[2];
+				g.kW = weightsShape[3];
+				g.outH = outputShape[2];
+				g.outW = outputShape[3];
+				g.strideH = strideH;
+				g.strideW = strideW;
+				g.padH = padH;
+				g.padW = padW;
+				g.k = (Nd4jIndex) g.c * g.kH * g.kW;
+				g.p = (Nd4jIndex) g.outH * g.outW;
+
+				if (weightsShape[1] != g.c || outputShape[0] != g.n || outputShape[1] != g.outC) {
+					printf("Conv2D: weights need [%d] input channels and the output [%d] examples of [%d] channels\n", g.c, g.n, g.outC);
+					return false;
+				}
+
+				const int expectedH = (g.h + 2 * padH - g.kH) / strideH + 1;
+				const int expectedW = (g.w + 2 * padW - g.kW) / strideW + 1;
+				if (g.h + 2 * padH < g.kH || g.w + 2 * padW < g.kW || g.outH != expectedH || g.outW != expectedW) {
+					printf("Conv2D: a [%d, %d] kernel over a [%d, %d] input needs a [%d, %d] output, not [%d, %d]\n", g.kH, g.kW, g.h, g.w, expectedH, expectedW, g.outH, g.outW);
+					return false;
+				}
+
+				return true;
+			}
+
+		private:
+			/**
+			 * Rows by columns of the register tile of the micro kernel
+			 */
+			static const int mr = 8;
+			static const int nr = 64 / sizeof(T);
+
+			/**
+			 * Depth and columns of the gathered panels; a kc x nc panel
+			 * stays in L2 and an mr x kc strip of the other operand in L1
+			 */
+			static const Nd4jIndex kc = 256;
+			static const Nd4jIndex nc = 128;
+
+			/**
+			 * Multiply-adds below which the convolution runs on one thread
+			 */
+			static const Nd4jIndex minWork = 1 << 18;
+
+			/**
+			 * Tasks the weights gradient aims for by splitting the examples
+			 * into groups; a constant, so the split only depends on sizes
+			 */
+			static const Nd4jIndex gradientTasks = 64;
+
+			/**
+			 * Out of bounds coordinate of the padding taps and columns
+			 */
+			static const int outside = -(1 << 30);
+
+			static inline Nd4jIndex roundUp(Nd4jIndex length, Nd4jIndex multiple) {
+				return (length + multiple - 1) / multiple * multiple;
+			}
+
+			static Nd4jIndex *rowOffsets(Nd4jIndex rows, Nd4jIndex stride) {
+				Nd4jIndex *offsets = new Nd4jIndex[rows];
+				for (Nd4jIndex r = 0; r < rows; r++)
+					offsets[r] = r * stride;
+
+				return offsets;
+			}
+
+			/**
+			 * Position (ky, kx) and offset of every row (c, ky, kx) of the
+			 * im2col matrix within an array of the given strides, rows past
+			 * the end up to a multiple of nr lie outside
+			 */
+			static void taps(const Conv2DGeometry &g, int *strides, int *tapY, int *tapX, Nd4jIndex *offsets) {
+				Nd4jIndex k = 0;
+				for (int c = 0; c < g.c; c++) {
+					for (int ky = 0; ky < g.kH; ky++) {
+						for (int kx = 0; kx < g.kW; kx++) {
+							tapY[k] = ky;
+							tapX[k] = kx;
+							offsets[k] = (Nd4jIndex) c * strides[1] + (Nd4jIndex) ky * strides[2] + (Nd4jIndex) kx * strides[3];
+							k++;
+						}
+					}
+				}
+
+				for (; k < roundUp(g.k, nr); k++) {
+					tapY[k] = outside;
+					tapX[k] = outside;
+					offsets[k] = 0;
+				}
+			}
+
+			/**
+			 * Top left corner of the input windows of count columns
+			 * (pixels) starting at p0 and its offset within an input of the
+			 * given strides, the rest up to length lies outside
+			 */
+			static void windows(const Conv2DGeometry &g, Nd4jIndex p0, Nd4jIndex count, Nd4jIndex length, int *strides, int *windowY, int *windowX, Nd4jIndex *offsets) {
+				int oy = (int) (p0 / g.outW);
+				int ox = (int) (p0 % g.outW);
+				for (Nd4jIndex i = 0; i < count; i++) {
+					windowY[i] = oy * g.strideH - g.padH;
+					windowX[i] = ox * g.strideW - g.padW;
+					offsets[i] = (Nd4jIndex) windowY[i] * strides[2] + (Nd4jIndex) windowX[i] * strides[3];
+					if (++ox == g.outW) {
+						ox = 0;
+						oy++;
+					}
+				}
+
+				for (Nd4jIndex i = count; i < length; i++) {
+					windowY[i] = outside;
+					windowX[i] = outside;
+					offsets[i] = 0;
+				}
+			}
+
+			/**
+			 * Offsets of count output pixels starting at p0 within an
+			 * array of the given strides
+			 */
+			static void pixels(const Conv2DGeometry &g, Nd4jIndex p0, Nd4jIndex count, int *strides, Nd4jIndex *offsets) {
+				int oy = (int) (p0 / g.outW);
+				int ox = (int) (p0 % g.outW);
+				for (Nd4jIndex i = 0; i < count; i++) {
+					offsets[i] = (Nd4jIndex) oy * strides[2] + (Nd4jIndex) ox * strides[3];
+					if (++ox == g.outW) {
+						ox = 0;
+						oy++;
+					}
+				}
+			}
+
+			static inline bool inside(const Conv2DGeometry &g, int y, int x) {
+				return (unsigned int) y < (unsigned int) g.h && (unsigned int) x < (unsigned int) g.w;
+			}
+
+			/**
+			 * Packs the rows x depth matrix src[rowOffsets[r] + depthOffsets[d]]
+			 * into strips of width rows, each depth x width and zero padded
+			 */
+			template<int width>
+			static void packPanel(T *src, Nd4jIndex *rowOffsets, Nd4jIndex rows, Nd4jIndex *depthOffsets, Nd4jIndex depth, T *dst) {
+				for (Nd4jIndex r0 = 0; r0 < rows; r0 += width) {
+					const int count = rows - r0 < width ? (int) (rows - r0) : width;
+					for (Nd4jIndex d = 0; d < depth; d++) {
+						T *src2 = src + depthOffsets[d];
+						for (int i = 0; i < count; i++)
+							dst[i] = src2[rowOffsets[r0 + i]];
+						for (int i = count; i < width; i++)
+							dst[i] = (T) 0.0;
+
+						dst += width;
+					}
+				}
+			}
+
+			/**
+			 * Packs rows [k0, k0 + depth) and the panel's columns of the
+			 * im2col matrix of one example into strips of nr columns
+			 */
+			static void packColumns(T *image, const Conv2DGeometry &g, Nd4jIndex *tapOffsets, int *tapY, int *tapX, Nd4jIndex k0, Nd4jIndex depth, Nd4jIndex cols,
+									int *windowY, int *windowX, Nd4jIndex *windowOffsets, T *dst) {
+				for (Nd4jIndex j0 = 0; j0 < cols; j0 += nr) {
+					for (Nd4jIndex d = 0; d < depth; d++) {
+						T *tap = image + tapOffsets[k0 + d];
+						const int ty = tapY[k0 + d];
+						const int tx = tapX[k0 + d];
+#pragma omp simd
+						for (int j = 0; j < nr; j++)
+							dst[j] = inside(g, windowY[j0 + j] + ty, windowX[j0 + j] + tx) ? tap[windowOffsets[j0 + j]] : (T) 0.0;
+
+						dst += nr;
+					}
+				}
+			}
+
+			/**
+			 * Packs the panel's depth pixels and columns [k0, k0 + cols)
+			 * of the transposed im2col matrix of one example into strips of
+			 * nr columns
+			 */
+			static void packTaps(T *image, const Conv2DGeometry &g, Nd4jIndex *tapOffsets, int *tapY, int *tapX, Nd4jIndex k0, Nd4jIndex depth, Nd4jIndex cols,
+								 int *windowY, int *windowX, Nd4jIndex *windowOffsets, T *dst) {
+				for (Nd4jIndex j0 = 0; j0 < cols; j0 += nr) {
+					const Nd4jIndex k = k0 + j0;
+					for (Nd4jIndex d = 0; d < depth; d++) {
+						T *window = image + windowOffsets[d];
+						const int wy = windowY[d];
+						const int wx = windowX[d];
+#pragma omp simd
+						for (int j = 0; j < nr; j++)
+							dst[j] = inside(g, wy + tapY[k + j], wx + tapX[k + j]) ? window[tapOffsets[k + j]] : (T) 0.0;
+
+						dst += nr;
+					}
+				}
+			}
+
+			/**
+			 * Hands every mr x nr tile of the rows x cols product of a
+			 * packed strip panel a (strips aStripStride apart) and a packed
+			 * panel b of the given depth to store
+			 */
+			template<typename Store>
+			ND4J_ISA_DISPATCH
+			static void multiplyPanels(Nd4jIndex rows, Nd4jIndex cols, Nd4jIndex depth, T *a, Nd4jIndex aStripStride, T *b, Store &store) {
+				for (Nd4jIndex j0 = 0; j0 < cols; j0 += nr) {
+					T *bStrip = b + j0 * depth;
+					for (Nd4jIndex i0 = 0; i0 < rows; i0 += mr) {
+						T *aStrip = a + (i0 / mr) * aStripStride;
+						T acc[mr][nr];
+						for (int i = 0; i < mr; i++) {
+#pragma omp simd
+							for (int j = 0; j < nr; j++)
+								acc[i][j] = (T) 0.0;
+						}
+
+						for (Nd4jIndex d = 0; d < depth; d++) {
+							for (int i = 0; i < mr; i++) {
+								const T ai = aStrip[d * mr + i];
+#pragma omp simd
+								for (int j = 0; j < nr; j++)
+									acc[i][j] += ai * bStrip[d * nr + j];
+							}
+						}
+
+						store(i0, j0, rows - i0 < mr ? (int) (rows - i0) : mr, cols - j0 < nr ? (int) (cols - j0) : nr, acc);
+					}
+				}
+			}
+
+			/**
+			 * Writes tiles of one example's output, adding the bias on the
+			 * first pass over the depth and accumulating on the others
+			 */
+			struct StoreOutput {
+				T *output;
+				Nd4jIndex channelStride;
+				Nd4jIndex *pixelOffsets;
+				T *bias;
+				bool first;
+
+				StoreOutput(T *output, Nd4jIndex channelStride, Nd4jIndex *pixelOffsets, T *bias, bool first) :
+						output(output), channelStride(channelStride), pixelOffsets(pixelOffsets), bias(bias), first(first) {}
+
+				inline void operator()(Nd4jIndex i0, Nd4jIndex j0, int rows, int cols, T acc[mr][nr]) {
+					for (int i = 0; i < rows; i++) {
+						T *channel = output + (i0 + i) * channelStride;
+						Nd4jIndex *offsets = pixelOffsets + j0;
+						if (first) {
+							const T b = bias == nullptr ? (T) 0.0 : bias[i0 + i];
+							for (int j = 0; j < cols; j++)
+								channel[offsets[j]] = acc[i][j] + b;
+						}
+						else {
+							for (int j = 0; j < cols; j++)
+								channel[offsets[j]] += acc[i][j];
+						}
+					}
+				}
+			};
+
+			/**
+			 * Accumulates tiles into a row major buffer
+			 */
+			struct StoreSum {
+				T *sum;
+				Nd4jIndex rowStride;
+
+				StoreSum(T *sum, Nd4jIndex rowStride) : sum(sum), rowStride(rowStride) {}
+
+				inline void operator()(Nd4jIndex i0, Nd4jIndex j0, int rows, int cols, T acc[mr][nr]) {
+					for (int i = 0; i < rows; i++) {
+						T *row = sum + (i0 + i) * rowStride + j0;
+						for (int j = 0; j < cols; j++)
+							row[j] += acc[i][j];
+					}
+				}
+			};
+
+			/**
+			 * Scatters tiles of the im2col shaped input gradient (rows
+			 * from k0, columns the panel's pixels) onto the input gradient
+			 * of one example
+			 */
+			struct StoreColumns {
+				T *grad;
+				const Conv2DGeometry *g;
+				Nd4jIndex *tapOffsets;
+				int *tapY;
+				int *tapX;
+				Nd4jIndex k0;
+				int *windowY;
+				int *windowX;
+				Nd4jIndex *windowOffsets;
+
+				StoreColumns(T *grad, const Conv2DGeometry *g, Nd4jIndex *tapOffsets, int *tapY, int *tapX, Nd4jIndex k0, int *windowY, int *windowX, Nd4jIndex *windowOffsets) :
+						grad(grad), g(g), tapOffsets(tapOffsets), tapY(tapY), tapX(tapX), k0(k0), windowY(windowY), windowX(windowX), windowOffsets(windowOffsets) {}
+
+				inline void operator()(Nd4jIndex i0, Nd4jIndex j0, int rows, int cols, T acc[mr][nr]) {
+					for (int i = 0; i < rows; i++) {
+						const Nd4jIndex k = k0 + i0 + i;
+						T *tap = grad + tapOffsets[k];
+						const int ty = tapY[k];
+						const int tx = tapX[k];
+						for (int j = 0; j < cols; j++) {
+							if (inside(*g, windowY[j0 + j] + ty, windowX[j0 + j] + tx))
+								tap[windowOffsets[j0 + j]] += acc[i][j];
+						}
+					}
+				}
+			};
+
+			static void biasGradient(const Conv2DGeometry &g, T *epsilon, int *epsilonStrides, T *biasGrad) {
+#pragma omp parallel for schedule(static) if (g.outC > 1 && g.n * g.p * g.outC > minWork)
+				for (int oc = 0; oc < g.outC; oc++) {
+					T sum = (T) 0.0;
+					for (int e = 0; e < g.n; e++) {
+						for (int oy = 0; oy < g.outH; oy++) {
+							T *row = epsilon + (Nd4jIndex) e * epsilonStrides[0] + (Nd4jIndex) oc * epsilonStrides[1] + (Nd4jIndex) oy * epsilonStrides[2];
+							for (int ox = 0; ox < g.outW; ox++)
+								sum += row[(Nd4jIndex) ox * epsilonStrides[3]];
+						}
+					}
+
+					biasGrad[oc] = sum;
+				}
+			}
+
+			/**
+			 * weightsGrad = sum over examples of epsilon [outC, p] times the
+			 * transposed im2col matrix [p, k]. The columns of weightsGrad
+			 * are split in blocks and, when there are fewer than
+			 * gradientTasks blocks, the examples in groups of a size that
+			 * only depends on n and the number of blocks. Every task sums
+			 * into its own buffer and the groups are added up in a fixed
+			 * order, so results don't depend on the number of threads.
+			 */
+			static void weightsGradient(const Conv2DGeometry &g, T *input, int *inputStrides, T *epsilon, int *epsilonStrides, T *weightsGrad, int *weightsGradStrides) {
+				const Nd4jIndex colBlocks = (g.k + nc - 1) / nc;
+				const bool parallel = g.n * g.p * g.k * g.outC > minWork;
+				Nd4jIndex groups = (gradientTasks + colBlocks - 1) / colBlocks;
+				if (groups > g.n)
+					groups = g.n;
+				const Nd4jIndex examplesPerGroup = (g.n + groups - 1) / groups;
+				groups = (g.n + examplesPerGroup - 1) / examplesPerGroup;
+
+				const Nd4jIndex numTasks = colBlocks * groups;
+				const Nd4jIndex sumLength = (Nd4jIndex) g.outC * nc;
+
+				int *tapY = new int[roundUp(g.k, nr)];
+				int *tapX = new int[roundUp(g.k, nr)];
+				Nd4jIndex *inputTaps = new Nd4jIndex[roundUp(g.k, nr)];
+				Nd4jIndex *gradTaps = new Nd4jIndex[roundUp(g.k, nr)];
+				taps(g, inputStrides, tapY, tapX, inputTaps);
+				taps(g, weightsGradStrides, tapY, tapX, gradTaps);
+
+				Nd4jIndex *outCOffsets = rowOffsets(g.outC, epsilonStrides[1]);
+				T *sums = new T[numTasks * sumLength];
+
+#pragma omp parallel if (numTasks > 1 && parallel)
+				{
+					T *aPanel = new T[roundUp(g.outC, mr) * kc];
+					T *bPanel = new T[kc * nc];
+					int *windowY = new int[kc];
+					int *windowX = new int[kc];
+					Nd4jIndex *windowOffsets = new Nd4jIndex[kc];
+					Nd4jIndex *pixelOffsets = new Nd4jIndex[kc];
+
+#pragma omp for schedule(dynamic)
+					for (Nd4jIndex t = 0; t < numTasks; t++) {
+						const Nd4jIndex k0 = (t % colBlocks) * nc;
+						const Nd4jIndex cols = g.k - k0 < nc ? g.k - k0 : nc;
+						const Nd4jIndex group = t / colBlocks;
+
+						T *sum = sums + t * sumLength;
+						for (Nd4jIndex i = 0; i < sumLength; i++)
+							sum[i] = (T) 0.0;
+
+						StoreSum store(sum, nc);
+						const Nd4jIndex lastExample = (group + 1) * examplesPerGroup < g.n ? (group + 1) * examplesPerGroup : g.n;
+						for (Nd4jIndex e = group * examplesPerGroup; e < lastExample; e++) {
+							for (Nd4jIndex p0 = 0; p0 < g.p; p0 += kc) {
+								const Nd4jIndex depth = g.p - p0 < kc ? g.p - p0 : kc;
+								windows(g, p0, depth, kc, inputStrides, windowY, windowX, windowOffsets);
+								pixels(g, p0, depth, epsilonStrides, pixelOffsets);
+
+								packPanel<mr>(epsilon + e * epsilonStrides[0], outCOffsets, g.outC, pixelOffsets, depth, aPanel);
+								packTaps(input + e * inputStrides[0], g, inputTaps, tapY, tapX, k0, depth, cols, windowY, windowX, windowOffsets, bPanel);
+								multiplyPanels(g.outC, cols, depth, aPanel, mr * depth, bPanel, store);
+							}
+						}
+					}
+
+					delete[] aPanel;
+					delete[] bPanel;
+					delete[] windowY;
+					delete[] windowX;
+					delete[] windowOffsets;
+					delete[] pixelOffsets;
+				}
+
+#pragma omp parallel for schedule(static) if (g.outC > 1 && parallel)
+				for (int oc = 0; oc < g.outC; oc++) {
+					T *gradRow = weightsGrad + (Nd4jIndex) oc * weightsGradStrides[0];
+					for (Nd4jIndex k = 0; k < g.k; k++) {
+						const Nd4jIndex block = k / nc;
+						T value = (T) 0.0;
+						for (Nd4jIndex group = 0; group < groups; group++)
+							value += sums[(group * colBlocks + block) * sumLength + oc * nc + k - block * nc];
+
+						gradRow[gradTaps[k]] = value;
+					}
+				}
+
+				delete[] sums;
+				delete[] outCOffsets;
+				delete[] gradTaps;
+				delete[] inputTaps;
+				delete[] tapX;
+				delete[] tapY;
+			}
+
+			/**
+			 * inputGrad = col2im(weights^T [k, outC] times epsilon [outC, p]).
+			 * Tasks are (example, group of input channels): the rows of a
+			 * channel only scatter onto that channel, so every element of
+			 * inputGrad is written by one thread without atomics.
+			 */
+			static void inputGradient(const Conv2DGeometry &g, T *weights, int *weightsStrides, T *epsilon, int *epsilonStrides, T *inputGrad, int *inputGradStrides) {
+				const bool parallel = g.n * g.p * g.k * g.outC > minWork;
+				Nd4jIndex groupsPerExample = parallel ? (4 * omp_get_max_threads() + g.n - 1) / g.n : 1;
+				if (groupsPerExample > g.c)
+					groupsPerExample = g.c;
+
+				const int channelsPerGroup = (int) ((g.c + groupsPerExample - 1) / groupsPerExample);
+				groupsPerExample = (g.c + channelsPerGroup - 1) / channelsPerGroup;
+				const Nd4jIndex numTasks = g.n * groupsPerExample;
+				const Nd4jIndex tapsPerChannel = (Nd4jIndex) g.kH * g.kW;
+
+				int *tapY = new int[roundUp(g.k, nr)];
+				int *tapX = new int[roundUp(g.k, nr)];
+				Nd4jIndex *weightTaps = new Nd4jIndex[roundUp(g.k, nr)];
+				Nd4jIndex *gradTaps = new Nd4jIndex[roundUp(g.k, nr)];
+				taps(g, weightsStrides, tapY, tapX, weightTaps);
+				taps(g, inputGradStrides, tapY, tapX, gradTaps);
+
+				Nd4jIndex *weightsOutCOffsets = rowOffsets(g.outC, weightsStrides[0]);
+				Nd4jIndex *epsilonOutCOffsets = rowOffsets(g.outC, epsilonStrides[1]);
+
+#pragma omp parallel if (numTasks > 1 && parallel)
+				{
+					T *aPanel = new T[roundUp(channelsPerGroup * tapsPerChannel, mr) * kc];
+					T *bPanel = new T[kc * nc];
+					int *windowY = new int[nc];
+					int *windowX = new int[nc];
+					Nd4jIndex *windowOffsets = new Nd4jIndex[nc];
+					Nd4jIndex *pixelOffsets = new Nd4jIndex[nc];
+
+#pragma omp for schedule(dynamic)
+					for (Nd4jIndex t = 0; t < numTasks; t++) {
+						const Nd4jIndex e = t / groupsPerExample;
+						const int c0 = (int) (t % groupsPerExample) * channelsPerGroup;
+						const int c1 = c0 + channelsPerGroup < g.c ? c0 + channelsPerGroup : g.c;
+						const Nd4jIndex k0 = c0 * tapsPerChannel;
+						const Nd4jIndex rows = (c1 - c0) * tapsPerChannel;
+
+						T *grad = inputGrad + e * inputGradStrides[0];
+						for (int c = c0; c < c1; c++) {
+							for (int y = 0; y < g.h; y++) {
+								T *row = grad + (Nd4jIndex) c * inputGradStrides[1] + (Nd4jIndex) y * inputGradStrides[2];
+								for (int x = 0; x < g.w; x++)
+									row[(Nd4jIndex) x * inputGradStrides[3]] = (T) 0.0;
+							}
+						}
+
+						for (Nd4jIndex oc0 = 0; oc0 < g.outC; oc0 += kc) {
+							const Nd4jIndex depth = g.outC - oc0 < kc ? g.outC - oc0 : kc;
+							packPanel<mr>(weights, weightTaps + k0, rows, weightsOutCOffsets + oc0, depth, aPanel);
+
+							for (Nd4jIndex p0 = 0; p0 < g.p; p0 += nc) {
+								const Nd4jIndex cols = g.p - p0 < nc ? g.p - p0 : nc;
+								windows(g, p0, cols, nc, inputGradStrides, windowY, windowX, windowOffsets);
+								pixels(g, p0, cols, epsilonStrides, pixelOffsets);
+
+								packPanel<nr>(epsilon + e * epsilonStrides[0], pixelOffsets, cols, epsilonOutCOffsets + oc0, depth, bPanel);
+
+								StoreColumns store(grad, &g, gradTaps, tapY, tapX, k0, windowY, windowX, windowOffsets);
+								multiplyPanels(rows, cols, depth, aPanel, mr * depth, bPanel, store);
+							}
+						}
+					}
+
+					delete[] aPanel;
+					delete[] bPanel;
+					delete[] windowY;
+					delete[] windowX;
+					delete[] windowOffsets;
+					delete[] pixelOffsets;
+				}
+
+				delete[] epsilonOutCOffsets;
+				delete[] weightsOutCOffsets;
+				delete[] gradTaps;
+				delete[] weightTaps;
+				delete[] tapX;
+				delete[] tapY;
+			}
+		};
+	}
+}
+
+#endif //LIBND4J_CONV2D_H
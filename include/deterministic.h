@@ -0,0 +1,265 @@
+/*
+ * deterministic.h
+ *
+ * Thread count independent reductions.
+ *
+ * In the default mode reductions split their input by the number
+ * of openmp threads, so the order in which partial results are
+ * combined (and hence the floating point result) depends on the
+ * machine the code runs on.
+ *
+ * In deterministic mode the input is cut into blocks of a fixed
+ * size, every block is reduced sequentially and the partials are
+ * merged in a fixed pairwise tree. The shape of that computation
+ * only depends on the length of the input, so results are bitwise
+ * reproducible regardless of the thread count. Optionally the sums
+ * are Neumaier compensated.
+ */
+
+#ifndef LIBND4J_DETERMINISTIC_H
+#define LIBND4J_DETERMINISTIC_H
+
+#include <omp.h>
+#include <dll.h>
+#include <pointercast.h>
+#include <templatemath.h>
+#include <ops.h>
+#include <isa_dispatch.h>
+
+#define ND4J_REDUCTION_DEFAULT 0
+#define ND4J_REDUCTION_DETERMINISTIC 1
+#define ND4J_REDUCTION_COMPENSATED 2
+
+/**
+ * Number of elements reduced sequentially per block.
+ * Changing this changes deterministic results.
+ */
+#define ND4J_DETERMINISTIC_BLOCK 4096
+
+namespace nd4j {
+    namespace reduction {
+
+        inline int &reductionModeHolder() {
+            static int mode = ND4J_REDUCTION_DEFAULT;
+            return mode;
+        }
+
+        /**
+         * Returns the current reduction mode, one of
+         * ND4J_REDUCTION_DEFAULT, ND4J_REDUCTION_DETERMINISTIC
+         * or ND4J_REDUCTION_COMPENSATED
+         */
+        inline int getReductionMode() {
+            return reductionModeHolder();
+        }
+
+        inline void setReductionMode(int mode) {
+            if (mode < ND4J_REDUCTION_DEFAULT || mode > ND4J_REDUCTION_COMPENSATED)
+                mode = ND4J_REDUCTION_DEFAULT;
+
+            reductionModeHolder() = mode;
+        }
+
+        inline bool isDeterministic() {
+            return reductionModeHolder() != ND4J_REDUCTION_DEFAULT;
+        }
+
+        inline bool isCompensated() {
+            return reductionModeHolder() == ND4J_REDUCTION_COMPENSATED;
+        }
+
+        /**
+         * Marks ops whose update() is a plain sum of op() outputs,
+         * only those are eligible for compensated summation.
+         */
+        template<typename OpType>
+        struct IsSummation {
+            static const bool value = false;
+        };
+
+        template<typename T> struct IsSummation<simdOps::Sum<T> > { static const bool value = true; };
+        template<typename T> struct IsSummation<simdOps::Mean<T> > { static const bool value = true; };
+        template<typename T> struct IsSummation<simdOps::ASum<T> > { static const bool value = true; };
+        template<typename T> struct IsSummation<simdOps::Norm1<T> > { static const bool value = true; };
+        template<typename T> struct IsSummation<simdOps::Norm2<T> > { static const bool value = true; };
+        template<typename T> struct IsSummation<simdOps::Variance<T> > { static const bool value = true; };
+        template<typename T> struct IsSummation<simdOps::StandardDeviation<T> > { static const bool value = true; };
+        template<typename T> struct IsSummation<simdOps::Dot<T> > { static const bool value = true; };
+        template<typename T> struct IsSummation<simdOps::CosineSimilarity<T> > { static const bool value = true; };
+        template<typename T> struct IsSummation<simdOps::EuclideanDistance<T> > { static const bool value = true; };
+        template<typename T> struct IsSummation<simdOps::ManhattanDistance<T> > { static const bool value = true; };
+
+        /**
+         * Neumaier's variant of Kahan summation.
+         *
+         * The error term is routed through a volatile so that
+         * -fassociative-math can't fold (a - s) + b back to zero.
+         */
+        template<typename T>
+        inline void compensatedAdd(T &sum, T &compensation, T value) {
+            volatile T t = sum + value;
+            T s = t;
+            if (nd4j::math::nd4j_abs<T>(sum) >= nd4j::math::nd4j_abs<T>(value)) {
+                volatile T d = sum - s;
+                compensation += d + value;
+            }
+            else {
+                volatile T d = value - s;
+                compensation += d + sum;
+            }
+            sum = s;
+        }
+
+#ifdef __CUDACC__
+        /**
+         * Half precision is compensated in float, float16 has no volatile accessors
+         */
+        template<>
+        inline void compensatedAdd<nd4j::float16>(nd4j::float16 &sum, nd4j::float16 &compensation, nd4j::float16 value) {
+            float s = (float) sum;
+            float c = (float) compensation;
+            compensatedAdd<float>(s, c, (float) value);
+            sum = (nd4j::float16) s;
+            compensation = (nd4j::float16) c;
+        }
+#endif
+
+        inline Nd4jIndex numBlocks(Nd4jIndex length) {
+            return length / ND4J_DETERMINISTIC_BLOCK + (length % ND4J_DETERMINISTIC_BLOCK > 0 ? 1 : 0);
+        }
+
+        /**
+         * Merges per block partials in a fixed pairwise tree:
+         * (0,1), (2,3), ... then (0,2), (4,6), ... and so on.
+         * Partials (and compensations, when given) are overwritten.
+         */
+        template<typename T, typename OpType>
+        inline T mergeTree(T *partials, T *compensations, Nd4jIndex numBlocks, T *extraParams) {
+            for (Nd4jIndex width = 1; width < numBlocks; width *= 2) {
+                for (Nd4jIndex i = 0; i + width < numBlocks; i += 2 * width) {
+                    if (compensations != nullptr) {
+                        compensations[i] += compensations[i + width];
+                        compensatedAdd<T>(partials[i], compensations[i], partials[i + width]);
+                    }
+                    else
+                        partials[i] = OpType::update(partials[i], partials[i + width], extraParams);
+                }
+            }
+
+            if (compensations != nullptr)
+                return partials[0] + compensations[0];
+
+            return partials[0];
+        }
+
+        /**
+         * Deterministic reduction of length elements of x
+         * spaced xElementWiseStride apart. Returns the value
+         * before postProcess.
+         */
+        template<typename T, typename OpType>
+        ND4J_ISA_INVARIANT
+        inline T execScalar(const T *x, int xElementWiseStride, Nd4jIndex length, T *extraParams) {
+            const bool compensated = IsSummation<OpType>::value && isCompensated();
+            const Nd4jIndex blocks = numBlocks(length);
+            if (blocks == 0)
+                return OpType::startingValue(x);
+
+            T *partials = new T[blocks];
+            T *compensations = compensated ? new T[blocks] : nullptr;
+
+#pragma omp parallel for schedule(static) if (blocks > 1)
+            for (Nd4jIndex b = 0; b < blocks; b++) {
+                Nd4jIndex start = b * ND4J_DETERMINISTIC_BLOCK;
+                Nd4jIndex end = start + ND4J_DETERMINISTIC_BLOCK < length ? start + ND4J_DETERMINISTIC_BLOCK : length;
+                T local = OpType::startingValue(x);
+
+                if (compensated) {
+                    T c = (T) 0.0;
+                    for (Nd4jIndex i = start; i < end; i++)
+                        compensatedAdd<T>(local, c, OpType::op(x[i * xElementWiseStride], extraParams));
+
+                    compensations[b] = c;
+                }
+                else {
+                    for (Nd4jIndex i = start; i < end; i++)
+                        local = OpType::update(local, OpType::op(x[i * xElementWiseStride], extraParams), extraParams);
+                }
+
+                partials[b] = local;
+            }
+
+            T ret = mergeTree<T, OpType>(partials, compensations, blocks, extraParams);
+
+            delete[] partials;
+            if (compensations != nullptr)
+                delete[] compensations;
+
+            return ret;
+        }
+
+        /**
+         * Deterministic pairwise (reduce3 style) reduction.
+         * Every block gets its own copy of the op's extra params,
+         * which are aggregated in the same tree order as the partials.
+         * Returns the value before postProcess, the aggregated extra
+         * params are written to extraParams.
+         */
+        template<typename T, typename OpType>
+        ND4J_ISA_INVARIANT
+        inline T execScalar(T *x, int xElementWiseStride, T *y, int yElementWiseStride, Nd4jIndex length, T *extraParams) {
+            const bool compensated = IsSummation<OpType>::value && isCompensated();
+            const Nd4jIndex blocks = numBlocks(length);
+            if (blocks == 0)
+                return OpType::startingValue(x);
+
+            const int extraParamsLen = OpType::extraParamsLen > 0 ? OpType::extraParamsLen : 1;
+            T *partials = new T[blocks];
+            T *compensations = compensated ? new T[blocks] : nullptr;
+            T *blockExtraParams = new T[blocks * extraParamsLen];
+
+#pragma omp parallel for schedule(static) if (blocks > 1)
+            for (Nd4jIndex b = 0; b < blocks; b++) {
+                Nd4jIndex start = b * ND4J_DETERMINISTIC_BLOCK;
+                Nd4jIndex end = start + ND4J_DETERMINISTIC_BLOCK < length ? start + ND4J_DETERMINISTIC_BLOCK : length;
+                T *localExtraParams = blockExtraParams + b * extraParamsLen;
+                for (int e = 0; e < extraParamsLen; e++)
+                    localExtraParams[e] = (T) 0.0;
+
+                T local = OpType::startingValue(x);
+
+                if (compensated) {
+                    T c = (T) 0.0;
+                    for (Nd4jIndex i = start; i < end; i++)
+                        compensatedAdd<T>(local, c, OpType::op(x[i * xElementWiseStride], y[i * yElementWiseStride], localExtraParams));
+
+                    compensations[b] = c;
+                }
+                else {
+                    for (Nd4jIndex i = start; i < end; i++)
+                        local = OpType::update(local, OpType::op(x[i * xElementWiseStride], y[i * yElementWiseStride], localExtraParams), localExtraParams);
+                }
+
+                partials[b] = local;
+            }
+
+            for (Nd4jIndex width = 1; width < blocks; width *= 2)
+                for (Nd4jIndex i = 0; i + width < blocks; i += 2 * width)
+                    OpType::aggregateExtraParams(blockExtraParams + i * extraParamsLen, blockExtraParams + (i + width) * extraParamsLen);
+
+            for (int e = 0; e < OpType::extraParamsLen; e++)
+                extraParams[e] = blockExtraParams[e];
+
+            T ret = mergeTree<T, OpType>(partials, compensations, blocks, extraParams);
+
+            delete[] partials;
+            delete[] blockExtraParams;
+            if (compensations != nullptr)
+                delete[] compensations;
+
+            return ret;
+        }
+    }
+}
+
+#endif //LIBND4J_DETERMINISTIC_H
@@ -0,0 +1,418 @@
+/*
+ * fastmath.h
+ *
+ * Vectorisable exp, log and tanh for the activation transforms.
+ *
+ * libm calls keep loops over simdOps::Exp, Tanh, Sigmoid etc. scalar
+ * (or at best on the baseline width glibc vector variants). The
+ * functions here are branch free range reduction plus polynomial
+ * (Cephes) kernels the compiler vectorises inside the omp simd loops
+ * at whatever width the ISA_DISPATCH clone targets.
+ *
+ * Maximum error in ulp against the exact result, measured over a
+ * sample of every float exponent and of the double range (built with
+ * the library's -fassociative-math -funsafe-math-optimizations):
+ *
+ *                       float   double
+ *   nd4j_fastexp         1.2     1.7
+ *   nd4j_fastlog         1.8     2.0
+ *   nd4j_fasttanh        1.4     1.3
+ *   nd4j_fastsigmoid     2.8     2.8
+ *   nd4j_fastsoftplus    3.3     3.3
+ *
+ * exp results below the smallest subnormal flush to 0, nd4j_fastelu
+ * keeps the exp(x) - 1 form of nd4j_elu so its error is absolute
+ * (about 1 ulp of 1) close to 0. NaN, infinities, 0 and negative
+ * log arguments give the libm results.
+ *
+ * Building with ND4J_ACCURATE_MATH (cmake -DACCURATE_MATH=ON) makes
+ * every function here forward to its libm based counterpart in
+ * templatemath.h, as do other types (float16, int) and cuda.
+ */
+
+#ifndef LIBND4J_FASTMATH_H
+#define LIBND4J_FASTMATH_H
+
+#include <templatemath.h>
+
+#if defined(__CUDACC__) || defined(ND4J_ACCURATE_MATH)
+#define ND4J_LIBM_MATH
+#endif
+
+namespace nd4j {
+	namespace math {
+
+		template<typename T>
+#ifdef __CUDACC__
+		__host__ __device__
+#endif
+		inline T nd4j_fastexp(T val) {
+			return nd4j_exp<T>(val);
+		}
+
+		template<typename T>
+#ifdef __CUDACC__
+		__host__ __device__
+#endif
+		inline T nd4j_fastlog(T val) {
+			return nd4j_log<T>(val);
+		}
+
+		template<typename T>
+#ifdef __CUDACC__
+		__host__ __device__
+#endif
+		inline T nd4j_fasttanh(T val) {
+			return nd4j_tanh<T>(val);
+		}
+
+		template<typename T>
+#ifdef __CUDACC__
+		__host__ __device__
+#endif
+		inline T nd4j_fastsigmoid(T val) {
+			return nd4j_sigmoid<T>(val);
+		}
+
+		template<typename T>
+#ifdef __CUDACC__
+		__host__ __device__
+#endif
+		inline T nd4j_fastsoftplus(T val) {
+			return softplus<T>(val);
+		}
+
+		template<typename T>
+#ifdef __CUDACC__
+		__host__ __device__
+#endif
+		inline T nd4j_fastelu(T val) {
+			return nd4j_elu<T>(val);
+		}
+
+#ifndef ND4J_LIBM_MATH
+		namespace detail {
+
+			union FloatBits {
+				float f;
+				int i;
+			};
+
+			union DoubleBits {
+				double d;
+				long long i;
+			};
+
+			inline float fromBits(int i) {
+				FloatBits b;
+				b.i = i;
+				return b.f;
+			}
+
+			inline int toBits(float f) {
+				FloatBits b;
+				b.f = f;
+				return b.i;
+			}
+
+			inline double fromBits(long long i) {
+				DoubleBits b;
+				b.i = i;
+				return b.d;
+			}
+
+			inline long long toBits(double d) {
+				DoubleBits b;
+				b.d = d;
+				return b.i;
+			}
+
+			/**
+			 * y 2^n for y close to 1 and n in [-150, 128] (float) or
+			 * [-1075, 1024] (double). Half of n goes into the exponent
+			 * of y and the rest is a single multiply, so subnormal and
+			 * overflowing results round correctly. Two constant factors
+			 * would be multiplied together first under -fassociative-math.
+			 */
+			inline float scale(float y, int n) {
+				int n1 = n >> 1;
+				int n2 = n - n1;
+				return fromBits(toBits(y) + (n1 << 23)) * fromBits((n2 + 127) << 23);
+			}
+
+			inline double scale(double y, int n) {
+				int n1 = n >> 1;
+				int n2 = n - n1;
+				return fromBits(toBits(y) + ((long long) n1 << 52)) * fromBits((long long) (n2 + 1023) << 52);
+			}
+
+			/**
+			 * exp(x) = 2^n * exp(r), r = x - n ln2 in [-ln2 / 2, ln2 / 2]
+			 *
+			 * n ln2 is subtracted in two parts, an exact hi product and
+			 * a lo correction. -fassociative-math would sum the two parts
+			 * first and lose the split unless c - hi has another use, so
+			 * the NaN check at the end tests it (it is NaN exactly when
+			 * x is) instead of x.
+			 */
+			inline float expApprox(float x) {
+				float c = x > 89.0f ? 89.0f : x;
+				c = c < -104.0f ? -104.0f : c;
+
+				int n = (int) (c * 1.44269504088896341f + (c < 0.0f ? -0.5f : 0.5f));
+				float fn = (float) n;
+				float hi = c - fn * 0.693359375f;
+				float r = hi - fn * -2.12194440e-4f;
+
+				float p = 1.9875691500E-4f;
+				p = p * r + 1.3981999507E-3f;
+				p = p * r + 8.3334519073E-3f;
+				p = p * r + 4.1665795894E-2f;
+				p = p * r + 1.6666665459E-1f;
+				p = p * r + 5.0000001201E-1f;
+				float y = p * r * r + r + 1.0f;
+
+				y = scale(y, n);
+				y = x > 88.72283935546875f ? fromBits(0x7f800000) : y;
+				y = x < -103.97208404541015625f ? 0.0f : y;
+				return hi != hi ? x : y;
+			}
+
+			inline double expApprox(double x) {
+				double c = x > 710.0 ? 710.0 : x;
+				c = c < -746.0 ? -746.0 : c;
+
+				int n = (int) (c * 1.4426950408889634073599 + (c < 0.0 ? -0.5 : 0.5));
+				double fn = (double) n;
+				double hi = c - fn * 6.93145751953125E-1;
+				double r = hi - fn * 1.42860682030941723212E-6;
+
+				double rr = r * r;
+				double p = 1.26177193074810590878E-4;
+				p = p * rr + 3.02994407707441961300E-2;
+				p = p * rr + 9.99999999999999999910E-1;
+				p = p * r;
+				double q = 3.00198505138664455042E-6;
+				q = q * rr + 2.52448340349684104192E-3;
+				q = q * rr + 2.27265548208155028766E-1;
+				q = q * rr + 2.00000000000000000009E0;
+				double y = 1.0 + 2.0 * (p / (q - p));
+
+				y = scale(y, n);
+				y = x > 709.782712893383996843 ? fromBits(0x7ff0000000000000LL) : y;
+				y = x < -745.13321910194110842 ? 0.0 : y;
+				return hi != hi ? x : y;
+			}
+
+			/**
+			 * log(1 + f) + e ln2 for f in [sqrt(0.5) - 1, sqrt(2) - 1]
+			 */
+			inline float logKernel(float f, float e) {
+				float z = f * f;
+				float p = 7.0376836292E-2f;
+				p = p * f - 1.1514610310E-1f;
+				p = p * f + 1.1676998740E-1f;
+				p = p * f - 1.2420140846E-1f;
+				p = p * f + 1.4249322787E-1f;
+				p = p * f - 1.6668057665E-1f;
+				p = p * f + 2.0000714765E-1f;
+				p = p * f - 2.4999993993E-1f;
+				p = p * f + 3.3333331174E-1f;
+
+				float y = f * z * p;
+				y = y + e * -2.12194440e-4f;
+				y = y - 0.5f * z;
+				return f + y + e * 0.693359375f;
+			}
+
+			inline double logKernel(double f, double e) {
+				double z = f * f;
+				double p = 1.01875663804580931796E-4;
+				p = p * f + 4.97494994976747001425E-1;
+				p = p * f + 4.70579119878881725854E0;
+				p = p * f + 1.44989225341610930846E1;
+				p = p * f + 1.79368678507819816313E1;
+				p = p * f + 7.70838733755885391666E0;
+				double q = f + 1.12873587189167450590E1;
+				q = q * f + 4.52279145837532221105E1;
+				q = q * f + 8.29875266912776603211E1;
+				q = q * f + 7.11544750618563894466E1;
+				q = q * f + 2.31251620126765340583E1;
+
+				double y = f * (z * p / q);
+				y = y + e * -2.121944400546905827679E-4;
+				y = y - 0.5 * z;
+				return f + y + e * 0.693359375;
+			}
+
+			/**
+			 * x = m 2^e with m in [0.5, 1), m < sqrt(0.5) is doubled
+			 */
+			inline float logApprox(float x) {
+				const bool subnormal = x < 1.17549435e-38f;
+				float s = subnormal ? x * 8388608.0f : x;
+				int bits = toBits(s);
+				int e = ((bits >> 23) & 0xff) - 126 - (subnormal ? 23 : 0);
+				float m = fromBits((bits & 0x007fffff) | 0x3f000000);
+
+				const bool small = m < 0.707106781186547524f;
+				float f = small ? m + m - 1.0f : m - 1.0f;
+				float y = logKernel(f, (float) (small ? e - 1 : e));
+
+				y = x == fromBits(0x7f800000) ? x : y;
+				y = x == 0.0f ? -fromBits(0x7f800000) : y;
+				y = x < 0.0f ? fromBits(0x7fc00000) : y;
+				return x != x ? x : y;
+			}
+
+			inline double logApprox(double x) {
+				const bool subnormal = x < 2.2250738585072014e-308;
+				double s = subnormal ? x * 18014398509481984.0 : x;
+				long long bits = toBits(s);
+				int e = (int) ((bits >> 52) & 0x7ff) - 1022 - (subnormal ? 54 : 0);
+				double m = fromBits((bits & 0x000fffffffffffffLL) | 0x3fe0000000000000LL);
+
+				const bool small = m < 0.707106781186547524;
+				double f = small ? m + m - 1.0 : m - 1.0;
+				double y = logKernel(f, (double) (small ? e - 1 : e));
+
+				y = x == fromBits(0x7ff0000000000000LL) ? x : y;
+				y = x == 0.0 ? -fromBits(0x7ff0000000000000LL) : y;
+				y = x < 0.0 ? fromBits(0x7ff8000000000000LL) : y;
+				return x != x ? x : y;
+			}
+
+			/**
+			 * log(1 + v) for v in [0, 1]: small v goes to the kernel
+			 * directly instead of losing its low bits to 1 + v
+			 */
+			template<typename T>
+			inline T log1pApprox(T v) {
+				const bool small = v < (T) 0.41421356237309504880;
+				T u = (T) 1.0 + v;
+				T f = small ? v : (T) 0.5 * u - (T) 1.0;
+				return logKernel(f, small ? (T) 0.0 : (T) 1.0);
+			}
+
+			/**
+			 * polynomial below 0.625, 1 - 2 / (exp(2|x|) + 1) above
+			 */
+			inline float tanhApprox(float x) {
+				float a = x < 0.0f ? -x : x;
+
+				float z = x * x;
+				float p = -5.70498872745E-3f;
+				p = p * z + 2.06390887954E-2f;
+				p = p * z - 5.37397155531E-2f;
+				p = p * z + 1.33314422036E-1f;
+				p = p * z - 3.33332819422E-1f;
+				float near = x + x * z * p;
+
+				float far = 1.0f - 2.0f / (expApprox(a + a) + 1.0f);
+				far = x < 0.0f ? -far : far;
+				return a < 0.625f ? near : far;
+			}
+
+			inline double tanhApprox(double x) {
+				double a = x < 0.0 ? -x : x;
+
+				double z = x * x;
+				double p = -9.64399179425052238628E-1;
+				p = p * z - 9.92877231001918586564E1;
+				p = p * z - 1.61468768441708447952E3;
+				double q = z + 1.12811678491632931402E2;
+				q = q * z + 2.23548839060100448583E3;
+				q = q * z + 4.84406305325125486048E3;
+				double near = x + x * z * (p / q);
+
+				double far = 1.0 - 2.0 / (expApprox(a + a) + 1.0);
+				far = x < 0.0 ? -far : far;
+				return a < 0.625 ? near : far;
+			}
+		}
+
+		template<>
+		inline float nd4j_fastexp<float>(float val) {
+			return detail::expApprox(val);
+		}
+
+		template<>
+		inline double nd4j_fastexp<double>(double val) {
+			return detail::expApprox(val);
+		}
+
+		template<>
+		inline float nd4j_fastlog<float>(float val) {
+			return detail::logApprox(val);
+		}
+
+		template<>
+		inline double nd4j_fastlog<double>(double val) {
+			return detail::logApprox(val);
+		}
+
+		template<>
+		inline float nd4j_fasttanh<float>(float val) {
+			return detail::tanhApprox(val);
+		}
+
+		template<>
+		inline double nd4j_fasttanh<double>(double val) {
+			return detail::tanhApprox(val);
+		}
+
+		/**
+		 * 1 / (1 + exp(-x)), written as exp(x) / (1 + exp(x)) for
+		 * negative x so small results don't underflow through 1 / inf
+		 */
+		template<>
+		inline float nd4j_fastsigmoid<float>(float val) {
+			float e = detail::expApprox(val < 0.0f ? val : -val);
+			float s = 1.0f / (1.0f + e);
+			return val < 0.0f ? e * s : s;
+		}
+
+		template<>
+		inline double nd4j_fastsigmoid<double>(double val) {
+			double e = detail::expApprox(val < 0.0 ? val : -val);
+			double s = 1.0 / (1.0 + e);
+			return val < 0.0 ? e * s : s;
+		}
+
+		/**
+		 * max(x, 0) + log(1 + exp(-|x|)), doesn't overflow for large x
+		 */
+		template<>
+		inline float nd4j_fastsoftplus<float>(float val) {
+			float a = val < 0.0f ? -val : val;
+			float y = (val > 0.0f ? val : 0.0f) + detail::log1pApprox(detail::expApprox(-a));
+			return val != val ? val : y;
+		}
+
+		template<>
+		inline double nd4j_fastsoftplus<double>(double val) {
+			double a = val < 0.0 ? -val : val;
+			double y = (val > 0.0 ? val : 0.0) + detail::log1pApprox(detail::expApprox(-a));
+			return val != val ? val : y;
+		}
+
+		/**
+		 * exp is evaluated for every element, a conditional call
+		 * keeps the loop from vectorising
+		 */
+		template<>
+		inline float nd4j_fastelu<float>(float val) {
+			float e = detail::expApprox(val) - 1.0f;
+			return val >= 0.0f ? val : e;
+		}
+
+		template<>
+		inline double nd4j_fastelu<double>(double val) {
+			double e = detail::expApprox(val) - 1.0;
+			return val >= 0.0 ? val : e;
+		}
+#endif
+	}
+}
+
+#endif //LIBND4J_FASTMATH_H
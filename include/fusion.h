@@ -0,0 +1,303 @@
+/*
+ * fusion.h
+ *
+ * Chains of element wise transform, scalar and pairwise ops
+ * executed as a single pass over the data.
+ */
+
+#ifndef LIBND4J_FUSION_H
+#define LIBND4J_FUSION_H
+
+#include <vector>
+#include <dll.h>
+#include <shape.h>
+#include <omp.h>
+#include <stdio.h>
+#include <pairwise_util.h>
+#include <ops.h>
+#include <op_boilerplate.h>
+#include <transform.h>
+#include <scalar.h>
+#include <pairwise_transform.h>
+
+#ifdef __JNI__
+#include <jni.h>
+#endif
+
+#define ND4J_FUSED_TRANSFORM 0
+#define ND4J_FUSED_SCALAR 1
+#define ND4J_FUSED_PAIRWISE 2
+
+/**
+ * Elements every step of a fused program is applied to at once,
+ * small enough for the tile to stay in L1 between steps.
+ */
+#define ND4J_FUSION_TILE 1024
+
+namespace functions {
+	namespace fusion {
+
+		/**
+		 * One step of a fused program
+		 */
+		template<typename T>
+		struct FusedOp {
+			// ND4J_FUSED_TRANSFORM, ND4J_FUSED_SCALAR or ND4J_FUSED_PAIRWISE
+			int opType;
+			// op number within TRANSFORM_OPS, SCALAR_OPS or PAIRWISE_TRANSFORM_OPS
+			int opNum;
+			// the scalar, scalar ops only
+			T scalar;
+			// the second operand and its shape information, pairwise ops only
+			T *y;
+			int *yShapeInfo;
+			T *extraParams;
+		};
+
+		template<typename T>
+		class Fusion {
+		public:
+
+			/**
+			 * Runs a program of element wise ops over x, writing the
+			 * final values to result (x and result may be the same buffer).
+			 *
+			 * Every step works on the output of the previous one: transforms
+			 * apply op(v), scalar ops op(v, scalar) and pairwise ops
+			 * op(v, y[i]), where y has the same shape as x. The data is
+			 * processed in tiles of ND4J_FUSION_TILE elements, every step is
+			 * applied to a tile before the next one runs, so intermediates
+			 * never go back to memory. Tiles are distributed between threads.
+			 *
+			 * x, result and the pairwise operands need the same shape. When
+			 * they all share one order and have an element wise stride, tiles
+			 * are plain strided ranges. Otherwise every operand is walked by a
+			 * StridedIterator keyed on the strides of x, so all of them visit
+			 * elements in the memory order of x and arrays of different orders
+			 * can be mixed without offset tables.
+			 *
+			 * Transforms that need the whole array (requiresSpecial) can't be
+			 * fused, programs containing one are rejected.
+			 *
+			 * @param x the input
+			 * @param xShapeInfo the shape information for the input
+			 * @param result the result buffer
+			 * @param resultShapeInfo the shape information for the result
+			 * @param program the steps to apply, in order
+			 * @param numOps the number of steps
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void exec(T *x,
+				int *xShapeInfo,
+				T *result,
+				int *resultShapeInfo,
+				FusedOp<T> *program,
+				int numOps) {
+				const Nd4jIndex length = shape::length(xShapeInfo);
+				if (length < 1)
+					return;
+
+				for (int s = 0; s < numOps; s++) {
+					if (program[s].opType == ND4J_FUSED_TRANSFORM) {
+						if (requiresSpecial(program[s].opNum)) {
+							printf("Fusion: transform [%i] needs the whole array and can't be fused\n", program[s].opNum);
+							return;
+						}
+					}
+					else if (program[s].opType == ND4J_FUSED_PAIRWISE) {
+						if (program[s].y == nullptr || !shape::shapeEquals(xShapeInfo, program[s].yShapeInfo)) {
+							printf("Fusion: pairwise step [%i] needs an operand of the same shape as x\n", s);
+							return;
+						}
+					}
+					else if (program[s].opType != ND4J_FUSED_SCALAR) {
+						printf("Fusion: unknown op type [%i]\n", program[s].opType);
+						return;
+					}
+				}
+
+				if (!shape::shapeEquals(xShapeInfo, resultShapeInfo)) {
+					printf("Fusion: the result needs the same shape as x\n");
+					return;
+				}
+
+				const char order = shape::order(xShapeInfo);
+				bool linear = shape::elementWiseStride(xShapeInfo) > 0 && shape::order(resultShapeInfo) == order && shape::elementWiseStride(resultShapeInfo) > 0;
+				for (int s = 0; s < numOps; s++) {
+					if (program[s].opType == ND4J_FUSED_PAIRWISE) {
+						int *yShapeInfo = program[s].yShapeInfo;
+						linear = linear && shape::order(yShapeInfo) == order && shape::elementWiseStride(yShapeInfo) > 0;
+					}
+				}
+
+				/*
+				 * Every operand gets its own iterator with the strides of x
+				 * as the first operand, so they all visit the same elements
+				 * in the same order, and tiles are ranges of that order.
+				 */
+				const int rank = shape::rank(xShapeInfo);
+				int *xShape = shape::shapeOf(xShapeInfo);
+				int *xStrides = shape::stride(xShapeInfo);
+				std::vector<StridedIterator> walkers;
+				int *yWalker = new int[numOps];
+				if (!linear) {
+					walkers.push_back(StridedIterator(rank, xShape, xStrides, xStrides));
+					walkers.push_back(StridedIterator(rank, xShape, xStrides, shape::stride(resultShapeInfo)));
+				}
+
+				for (int s = 0; s < numOps; s++) {
+					yWalker[s] = -1;
+					if (!linear && program[s].opType == ND4J_FUSED_PAIRWISE) {
+						yWalker[s] = (int) walkers.size();
+						walkers.push_back(StridedIterator(rank, xShape, xStrides, shape::stride(program[s].yShapeInfo)));
+					}
+				}
+
+				const Nd4jIndex numTiles = (length + ND4J_FUSION_TILE - 1) / ND4J_FUSION_TILE;
+
+#pragma omp parallel if (numTiles > 8)
+				{
+					T tile[ND4J_FUSION_TILE];
+					T operand[ND4J_FUSION_TILE];
+
+#pragma omp for schedule(static)
+					for (Nd4jIndex t = 0; t < numTiles; t++) {
+						const Nd4jIndex start = t * ND4J_FUSION_TILE;
+						const int n = (int) (start + ND4J_FUSION_TILE < length ? ND4J_FUSION_TILE : length - start);
+
+						if (linear)
+							load(x, shape::elementWiseStride(xShapeInfo), start, n, tile);
+						else
+							copyRange<true>(x, walkers[0], start, n, tile);
+
+						for (int s = 0; s < numOps; s++) {
+							FusedOp<T> &step = program[s];
+							const int opNum = step.opNum;
+							if (step.opType == ND4J_FUSED_TRANSFORM) {
+								DISPATCH_BY_OPNUM(applyTransform, PARAMS(tile, n, step.extraParams), TRANSFORM_OPS);
+							}
+							else if (step.opType == ND4J_FUSED_SCALAR) {
+								DISPATCH_BY_OPNUM(applyScalar, PARAMS(tile, n, step.scalar, step.extraParams), SCALAR_OPS);
+							}
+							else {
+								if (linear)
+									load(step.y, shape::elementWiseStride(step.yShapeInfo), start, n, operand);
+								else
+									copyRange<true>(step.y, walkers[yWalker[s]], start, n, operand);
+
+								DISPATCH_BY_OPNUM(applyPairwise, PARAMS(tile, n, operand, step.extraParams), PAIRWISE_TRANSFORM_OPS);
+							}
+						}
+
+						if (linear) {
+							const int resultStride = shape::elementWiseStride(resultShapeInfo);
+							T *out = result + start * resultStride;
+#pragma omp simd
+							for (int i = 0; i < n; i++)
+								out[i * resultStride] = tile[i];
+						}
+						else {
+							copyRange<false>(result, walkers[1], start, n, tile);
+						}
+					}
+				}
+
+				delete[] yWalker;
+			}
+
+			/**
+			 * Whether the transform needs the whole array
+			 */
+			static bool requiresSpecial(const int opNum) {
+				RETURNING_DISPATCH_BY_OPNUM(requiresSpecial, PARAMS(), TRANSFORM_OPS);
+			}
+
+			template<typename OpType>
+			static bool requiresSpecial() {
+				return OpType::requiresSpecial;
+			}
+
+			/**
+			 * Copies elements [start, start + n) of a linear operand into tile
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void load(T *x, int xStride, Nd4jIndex start, int n, T *tile) {
+				T *in = x + start * xStride;
+#pragma omp simd
+				for (int i = 0; i < n; i++)
+					tile[i] = in[i * xStride];
+			}
+
+			/**
+			 * Copies elements [start, start + n) of the visiting order of
+			 * walker between x (its second operand) and tile, into the tile
+			 * when toTile is set and out of it otherwise
+			 */
+			template<bool toTile>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void copyRange(T *x, const StridedIterator &walker, Nd4jIndex start, int n, T *tile) {
+				StridedIterator iter = walker;
+				const Nd4jIndex innerLength = iter.innerLength();
+				const int innerStride = iter.innerStride(1);
+				Nd4jIndex first = start % innerLength;
+				iter.seek(start / innerLength);
+
+				for (int done = 0; done < n; iter.next()) {
+					T *run = x + iter.offsets[1];
+					int count = (int) (innerLength - first < n - done ? innerLength - first : n - done);
+					if (toTile) {
+#pragma omp simd
+						for (int i = 0; i < count; i++)
+							tile[done + i] = run[(first + i) * innerStride];
+					}
+					else {
+#pragma omp simd
+						for (int i = 0; i < count; i++)
+							run[(first + i) * innerStride] = tile[done + i];
+					}
+
+					done += count;
+					first = 0;
+				}
+			}
+
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void applyTransform(T *tile, int n, T *extraParams) {
+#pragma omp simd
+				for (int i = 0; i < n; i++)
+					tile[i] = OpType::op(tile[i], extraParams);
+			}
+
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void applyScalar(T *tile, int n, T scalar, T *extraParams) {
+#pragma omp simd
+				for (int i = 0; i < n; i++)
+					tile[i] = OpType::op(tile[i], scalar, extraParams);
+			}
+
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void applyPairwise(T *tile, int n, T *operand, T *extraParams) {
+#pragma omp simd
+				for (int i = 0; i < n; i++)
+					tile[i] = OpType::op(tile[i], operand[i], extraParams);
+			}
+		};
+	}
+}
+
+#endif //LIBND4J_FUSION_H
@@ -0,0 +1,328 @@
+/*
+ * histogram.h
+ *
+ * Histograms over whole arrays or along dimensions.
+ */
+
+#ifndef LIBND4J_HISTOGRAM_H
+#define LIBND4J_HISTOGRAM_H
+
+#include <dll.h>
+#include <shape.h>
+#include <omp.h>
+#include <stdio.h>
+#include <algorithm>
+#include <templatemath.h>
+#include <pairwise_util.h>
+
+#ifdef __JNI__
+#include <jni.h>
+#endif
+
+namespace functions {
+	namespace histogram {
+
+		template<typename T>
+		class Histogram {
+		public:
+
+			/**
+			 * Counts the elements of every tad of x falling into each of
+			 * numBins bins, result[i * numBins + b] holds the count of bin b
+			 * for tad i.
+			 *
+			 * Bins are either numBins equal width bins over [min, max] or,
+			 * when binEdges is given, the numBins + 1 ascending edges
+			 * binEdges[b] <= v < binEdges[b + 1]. The last bin includes its
+			 * upper edge, values outside the range and NaNs are not counted.
+			 * Without edges and with min == max every tad is binned over its
+			 * own range (widened by 0.5 on both sides if it is a single value).
+			 * Without edges min above max (or a NaN bound) is rejected and
+			 * nothing is written.
+			 *
+			 * Every thread counts into private bins: one set per tad when
+			 * there are enough tads, otherwise long tads are split into
+			 * chunks whose bins are summed per tad at the end.
+			 *
+			 * @param x the input
+			 * @param xShapeInfo the shape information for the input
+			 * @param dimension the dimensions to bin along, null or MAX_DIMENSION for the whole array
+			 * @param dimensionLength the number of dimensions
+			 * @param numBins the number of bins
+			 * @param min the lower edge of the first bin
+			 * @param max the upper edge of the last bin
+			 * @param binEdges optional numBins + 1 bin edges, overrides min and max
+			 * @param result the counts, numTads * numBins
+			 * @param tadShapeInfo optional precomputed tad shape information for x
+			 * @param tadOffsets optional precomputed tad offsets for x
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void exec(T *x,
+				int *xShapeInfo,
+				int *dimension,
+				int dimensionLength,
+				int numBins,
+				T min,
+				T max,
+				T *binEdges,
+				T *result, int *tadShapeInfo, int *tadOffsets) {
+				const Nd4jIndex length = shape::length(xShapeInfo);
+				if (length < 1 || numBins < 1)
+					return;
+
+				if (binEdges == nullptr && !(min <= max)) {
+					printf("Histogram: min [%f] can't be above max [%f]\n", (double) min, (double) max);
+					return;
+				}
+
+				int *xTadShapeInfo = tadShapeInfo;
+				int *xTadOffsets = tadOffsets;
+				shape::TAD *tad = nullptr;
+				int wholeOffset = 0;
+
+				Nd4jIndex tadLength;
+				int numTads;
+
+				if (dimension == nullptr || dimension[0] == MAX_DIMENSION || dimensionLength >= shape::rank(xShapeInfo)) {
+					xTadShapeInfo = xShapeInfo;
+					xTadOffsets = &wholeOffset;
+					tadLength = length;
+					numTads = 1;
+				}
+				else {
+					tadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
+					numTads = (int) (length / tadLength);
+
+					if (xTadShapeInfo == nullptr || xTadOffsets == nullptr) {
+						tad = new shape::TAD(xShapeInfo, dimension, dimensionLength);
+						tad->createTadOnlyShapeInfo();
+						tad->createOffsets();
+
+						xTadShapeInfo = tad->tadOnlyShapeInfo;
+						xTadOffsets = tad->tadOffsets;
+					}
+				}
+
+				// bins don't care about element order, tads are walked in memory order
+				StridedIterator tadIter(shape::rank(xTadShapeInfo), shape::shapeOf(xTadShapeInfo), shape::stride(xTadShapeInfo));
+
+				const bool dataRange = binEdges == nullptr && min == max;
+
+				TadBlockInformation info(numTads, tadLength);
+
+				if (info.isSplit()) {
+					T *lows = nullptr;
+					T *highs = nullptr;
+
+					if (dataRange) {
+						lows = new T[info.numChunks()];
+						highs = new T[info.numChunks()];
+
+#pragma omp parallel for schedule(static)
+						for (Nd4jIndex chunk = 0; chunk < info.numChunks(); chunk++) {
+							int i = (int) (chunk / info.chunksPerTad);
+							int c = (int) (chunk % info.chunksPerTad);
+							rangeOf(x + xTadOffsets[i], tadIter, info.chunkStart(c), info.chunkEnd(c), lows[chunk], highs[chunk]);
+						}
+
+						// the first chunk of every tad ends up holding the tad's range
+						for (int i = 0; i < numTads; i++) {
+							Nd4jIndex first = (Nd4jIndex) i * info.chunksPerTad;
+							for (int c = 1; c < info.chunksPerTad; c++) {
+								widen(lows[first], highs[first], lows[first + c]);
+								widen(lows[first], highs[first], highs[first + c]);
+							}
+						}
+					}
+
+					Nd4jIndex *bins = new Nd4jIndex[info.numChunks() * numBins];
+
+#pragma omp parallel for schedule(static)
+					for (Nd4jIndex chunk = 0; chunk < info.numChunks(); chunk++) {
+						int i = (int) (chunk / info.chunksPerTad);
+						int c = (int) (chunk % info.chunksPerTad);
+						Nd4jIndex *chunkBins = bins + chunk * numBins;
+						for (int b = 0; b < numBins; b++)
+							chunkBins[b] = 0;
+
+						T low = min;
+						T high = max;
+						if (dataRange) {
+							low = lows[(Nd4jIndex) i * info.chunksPerTad];
+							high = highs[(Nd4jIndex) i * info.chunksPerTad];
+							padRange(low, high);
+						}
+
+						binRange(x + xTadOffsets[i], tadIter, info.chunkStart(c), info.chunkEnd(c), numBins, low, high, binEdges, chunkBins);
+					}
+
+#pragma omp parallel for schedule(static) if (numTads > 1)
+					for (int i = 0; i < numTads; i++) {
+						Nd4jIndex *tadBins = bins + (Nd4jIndex) i * info.chunksPerTad * numBins;
+						for (int b = 0; b < numBins; b++) {
+							Nd4jIndex count = 0;
+							for (int c = 0; c < info.chunksPerTad; c++)
+								count += tadBins[(Nd4jIndex) c * numBins + b];
+
+							result[(Nd4jIndex) i * numBins + b] = (T) count;
+						}
+					}
+
+					delete[] bins;
+					if (lows != nullptr)
+						delete[] lows;
+					if (highs != nullptr)
+						delete[] highs;
+				}
+				else {
+#pragma omp parallel if (numTads > 1)
+					{
+						Nd4jIndex *bins = new Nd4jIndex[numBins];
+
+#pragma omp for schedule(guided)
+						for (int i = 0; i < numTads; i++) {
+							T *tadX = x + xTadOffsets[i];
+							for (int b = 0; b < numBins; b++)
+								bins[b] = 0;
+
+							T low = min;
+							T high = max;
+							if (dataRange) {
+								rangeOf(tadX, tadIter, 0, tadLength, low, high);
+								padRange(low, high);
+							}
+
+							binRange(tadX, tadIter, 0, tadLength, numBins, low, high, binEdges, bins);
+
+							for (int b = 0; b < numBins; b++)
+								result[(Nd4jIndex) i * numBins + b] = (T) bins[b];
+						}
+
+						delete[] bins;
+					}
+				}
+
+				if (tad != nullptr)
+					delete tad;
+			}
+
+			/**
+			 * Extends [low, high] to include v, NaNs are skipped
+			 * unless the range is still NaN itself
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void widen(T &low, T &high, T v) {
+				if (v < low || low != low)
+					low = v;
+				if (v > high || high != high)
+					high = v;
+			}
+
+			/**
+			 * A single value range gets unit width around the value
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void padRange(T &low, T &high) {
+				if (low == high) {
+					low -= (T) 0.5;
+					high += (T) 0.5;
+				}
+			}
+
+			/**
+			 * Calls visitor(v) for the elements [start, end) of a tad,
+			 * counted in the memory order tadIter walks it
+			 */
+			template<typename Visitor>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void visitRange(T *x, const StridedIterator &tadIter, Nd4jIndex start, Nd4jIndex end, Visitor &visitor) {
+				StridedIterator iter = tadIter;
+				const Nd4jIndex innerLength = iter.innerLength();
+				const int innerStride = iter.innerStride(0);
+				Nd4jIndex first = start % innerLength;
+				iter.seek(start / innerLength);
+
+				for (Nd4jIndex remaining = end - start; remaining > 0; iter.next()) {
+					T *run = x + iter.offsets[0];
+					Nd4jIndex last = first + remaining < innerLength ? first + remaining : innerLength;
+					for (Nd4jIndex i = first; i < last; i++)
+						visitor(run[i * innerStride]);
+
+					remaining -= last - first;
+					first = 0;
+				}
+			}
+
+			/**
+			 * Range of elements [start, end) of a tad
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void rangeOf(T *x, const StridedIterator &tadIter, Nd4jIndex start, Nd4jIndex end, T &low, T &high) {
+				bool empty = true;
+				auto visitor = [&](T v) {
+					if (empty) {
+						low = v;
+						high = v;
+						empty = false;
+					}
+					else {
+						widen(low, high, v);
+					}
+				};
+				visitRange(x, tadIter, start, end, visitor);
+			}
+
+			/**
+			 * Bin of v, -1 if it isn't counted
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline int binOf(T v, int numBins, T low, T high, T scale, T *binEdges) {
+				if (!(v >= low && v <= high))
+					return -1;
+
+				int b;
+				if (binEdges == nullptr)
+					b = (int) ((v - low) * scale);
+				else
+					b = (int) (std::upper_bound(binEdges, binEdges + numBins + 1, v) - binEdges) - 1;
+
+				return b < numBins ? b : numBins - 1;
+			}
+
+			/**
+			 * Counts elements [start, end) of a tad into bins
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void binRange(T *x, const StridedIterator &tadIter, Nd4jIndex start, Nd4jIndex end, int numBins, T low, T high, T *binEdges, Nd4jIndex *bins) {
+				if (binEdges != nullptr) {
+					low = binEdges[0];
+					high = binEdges[numBins];
+				}
+
+				const T scale = (T) numBins / (high - low);
+				auto visitor = [&](T v) {
+					int b = binOf(v, numBins, low, high, scale, binEdges);
+					if (b >= 0)
+						bins[b]++;
+				};
+				visitRange(x, tadIter, start, end, visitor);
+			}
+		};
+	}
+}
+
+#endif //LIBND4J_HISTOGRAM_H
@@ -24,6 +24,7 @@
 #include <jni.h>
 #endif
 #include <pairwise_util.h>
+#include <mask.h>
 
 
 #define INDEX_REDUCE_OPS \
@@ -383,6 +384,19 @@ template<typename OpType>
                     DISPATCH_BY_OPNUM(exec, PARAMS(x, xShapeInfo, extraParams, result, resultShapeInfoBuffer, dimension, dimensionLength, tadShapeInfo, tadOffset), INDEX_REDUCE_OPS);
 		}
 
+		static void execMasked(const int opNum,
+			T *x,
+			int *xShapeInfo,
+			T *mask,
+			int *maskShapeInfo,
+			T *condition,
+			T *extraParams,
+			T *result,
+			int *dimension,
+			int dimensionLength, int *tadShapeInfo, int *tadOffsets) {
+                    DISPATCH_BY_OPNUM(execMasked, PARAMS(x, xShapeInfo, mask, maskShapeInfo, condition, extraParams, result, dimension, dimensionLength, tadShapeInfo, tadOffsets), INDEX_REDUCE_OPS);
+		}
+
 
 			template<typename OpType>
 #ifdef __CUDACC__
@@ -458,44 +472,35 @@ template<typename OpType>
 						}
 						else {
 							BlockInformation info(length);
-
-#pragma omp parallel
-
-							{
+							IndexValue<T> *partials = new IndexValue<T>[info.chunks];
+
+							// per chunk partials are merged in a fixed pairwise tree, update keeps
+							// the left (lower index) partial on ties, so the first extremum wins
+							// regardless of the number of threads
+#pragma omp parallel for schedule(static)
+							for (int i = 0; i < info.chunks; i++) {
+								Nd4jIndex newOffset = (Nd4jIndex) i * info.items;
+								Nd4jIndex itemsToLoop = newOffset + info.items < length ? info.items : length - newOffset;
 								IndexValue<T> local;
 								local.value = OpType::startingValue(x);
 								local.index = 0;
 
-								for (Nd4jIndex i = omp_get_thread_num(); i < info.chunks; i+= info.threads) {
-									int newOffset = (i * info.items);
-									T *chunk = x + newOffset;
-									int itemsToLoop = info.items;
-									if(newOffset >= length) {
-										break;
-									}
-
-									//handle modulo case
-									if(newOffset + info.items >= length) {
-										itemsToLoop = length - newOffset;
-									}
-
-									for (Nd4jIndex j = 0; j < itemsToLoop; j++) {
-										IndexValue<T> curr;
-										curr.value = chunk[j];
-										curr.index = j;
-										local = OpType::update(local, curr, extraParams);
-									}
-
+								for (Nd4jIndex j = newOffset; j < newOffset + itemsToLoop; j++) {
+									IndexValue<T> curr;
+									curr.value = x[j];
+									curr.index = j;
+									local = OpType::update(local, curr, extraParams);
+								}
 
-#pragma omp critical
-									{
-										startingIndex = OpType::update(startingIndex, local,
-															   extraParams);
-									}
+								partials[i] = local;
+							}
 
+							for (int width = 1; width < info.chunks; width *= 2)
+								for (int i = 0; i + width < info.chunks; i += 2 * width)
+									partials[i] = OpType::update(partials[i], partials[i + width], extraParams);
 
-								}
-							}
+							startingIndex = OpType::update(startingIndex, partials[0], extraParams);
+							delete[] partials;
 
 							return startingIndex.index;
 						}
@@ -636,26 +641,148 @@ template<typename OpType>
 					int tadElementWiseStride = shape::elementWiseStride(tadOnlyShapeInfo);
 					const int tadLength = shape::length(tadOnlyShapeInfo);
 
+					// few, long tads: split every tad between threads, merge partials in chunk order
+					TadBlockInformation info(numTads, tadLength);
+					if (info.isSplit()) {
+						IndexValue<T> *partials = new IndexValue<T>[info.numChunks()];
+
+#pragma omp parallel for schedule(static)
+						for (Nd4jIndex c = 0; c < info.numChunks(); c++) {
+							int baseOffset = tadOffsets[c / info.chunksPerTad];
+							int chunk = (int) (c % info.chunksPerTad);
+							Nd4jIndex chunkStart = info.chunkStart(chunk);
+							Nd4jIndex chunkEnd = info.chunkEnd(chunk);
+
+							IndexValue<T> indexValue;
+							indexValue.index = chunkStart;
+							indexValue.value = x[baseOffset + tadElementWiseStride * chunkStart];
+
+							for (Nd4jIndex j = chunkStart + 1; j < chunkEnd; j++) {
+								IndexValue<T> comp;
+								comp.index = j;
+								comp.value = x[baseOffset + tadElementWiseStride * j];
+								indexValue = OpType::update(indexValue, comp, extraParams);
+							}
+
+							partials[c] = indexValue;
+						}
+
+#pragma omp parallel for if (resultLength > 32)
+						for (Nd4jIndex i = 0; i < resultLength; i++) {
+							IndexValue<T> indexValue = partials[i * info.chunksPerTad];
+							for (int c = 1; c < info.chunksPerTad; c++)
+								indexValue = OpType::update(indexValue, partials[i * info.chunksPerTad + c], extraParams);
+
+							result[i] = indexValue.index;
+						}
+
+						delete[] partials;
+					}
+					else {
 #pragma omp parallel for schedule(guided) if (resultLength > 32)
-					for(Nd4jIndex i = 0;  i < resultLength; i++) {
-						int baseOffset = tadOffsets[i];
-						IndexValue<T> indexValue;
-						indexValue.index = 0;
-						indexValue.value = x[baseOffset];
+						for(Nd4jIndex i = 0;  i < resultLength; i++) {
+							int baseOffset = tadOffsets[i];
+							IndexValue<T> indexValue;
+							indexValue.index = 0;
+							indexValue.value = x[baseOffset];
 
 #pragma omp simd
-						for(int j = 1; j < tadLength; j++) {
-							IndexValue<T> comp;
-							comp.index = j;
-							comp.value = x[baseOffset + tadElementWiseStride * j];
-							indexValue = OpType::update(indexValue,comp,extraParams);
+							for(int j = 1; j < tadLength; j++) {
+								IndexValue<T> comp;
+								comp.index = j;
+								comp.value = x[baseOffset + tadElementWiseStride * j];
+								indexValue = OpType::update(indexValue,comp,extraParams);
+							}
+							result[i] = indexValue.index;
 						}
-						result[i] = indexValue.index;
 					}
 				}
 
 				delete[] startingIndex;
 			}
+
+			/**
+			 * Index reduction over the selected elements of every tad of x,
+			 * elements are selected by a mask array or a condition (see mask.h).
+			 * result[i] is the position within tad i (in c order) of the
+			 * element picked among the selected ones, or -1 if nothing
+			 * in the tad was selected.
+			 *
+			 * @param x the input
+			 * @param xShapeInfo the shape information for the input
+			 * @param mask optional mask of the same shape as x, non zero entries are considered
+			 * @param maskShapeInfo the shape information for the mask
+			 * @param condition {compare, eps, mode} as for MatchCondition, used without a mask
+			 * @param extraParams the extra params for the op
+			 * @param result the result buffer, one index per tad
+			 * @param dimension the dimensions to reduce along, null or MAX_DIMENSION for the whole array
+			 * @param dimensionLength the number of dimensions
+			 * @param tadShapeInfo optional precomputed tad shape information for x
+			 * @param tadOffsets optional precomputed tad offsets for x
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void execMasked(T *x,
+					  int *xShapeInfo,
+					  T *mask,
+					  int *maskShapeInfo,
+					  T *condition,
+					  T *extraParams,
+					  T *result,
+					  int *dimension,
+					  int dimensionLength, int *tadShapeInfo, int *tadOffsets) {
+				if (shape::length(xShapeInfo) < 1)
+					return;
+				if (mask != nullptr && !nd4j::mask::MaskedTads<T>::fits(xShapeInfo, maskShapeInfo))
+					return;
+
+				nd4j::mask::MaskedTads<T> tads(xShapeInfo, mask != nullptr ? maskShapeInfo : nullptr, dimension, dimensionLength, tadShapeInfo, tadOffsets, true);
+
+				TadBlockInformation info(tads.numTads, tads.tadLength);
+				IndexValue<T> *partials = new IndexValue<T>[info.numChunks()];
+				bool *found = new bool[info.numChunks()];
+
+#pragma omp parallel for schedule(guided) if (info.numChunks() > 1)
+				for (Nd4jIndex c = 0; c < info.numChunks(); c++) {
+					int i = (int) (c / info.chunksPerTad);
+					int chunk = (int) (c % info.chunksPerTad);
+					IndexValue<T> indexValue;
+					bool any = false;
+					auto visitor = [&](T value, Nd4jIndex j) {
+						IndexValue<T> comp;
+						comp.index = (unsigned int) j;
+						comp.value = value;
+						indexValue = any ? OpType::update(indexValue, comp, extraParams) : comp;
+						any = true;
+					};
+					nd4j::mask::forEachSelected(tads, x, mask, condition, i, info.chunkStart(chunk), info.chunkEnd(chunk), visitor);
+
+					partials[c] = indexValue;
+					found[c] = any;
+				}
+
+				// chunks are merged in order, so ties go to the lower index as in exec
+#pragma omp parallel for schedule(static) if (tads.numTads > 32)
+				for (int i = 0; i < tads.numTads; i++) {
+					IndexValue<T> indexValue;
+					bool any = false;
+					for (int c = 0; c < info.chunksPerTad; c++) {
+						Nd4jIndex chunk = (Nd4jIndex) i * info.chunksPerTad + c;
+						if (!found[chunk])
+							continue;
+
+						indexValue = any ? OpType::update(indexValue, partials[chunk], extraParams) : partials[chunk];
+						any = true;
+					}
+
+					result[i] = any ? (T) indexValue.index : (T) -1.0;
+				}
+
+				delete[] partials;
+				delete[] found;
+			}
 		};
 	}
 
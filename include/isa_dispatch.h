@@ -0,0 +1,36 @@
+/*
+ * isa_dispatch.h
+ *
+ * Runtime ISA dispatch for the hot cpu loops.
+ *
+ * Functions marked with ND4J_ISA_DISPATCH are compiled once per
+ * instruction set (AVX-512, AVX2 and the baseline the library is
+ * built for) into the same shared library. The best variant is
+ * picked once per function at load time via CPUID (gcc target_clones,
+ * resolved through an ifunc), so distribution builds get the full
+ * vector width without -march=native.
+ *
+ * Dispatch is disabled for the cuda compiler, for toolchains without
+ * target_clones support on templates, for builds whose baseline is
+ * already AVX-512, and when ND4J_NO_ISA_DISPATCH is defined, which
+ * the cmake build does for NATIVE builds (-march=native).
+ *
+ * Kernels whose rounding has to be the same on every machine (the
+ * deterministic reductions) are marked ND4J_ISA_INVARIANT instead:
+ * they are never inlined into a dispatched caller, so they are always
+ * compiled for the baseline.
+ */
+
+#ifndef LIBND4J_ISA_DISPATCH_H
+#define LIBND4J_ISA_DISPATCH_H
+
+#if !defined(ND4J_NO_ISA_DISPATCH) && !defined(__CUDACC__) && !defined(__clang__) && !defined(__INTEL_COMPILER) && \
+    !defined(__AVX512F__) && defined(__GNUC__) && __GNUC__ >= 12 && defined(__x86_64__) && defined(__linux__)
+#define ND4J_ISA_DISPATCH __attribute__((target_clones("avx512f", "avx2", "default")))
+#define ND4J_ISA_INVARIANT __attribute__((noinline))
+#else
+#define ND4J_ISA_DISPATCH
+#define ND4J_ISA_INVARIANT
+#endif
+
+#endif //LIBND4J_ISA_DISPATCH_H
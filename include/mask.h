@@ -0,0 +1,200 @@
+/*
+ * mask.h
+ *
+ * Element selection for masked reductions.
+ *
+ * A masked reduction only visits some of the elements of x, given
+ * either by a mask array of the same shape as x (non zero entries are
+ * visited) or by a condition on the value itself. Conditions use the
+ * encoding of simdOps::MatchCondition: {compare, eps, mode}.
+ */
+
+#ifndef LIBND4J_MASK_H
+#define LIBND4J_MASK_H
+
+#include <algorithm>
+#include <dll.h>
+#include <shape.h>
+#include <pairwise_util.h>
+#include <ops.h>
+
+/**
+ * Selected values are buffered in blocks of this
+ * many for the block kernels of masked moments
+ */
+#define ND4J_MASK_BLOCK 512
+
+namespace nd4j {
+	namespace mask {
+
+		/**
+		 * Tads of x (and of the mask, when there is one) along the given
+		 * dimensions. Every tad is walked by a StridedIterator over x, the
+		 * mask and the c ordered position of an element within the tad,
+		 * either in the memory order of x or, for ops whose result depends
+		 * on the visiting order, in c order.
+		 */
+		template<typename T>
+		class MaskedTads {
+		public:
+			int numTads;
+			Nd4jIndex tadLength;
+
+			int *xTadOffsets;
+			int *maskTadOffsets;
+
+			// iterator operands
+			int xOperand;
+			int positionOperand;
+			static const int maskOperand = 2;
+
+			/**
+			 * @param xShapeInfo the shape information for x
+			 * @param maskShapeInfo the shape information for the mask, null without a mask
+			 * @param dimension the dimensions to reduce along, null or MAX_DIMENSION for the whole array
+			 * @param dimensionLength the number of dimensions
+			 * @param tadShapeInfo unused, the tads are described by xShapeInfo
+			 * @param tadOffsets optional precomputed tad offsets for x
+			 * @param cOrder whether to visit elements in c order rather than memory order
+			 */
+			MaskedTads(int *xShapeInfo, int *maskShapeInfo, int *dimension, int dimensionLength, int *tadShapeInfo, int *tadOffsets, bool cOrder) {
+				const Nd4jIndex length = shape::length(xShapeInfo);
+				const int xRank = shape::rank(xShapeInfo);
+				xTadOffsets = tadOffsets;
+				maskTadOffsets = &wholeOffset;
+				xTad = nullptr;
+				maskTad = nullptr;
+				wholeOffset = 0;
+				rank = 0;
+
+				if (dimension == nullptr || dimension[0] == MAX_DIMENSION || dimensionLength >= xRank) {
+					xTadOffsets = &wholeOffset;
+					tadLength = length;
+					numTads = 1;
+					for (int i = 0; i < xRank; i++)
+						dimensions[rank++] = i;
+				}
+				else {
+					tadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
+					numTads = (int) (length / tadLength);
+					for (int i = 0; i < dimensionLength; i++)
+						dimensions[rank++] = dimension[i] < 0 ? dimension[i] + xRank : dimension[i];
+					std::sort(dimensions, dimensions + rank);
+
+					if (xTadOffsets == nullptr) {
+						xTad = new shape::TAD(xShapeInfo, dimension, dimensionLength);
+						xTad->createTadOnlyShapeInfo();
+						xTad->createOffsets();
+						xTadOffsets = xTad->tadOffsets;
+					}
+
+					if (maskShapeInfo != nullptr) {
+						maskTad = new shape::TAD(maskShapeInfo, dimension, dimensionLength);
+						maskTad->createTadOnlyShapeInfo();
+						maskTad->createOffsets();
+						maskTadOffsets = maskTad->tadOffsets;
+					}
+				}
+
+				xOperand = cOrder ? 1 : 0;
+				positionOperand = cOrder ? 0 : 1;
+
+				int position = 1;
+				for (int i = rank - 1; i >= 0; i--) {
+					tadShape[i] = shape::shapeOf(xShapeInfo)[dimensions[i]];
+					tadStrides[positionOperand][i] = position;
+					tadStrides[xOperand][i] = shape::stride(xShapeInfo)[dimensions[i]];
+					tadStrides[maskOperand][i] = maskShapeInfo != nullptr ? shape::stride(maskShapeInfo)[dimensions[i]] : 0;
+					position *= tadShape[i];
+				}
+			}
+
+			/**
+			 * Whether the mask, if there is one, has the shape of x: it is
+			 * read at x's positions, so any other shape would be read out of
+			 * bounds. Reports the mismatch.
+			 */
+			static inline bool fits(int *xShapeInfo, int *maskShapeInfo) {
+				if (maskShapeInfo == nullptr || shape::shapeEquals(xShapeInfo, maskShapeInfo))
+					return true;
+				printf("Masked reduction: the mask must have the shape of x\n");
+				return false;
+			}
+
+			~MaskedTads() {
+				if (xTad != nullptr)
+					delete xTad;
+				if (maskTad != nullptr)
+					delete maskTad;
+			}
+
+			/**
+			 * A fresh iterator over one tad, operands xOperand, positionOperand and maskOperand
+			 */
+			inline StridedIterator iterator() const {
+				return StridedIterator(rank, const_cast<int *>(tadShape), const_cast<int *>(tadStrides[0]), const_cast<int *>(tadStrides[1]), const_cast<int *>(tadStrides[2]));
+			}
+
+		private:
+			shape::TAD *xTad;
+			shape::TAD *maskTad;
+			int wholeOffset;
+
+			int rank;
+			int dimensions[MAX_RANK];
+			int tadShape[MAX_RANK];
+			int tadStrides[3][MAX_RANK];
+
+			MaskedTads(const MaskedTads &other);
+			MaskedTads &operator=(const MaskedTads &other);
+		};
+
+		/**
+		 * Calls visitor(value, index) for every selected element among
+		 * elements [start, end) of the given tad, counted in the order
+		 * the tads are visited in; index is the position of the element
+		 * within the tad in c order.
+		 *
+		 * Elements are selected by a non zero mask entry when mask is
+		 * given, otherwise by condition (see simdOps::MatchCondition).
+		 */
+		template<typename T, typename Visitor>
+		inline void forEachSelected(const MaskedTads<T> &tads, T *x, T *mask, T *condition, int tad, Nd4jIndex start, Nd4jIndex end, Visitor &visitor) {
+			StridedIterator iter = tads.iterator();
+			const Nd4jIndex innerLength = iter.innerLength();
+			const int xStride = iter.innerStride(tads.xOperand);
+			const int positionStride = iter.innerStride(tads.positionOperand);
+			const int maskStride = iter.innerStride(MaskedTads<T>::maskOperand);
+			T *tadX = x + tads.xTadOffsets[tad];
+			T *tadMask = mask != nullptr ? mask + tads.maskTadOffsets[tad] : nullptr;
+			Nd4jIndex first = start % innerLength;
+			iter.seek(start / innerLength);
+
+			for (Nd4jIndex remaining = end - start; remaining > 0; iter.next()) {
+				T *run = tadX + iter.offsets[tads.xOperand];
+				Nd4jIndex position = iter.offsets[tads.positionOperand];
+				Nd4jIndex last = first + remaining < innerLength ? first + remaining : innerLength;
+
+				if (tadMask != nullptr) {
+					T *maskRun = tadMask + iter.offsets[MaskedTads<T>::maskOperand];
+					for (Nd4jIndex i = first; i < last; i++) {
+						if (maskRun[i * maskStride] != (T) 0.0)
+							visitor(run[i * xStride], position + i * positionStride);
+					}
+				}
+				else {
+					for (Nd4jIndex i = first; i < last; i++) {
+						T value = run[i * xStride];
+						if (simdOps::MatchCondition<T>::op(value, condition) != (T) 0.0)
+							visitor(value, position + i * positionStride);
+					}
+				}
+
+				remaining -= last - first;
+				first = 0;
+			}
+		}
+	}
+}
+
+#endif //LIBND4J_MASK_H
@@ -3,6 +3,8 @@
 #define OPS_H_
 
 #include <shape.h>
+#include <fastmath.h>
+#include <philox.h>
 #include <vector>
 
 #define MIN 1e-12
@@ -14,6 +16,7 @@
 #define EPS 1e-5
 
 #define no_op_exec_special 	static const bool requiresSpecial = false; static void execSpecial(T *dx, int *xShapeBuffer, T *result, int *resultShapeBuffer, T *extraParams) {}
+#define random_op_fill 	static inline void fill(T *values, Nd4jIndex start, int n, nd4j::random::RandomGenerator *rng, T *params) { for (int e = 0; e < n; e++) values[e] = op(values[e], start + e, rng, params); }
 #ifdef __CUDACC__
 #include <sharedmem.h>
 #define no_op_exec_special_cuda static __device__ void execSpecialCuda(T *dx,int *xShapeBuffer,T *result,int *resultShapeBuffer,T *extraParams, int *allocationPointer, T *reductionPointer, UnifiedSharedMemory *manager) {}
@@ -360,7 +363,7 @@ namespace simdOps {
 		no_op_exec_special_cuda
 
 		op_def static T op(T d1, T *params) {
-			return nd4j::math::nd4j_exp<T>(d1);
+			return nd4j::math::nd4j_fastexp<T>(d1);
 		}
 	};
 
@@ -411,7 +414,7 @@ namespace simdOps {
 		no_op_exec_special_cuda
 
 		op_def static T op(T d1, T *params) {
-			return nd4j::math::nd4j_log<T>(d1);
+			return nd4j::math::nd4j_fastlog<T>(d1);
 		}
 	};
 
@@ -482,7 +485,7 @@ namespace simdOps {
 		no_op_exec_special_cuda
 
 		op_def static T op(T d1, T *params) {
-			return nd4j::math::nd4j_sigmoid<T>(d1);
+			return nd4j::math::nd4j_fastsigmoid<T>(d1);
 		}
 	};
 
@@ -556,7 +559,7 @@ namespace simdOps {
 		no_op_exec_special_cuda
 
 		op_def static T op(T d1, T *params) {
-			return nd4j::math::softplus<T>(d1);
+			return nd4j::math::nd4j_fastsoftplus<T>(d1);
 		}
 	};
 
@@ -592,7 +595,7 @@ namespace simdOps {
 		no_op_exec_special_cuda
 
 		op_def static T op(T d1, T *params) {
-			return nd4j::math::nd4j_tanh<T>(d1);
+			return nd4j::math::nd4j_fasttanh<T>(d1);
 		}
 	};
 
@@ -663,7 +666,7 @@ namespace simdOps {
 		no_op_exec_special_cuda
 
 		op_def static T op(T d1, T *params) {
-			return nd4j::math::nd4j_elu<T>(d1);
+			return nd4j::math::nd4j_fastelu<T>(d1);
 		}
 	};
 
@@ -1501,7 +1504,7 @@ template<typename T>
             int tid = gridDim.x * blockDim.x + threadIdx.x;
             T rnd = nd4j::math::nd4j_abs<T>(nd4j::math::nd4j_cos<T>(clock64() * tid + length * tid));
 #else
-			T rnd = (T) rand() / (T) RAND_MAX;
+			T rnd = nd4j::random::threadUniform<T>();
 #endif
 			return rnd <= prob ? (T) 0.0 : d1;
 		}
@@ -1520,13 +1523,157 @@ template<typename T>
 			int tid = gridDim.x * blockDim.x + threadIdx.x;
             T rnd = nd4j::math::nd4j_abs<T>(nd4j::math::nd4j_cos<T>(clock64() * tid + length * tid));
 #else
-			T rnd = (T) rand() / (T) RAND_MAX;
+			T rnd = nd4j::random::threadUniform<T>();
 #endif
 			return rnd >= prob ? 0 : d1 / prob;
 		}
 	};
 
 
+	/**
+	 * Random ops: fill replaces a tile of consecutive elements (in c
+	 * order, starting at start) with its draws. Most ops draw every
+	 * element from its own stream position through op, the normals
+	 * share one block between lanes<T>() consecutive positions.
+	 * Values hold 0 for ops that only fill the result.
+	 */
+	template<typename T>
+	class UniformDistribution {
+	public:
+		random_op_fill
+
+		op_def static T op(T d1, Nd4jIndex i, nd4j::random::RandomGenerator *rng, T *params) {
+			T from = params[0];
+			T to = params[1];
+			return from + (to - from) * rng->uniform<T>(i, 0);
+		}
+	};
+
+
+	template<typename T>
+	class GaussianDistribution {
+	public:
+		/**
+		 * Every block gives lanes<T>() normals (both values of each
+		 * Box-Muller pair), used by consecutive stream positions
+		 */
+		static inline void fill(T *values, Nd4jIndex start, int n, nd4j::random::RandomGenerator *rng, T *params) {
+			T mean = params[0];
+			T stddev = params[1];
+			const int lanes = nd4j::random::RandomGenerator::lanes<T>();
+			const nd4j::random::uint64 first = rng->position(start);
+			T normals[4];
+			for (int e = 0; e < n;) {
+				nd4j::random::uint64 position = first + e;
+				rng->gaussians<T>(position / lanes, 0, normals);
+				for (int l = (int) (position % lanes); l < lanes && e < n; l++, e++)
+					values[e] = mean + stddev * normals[l];
+			}
+		}
+	};
+
+
+	/**
+	 * Normal samples more than 2 stddev away from the mean are redrawn
+	 * from the same lane of the next sub block
+	 */
+	template<typename T>
+	class TruncatedNormalDistribution {
+	public:
+		static inline void fill(T *values, Nd4jIndex start, int n, nd4j::random::RandomGenerator *rng, T *params) {
+			T mean = params[0];
+			T stddev = params[1];
+			const int lanes = nd4j::random::RandomGenerator::lanes<T>();
+			const nd4j::random::uint64 first = rng->position(start);
+			T normals[4];
+			T redraw[4];
+			for (int e = 0; e < n;) {
+				nd4j::random::uint64 position = first + e;
+				nd4j::random::uint64 block = position / lanes;
+				rng->gaussians<T>(block, 0, normals);
+				for (int l = (int) (position % lanes); l < lanes && e < n; l++, e++) {
+					T z = normals[l];
+					// 4.6% of draws are rejected, 16 attempts all failing is ~1e-21
+					for (int attempt = 1; attempt < 16 && (z < (T) -2.0 || z > (T) 2.0); attempt++) {
+						rng->gaussians<T>(block, attempt, redraw);
+						z = redraw[l];
+					}
+
+					z = z < (T) -2.0 ? (T) -2.0 : z > (T) 2.0 ? (T) 2.0 : z;
+					values[e] = mean + stddev * z;
+				}
+			}
+		}
+	};
+
+
+	template<typename T>
+	class BernoulliDistribution {
+	public:
+		random_op_fill
+
+		op_def static T op(T d1, Nd4jIndex i, nd4j::random::RandomGenerator *rng, T *params) {
+			T prob = params[0];
+			return rng->uniform<T>(i, 0) < prob ? (T) 1.0 : (T) 0.0;
+		}
+	};
+
+
+	/**
+	 * Number of successes in params[0] trials, one uniform per trial,
+	 * every block gives the uniforms of lanes<T>() trials
+	 */
+	template<typename T>
+	class BinomialDistribution {
+	public:
+		random_op_fill
+
+		op_def static T op(T d1, Nd4jIndex i, nd4j::random::RandomGenerator *rng, T *params) {
+			int trials = (int) params[0];
+			T prob = params[1];
+			const int lanes = nd4j::random::RandomGenerator::lanes<T>();
+			const nd4j::random::uint64 position = rng->position(i);
+			T uniforms[4];
+			int successes = 0;
+			for (int t = 0; t < trials; t++) {
+				if (t % lanes == 0)
+					rng->uniforms<T>(position, t / lanes, uniforms);
+				if (uniforms[t % lanes] < prob)
+					successes++;
+			}
+
+			return (T) successes;
+		}
+	};
+
+
+	/**
+	 * DropOut and DropOutInverted with reproducible draws
+	 */
+	template<typename T>
+	class RandomDropOut {
+	public:
+		random_op_fill
+
+		op_def static T op(T d1, Nd4jIndex i, nd4j::random::RandomGenerator *rng, T *params) {
+			T prob = params[0];
+			return rng->uniform<T>(i, 0) <= prob ? (T) 0.0 : d1;
+		}
+	};
+
+
+	template<typename T>
+	class RandomDropOutInverted {
+	public:
+		random_op_fill
+
+		op_def static T op(T d1, Nd4jIndex i, nd4j::random::RandomGenerator *rng, T *params) {
+			T prob = params[0];
+			return rng->uniform<T>(i, 0) >= prob ? (T) 0.0 : d1 / prob;
+		}
+	};
+
+
 	template<typename T>
 	class ReplaceNans {
 	public:
@@ -1596,6 +1743,105 @@ template<typename T>
         }
     };
 
+    /**
+     * Median, an order statistic: ReduceFunction computes it by selection
+     * on a copy of every tad (see IsOrderStatistic in reduce.h), the remaining
+     * members only satisfy the reduce op interface. Not supported on cuda.
+     */
+    template<typename T>
+    class Median {
+    public:
+
+        op_def static T startingValue(const T *input) {
+            return (T) 0.0;
+        }
+
+        op_def static T merge(T old, T opOutput, T *extraParams) {
+            return opOutput;
+        }
+
+        op_def static T update(T old, T opOutput, T *extraParams) {
+            return opOutput;
+        }
+
+        op_def static T op(T d1, T *extraParams) {
+            return d1;
+        }
+
+        op_def static T postProcess(T reduction, Nd4jIndex n, T *extraParams) {
+            return reduction;
+        }
+    };
+
+    /**
+     * Quantile extraParams[0] (0.0 - 1.0) with linear interpolation
+     * between the closest ranks, see Median
+     */
+    template<typename T>
+    class Quantile {
+    public:
+
+        op_def static T startingValue(const T *input) {
+            return (T) 0.0;
+        }
+
+        op_def static T merge(T old, T opOutput, T *extraParams) {
+            return opOutput;
+        }
+
+        op_def static T update(T old, T opOutput, T *extraParams) {
+            return opOutput;
+        }
+
+        op_def static T op(T d1, T *extraParams) {
+            return d1;
+        }
+
+        op_def static T postProcess(T reduction, Nd4jIndex n, T *extraParams) {
+            return reduction;
+        }
+    };
+
+    /**
+     * log(sum(exp(x))), computed without overflow: update() adds values
+     * in log space relative to the larger one, so the running value is
+     * rescaled by the running max at every step. ReduceFunction reduces
+     * contiguous data in blocks instead (see ReduceFunction::logSumExp).
+     */
+    template<typename T>
+    class LogSumExp {
+    public:
+
+        op_def static T startingValue(const T *input) {
+            return (T) -MAX_FLOAT;
+        }
+
+        op_def static T merge(T old, T opOutput, T *extraParams) {
+            return logAddExp(old, opOutput);
+        }
+
+        op_def static T update(T old, T opOutput, T *extraParams) {
+            return logAddExp(old, opOutput);
+        }
+
+        op_def static T op(T d1, T *extraParams) {
+            return d1;
+        }
+
+        op_def static T postProcess(T reduction, Nd4jIndex n, T *extraParams) {
+            return reduction;
+        }
+
+        op_def static T logAddExp(T a, T b) {
+            T hi = nd4j::math::nd4j_max<T>(a, b);
+            T lo = nd4j::math::nd4j_min<T>(a, b);
+            if (lo <= (T) -MAX_FLOAT || hi >= (T) MAX_FLOAT)
+                return hi;
+
+            return hi + nd4j::math::nd4j_log<T>((T) 1.0 + nd4j::math::nd4j_exp<T>(lo - hi));
+        }
+    };
+
     // this op is used for conditional pairwise transforms only
     template<typename T>
     class CompareAndReplace{
@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <ops.h>
 #include <op_boilerplate.h>
+#include <isa_dispatch.h>
 
 #ifdef __CUDACC__
 #include <cuda.h>
@@ -344,6 +345,18 @@ template<typename OpType>
 				DISPATCH_BY_OPNUM(exec, PARAMS(dx, xStride, y, yStride, result, resultStride, extraParams, n), PAIRWISE_TRANSFORM_OPS);
 			}
 
+			static void execBroadcast(
+				const int opNum,
+				T *dx,
+				int *xShapeBuffer,
+				T *y,
+				int *yShapeBuffer,
+				T *result,
+				int *resultShapeBuffer,
+				T *extraParams) {
+				DISPATCH_BY_OPNUM(execBroadcast, PARAMS(dx, xShapeBuffer, y, yShapeBuffer, result, resultShapeBuffer, extraParams), PAIRWISE_TRANSFORM_OPS);
+			}
+
 			template<typename OpType>
 			static void exec(
                     T *dx,
@@ -366,6 +379,7 @@ template<typename OpType>
             }
 
 			template<typename OpType>
+			ND4J_ISA_DISPATCH
 			static void exec(
                     T *dx,
                     int *xShapeBuffer,
@@ -534,7 +548,101 @@ for (Nd4jIndex i = 0; i < xShape[0]; i++) {
                 }
             }
 
+			/**
+			 * Pairwise op with numpy style broadcasting: the shapes of x
+			 * and y are aligned on their last dimension, every dimension
+			 * of x and y has to be 1 (or missing) or equal to the matching
+			 * dimension of result, which has the broadcast shape.
+			 *
+			 * Broadcast dimensions get stride 0, so neither operand is ever
+			 * expanded: result, x and y are walked by one coalesced
+			 * StridedIterator and whole innermost runs are distributed
+			 * between threads.
+			 *
+			 * @param dx the first operand
+			 * @param xShapeBuffer the shape information for the first operand
+			 * @param y the second operand
+			 * @param yShapeBuffer the shape information for the second operand
+			 * @param result the result buffer
+			 * @param resultShapeBuffer the shape information for the result
+			 * @param extraParams the extra params for the op
+			 */
+			template<typename OpType>
+			ND4J_ISA_DISPATCH
+			static void execBroadcast(
+                    T *dx,
+                    int *xShapeBuffer,
+                    T *y,
+                    int *yShapeBuffer,
+                    T *result,
+                    int *resultShapeBuffer,
+                    T *extraParams) {
+                int rank = shape::rank(resultShapeBuffer);
+                int *resultShape = shape::shapeOf(resultShapeBuffer);
+                int xStrides[MAX_RANK];
+                int yStrides[MAX_RANK];
+
+                if (!broadcastStrides(xShapeBuffer, rank, resultShape, xStrides) || !broadcastStrides(yShapeBuffer, rank, resultShape, yStrides)) {
+                    printf("Pairwise broadcast: operand shapes don't broadcast to the result shape\n");
+                    return;
+                }
+
+                StridedIterator iter(rank, resultShape, shape::stride(resultShapeBuffer), xStrides, yStrides);
+                const Nd4jIndex innerLength = iter.innerLength();
+                const int resultInnerStride = iter.innerStride(0);
+                const int xInnerStride = iter.innerStride(1);
+                const int yInnerStride = iter.innerStride(2);
+
+                TadBlockInformation runInfo(1, iter.outerLength(), 8192 / (innerLength > 0 ? innerLength : 1));
+
+#pragma omp parallel for schedule(static) if (runInfo.isSplit())
+                for (int c = 0; c < runInfo.chunksPerTad; c++) {
+                    StridedIterator chunkIter = iter;
+                    chunkIter.seek(runInfo.chunkStart(c));
+
+                    for (Nd4jIndex run = runInfo.chunkStart(c); run < runInfo.chunkEnd(c); run++) {
+                        T *resultIter = result + chunkIter.offsets[0];
+                        T *xIter = dx + chunkIter.offsets[1];
+                        T *yIter = y + chunkIter.offsets[2];
+#pragma omp simd
+                        for (Nd4jIndex i = 0; i < innerLength; i++)
+                            resultIter[i * resultInnerStride] = OpType::op(xIter[i * xInnerStride], yIter[i * yInnerStride], extraParams);
+
+                        chunkIter.next();
+                    }
+                }
+            }
+
+			/**
+			 * Strides of an operand expanded to the result shape,
+			 * 0 along broadcast dimensions. Returns false if the
+			 * operand doesn't broadcast to the result shape.
+			 */
+			static bool broadcastStrides(int *shapeBuffer, int rank, int *resultShape, int *strides) {
+                int operandRank = shape::rank(shapeBuffer);
+                int *operandShape = shape::shapeOf(shapeBuffer);
+                int *operandStride = shape::stride(shapeBuffer);
+                if (operandRank > rank)
+                    return false;
+
+                for (int i = 0; i < rank; i++) {
+                    int d = i - (rank - operandRank);
+                    if (d < 0 || operandShape[d] == 1) {
+                        strides[i] = 0;
+                    }
+                    else if (operandShape[d] == resultShape[i]) {
+                        strides[i] = operandStride[d];
+                    }
+                    else {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
 			template<typename OpType>
+			ND4J_ISA_DISPATCH
 			static void exec(T *dx,
                               Nd4jIndex xStride,
                               T *y,
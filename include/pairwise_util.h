@@ -250,11 +250,332 @@ public:
 };
 
 
+/**
+ * Two level work split for reductions along dimensions.
+ *
+ * Reductions normally parallelize across tads only, which leaves
+ * most threads idle when there are few, very long tads. When there
+ * are fewer tads than threads every tad is cut into chunksPerTad
+ * chunks of at least minChunkLength items, so that numChunks()
+ * (tad, chunk) pairs can be processed in one parallel loop with
+ * per chunk partials merged per tad afterwards.
+ *
+ * Note the split depends on the number of threads.
+ */
+class TadBlockInformation {
+public:
+    Nd4jIndex numTads;
+    Nd4jIndex tadLength;
+    int chunksPerTad;
+    Nd4jIndex chunkLength;
+
+    TadBlockInformation(Nd4jIndex numTads, Nd4jIndex tadLength, Nd4jIndex minChunkLength = 8192) {
+        this->numTads = numTads;
+        this->tadLength = tadLength;
+        chunksPerTad = 1;
+
+        int threads = omp_get_max_threads();
+        if (minChunkLength < 1)
+            minChunkLength = 1;
+
+        if (numTads > 0 && numTads < threads && tadLength >= 2 * minChunkLength) {
+            Nd4jIndex wanted = (threads + numTads - 1) / numTads;
+            Nd4jIndex possible = tadLength / minChunkLength;
+            chunksPerTad = (int) (wanted < possible ? wanted : possible);
+        }
+
+        chunkLength = (tadLength + chunksPerTad - 1) / chunksPerTad;
+    }
+
+    inline bool isSplit() const {
+        return chunksPerTad > 1;
+    }
+
+    inline Nd4jIndex numChunks() const {
+        return numTads * chunksPerTad;
+    }
+
+    /**
+     * First item of the given chunk of a tad, 0 <= chunk < chunksPerTad
+     */
+    inline Nd4jIndex chunkStart(int chunk) const {
+        return chunk * chunkLength;
+    }
+
+    inline Nd4jIndex chunkEnd(int chunk) const {
+        Nd4jIndex end = (chunk + 1) * chunkLength;
+        return end < tadLength ? end : tadLength;
+    }
+};
+
+
+/**
+ * Offsets of the elements of a (tad) shape in logical c order,
+ * for ops whose result depends on the position of an element
+ * (scans, index returning ops) rather than just its value.
+ *
+ * Returns nullptr and sets stride when consecutive elements are
+ * a constant stride apart (vectors, c ordered views), otherwise
+ * returns a table of length offsets the caller has to delete[].
+ */
+#ifdef __CUDACC__
+__host__
+#endif
+inline Nd4jIndex *cOrderElementOffsets(int rank, int *shape, int *strides, Nd4jIndex length, int &stride) {
+    stride = 0;
+    Nd4jIndex expected = 0;
+    bool linear = true;
+    for (int d = rank - 1; d >= 0; d--) {
+        if (shape[d] == 1)
+            continue;
+
+        if (stride == 0) {
+            stride = strides[d];
+            expected = (Nd4jIndex) strides[d] * shape[d];
+        }
+        else if (strides[d] != expected) {
+            linear = false;
+            break;
+        }
+        else
+            expected *= shape[d];
+    }
+
+    if (stride == 0)
+        stride = 1;
+
+    if (linear)
+        return nullptr;
+
+    Nd4jIndex *offsets = new Nd4jIndex[length];
+    Nd4jIndex coord[MAX_RANK];
+    for (int d = 0; d < rank; d++)
+        coord[d] = 0;
+
+    Nd4jIndex offset = 0;
+    for (Nd4jIndex e = 0; e < length; e++) {
+        offsets[e] = offset;
+        for (int d = rank - 1; d >= 0; d--) {
+            if (++coord[d] < shape[d]) {
+                offset += strides[d];
+                break;
+            }
+
+            offset -= (Nd4jIndex) strides[d] * (shape[d] - 1);
+            coord[d] = 0;
+        }
+    }
+
+    return offsets;
+}
+
+
 class CudaBlockInformation {
 
 };
 
 
+#define ND4J_STRIDED_ITER_MAX_OPERANDS 3
+
+/**
+ * Rank generic, allocation free iterator over
+ * up to three strided operands sharing one shape.
+ *
+ * Size 1 dimensions are dropped, the remaining dimensions
+ * are ordered by the strides of the first operand
+ * (largest stride outermost) and adjacent dimensions
+ * that are contiguous for every operand are coalesced.
+ *
+ * The innermost dimension is exposed via innerLength()/innerStride()
+ * so the caller can run a plain simd loop over it, while next()
+ * advances the outer dimensions odometer style by adding/subtracting
+ * strides rather than recomputing offsets with ind2sub/getOffset.
+ *
+ * Note that the visiting order is the memory order of the first
+ * operand, not the logical c/f order of the shape.
+ *
+ * Typical usage:
+ *   StridedIterator iter(rank, shape, xStride, zStride);
+ *   do {
+ *       T *xIter = x + iter.offsets[0];
+ *       ...
+ *       for (Nd4jIndex i = 0; i < iter.innerLength(); i++)
+ *           ... xIter[i * iter.innerStride(0)] ...
+ *   } while (iter.next());
+ */
+class StridedIterator {
+public:
+    int rank;
+    int numOperands;
+    Nd4jIndex shape[MAX_RANK];
+    int strides[ND4J_STRIDED_ITER_MAX_OPERANDS][MAX_RANK];
+    Nd4jIndex coord[MAX_RANK];
+    Nd4jIndex offsets[ND4J_STRIDED_ITER_MAX_OPERANDS];
+
+#ifdef __CUDACC__
+    __host__ __device__
+#endif
+    StridedIterator(int ndim, int *inShape, int *stridesA, int *stridesB = nullptr, int *stridesC = nullptr) {
+        int *inStrides[ND4J_STRIDED_ITER_MAX_OPERANDS] = {stridesA, stridesB, stridesC};
+        numOperands = stridesC != nullptr ? 3 : (stridesB != nullptr ? 2 : 1);
+        rank = 0;
+
+        /* drop unit dimensions, insertion sort the rest by descending |stride| of operand A */
+        for (int i = 0; i < ndim; i++) {
+            if (inShape[i] == 0) {
+                rank = 1;
+                shape[0] = 0;
+                for (int e = 0; e < numOperands; e++)
+                    strides[e][0] = 0;
+                reset();
+                return;
+            }
+
+            if (inShape[i] == 1)
+                continue;
+
+            int key = stridesA[i] < 0 ? -stridesA[i] : stridesA[i];
+            int pos = rank;
+            while (pos > 0 && (strides[0][pos - 1] < 0 ? -strides[0][pos - 1] : strides[0][pos - 1]) < key) {
+                shape[pos] = shape[pos - 1];
+                for (int e = 0; e < numOperands; e++)
+                    strides[e][pos] = strides[e][pos - 1];
+                pos--;
+            }
+
+            shape[pos] = inShape[i];
+            for (int e = 0; e < numOperands; e++)
+                strides[e][pos] = inStrides[e][i];
+            rank++;
+        }
+
+        if (rank == 0) {
+            rank = 1;
+            shape[0] = 1;
+            for (int e = 0; e < numOperands; e++)
+                strides[e][0] = 0;
+            reset();
+            return;
+        }
+
+        /* coalesce dimensions that are contiguous for all operands */
+        int last = 0;
+        for (int i = 1; i < rank; i++) {
+            bool contiguous = true;
+            for (int e = 0; e < numOperands; e++) {
+                if ((Nd4jIndex) strides[e][last] != (Nd4jIndex) strides[e][i] * shape[i]) {
+                    contiguous = false;
+                    break;
+                }
+            }
+
+            if (contiguous) {
+                shape[last] *= shape[i];
+                for (int e = 0; e < numOperands; e++)
+                    strides[e][last] = strides[e][i];
+            }
+            else {
+                last++;
+                shape[last] = shape[i];
+                for (int e = 0; e < numOperands; e++)
+                    strides[e][last] = strides[e][i];
+            }
+        }
+        rank = last + 1;
+
+        reset();
+    }
+
+    /**
+     * Length of the innermost (fastest varying) dimension
+     */
+#ifdef __CUDACC__
+    __host__ __device__
+#endif
+    inline Nd4jIndex innerLength() const {
+        return shape[rank - 1];
+    }
+
+    /**
+     * Stride of the innermost dimension for the given operand
+     */
+#ifdef __CUDACC__
+    __host__ __device__
+#endif
+    inline int innerStride(int operand) const {
+        return strides[operand][rank - 1];
+    }
+
+    /**
+     * Number of innermost runs, i.e. the product of all
+     * but the innermost dimension
+     */
+#ifdef __CUDACC__
+    __host__ __device__
+#endif
+    inline Nd4jIndex outerLength() const {
+        Nd4jIndex ret = 1;
+        for (int i = 0; i < rank - 1; i++)
+            ret *= shape[i];
+        return ret;
+    }
+
+#ifdef __CUDACC__
+    __host__ __device__
+#endif
+    inline void reset() {
+        for (int i = 0; i < rank; i++)
+            coord[i] = 0;
+        for (int e = 0; e < numOperands; e++)
+            offsets[e] = 0;
+    }
+
+    /**
+     * Position the iterator at the beginning of
+     * the given innermost run, 0 <= outerIndex < outerLength().
+     * Used to split the outer loop between threads.
+     */
+#ifdef __CUDACC__
+    __host__ __device__
+#endif
+    inline void seek(Nd4jIndex outerIndex) {
+        for (int e = 0; e < numOperands; e++)
+            offsets[e] = 0;
+
+        coord[rank - 1] = 0;
+        for (int i = rank - 2; i >= 0; i--) {
+            coord[i] = outerIndex % shape[i];
+            outerIndex /= shape[i];
+            for (int e = 0; e < numOperands; e++)
+                offsets[e] += coord[i] * strides[e][i];
+        }
+    }
+
+    /**
+     * Advance to the next innermost run.
+     * @return false once all runs were visited
+     */
+#ifdef __CUDACC__
+    __host__ __device__
+#endif
+    inline bool next() {
+        for (int i = rank - 2; i >= 0; i--) {
+            if (++coord[i] < shape[i]) {
+                for (int e = 0; e < numOperands; e++)
+                    offsets[e] += strides[e][i];
+                return true;
+            }
+
+            coord[i] = 0;
+            for (int e = 0; e < numOperands; e++)
+                offsets[e] -= (shape[i] - 1) * strides[e][i];
+        }
+
+        return false;
+    }
+};
+
+
 /**
  * Credit to:
  * http://alienryderflex.com/quicksort/
@@ -0,0 +1,212 @@
+/*
+ * permute.h
+ *
+ * Cache blocked element wise copies between arrays of the same
+ * shape but different layouts (c <-> f conversion, materialising
+ * permuted views).
+ */
+
+#ifndef LIBND4J_PERMUTE_H
+#define LIBND4J_PERMUTE_H
+
+#include <dll.h>
+#include <shape.h>
+#include <omp.h>
+#include <pairwise_util.h>
+#include <isa_dispatch.h>
+#include <ops.h>
+
+namespace functions {
+	namespace permute {
+
+		template<typename T>
+		class Permute {
+		public:
+
+			/**
+			 * Copies x into z, both of the given shape
+			 */
+			static void copy(int rank, int *shape, T *x, int *xStrides, T *z, int *zStrides) {
+				exec<simdOps::Identity<T>>(rank, shape, x, xStrides, z, zStrides, nullptr);
+			}
+
+			/**
+			 * z = op(x) for arrays of the same length and rank, in any
+			 * order; elements are matched by their coordinates
+			 *
+			 * @param x the input
+			 * @param xShapeInfo the shape information for the input
+			 * @param z the result buffer
+			 * @param zShapeInfo the shape information for the result
+			 * @param extraParams the extra params for the op
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void exec(T *x, int *xShapeInfo, T *z, int *zShapeInfo, T *extraParams) {
+				exec<OpType>(shape::rank(xShapeInfo), shape::shapeOf(xShapeInfo), x, shape::stride(xShapeInfo), z, shape::stride(zShapeInfo), extraParams);
+			}
+
+			/**
+			 * z = op(x) element wise for two strided arrays of one shape.
+			 *
+			 * The dimensions are coalesced and ordered by the strides of z
+			 * (StridedIterator). If the fastest dimension of x is the
+			 * fastest of z as well this is a plain strided loop. Otherwise
+			 * one of the two would be walked with a large stride, touching
+			 * a new cache line (and often a new page) for every element, so
+			 * the plane of the two fastest dimensions is transposed in tiles:
+			 * blocks of it are distributed between threads and recursively
+			 * halved along the longer side down to 64 x 64 tiles, so every
+			 * cache line and page brought in for one array is fully used
+			 * before it is evicted.
+			 *
+			 * @param rank the rank of the shape
+			 * @param shape the shape of both arrays
+			 * @param x the input
+			 * @param xStrides the strides of the input
+			 * @param z the result buffer
+			 * @param zStrides the strides of the result
+			 * @param extraParams the extra params for the op
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			ND4J_ISA_DISPATCH
+			static void exec(int rank, int *shape, T *x, int *xStrides, T *z, int *zStrides, T *extraParams) {
+				StridedIterator iter(rank, shape, zStrides, xStrides);
+				const int inner = iter.rank - 1;
+				const Nd4jIndex innerLength = iter.innerLength();
+
+				// fastest dimension of x
+				int fast = inner;
+				for (int d = 0; d < inner; d++) {
+					if (absStride(iter.strides[1][d]) < absStride(iter.strides[1][fast]))
+						fast = d;
+				}
+
+				if (fast == inner) {
+					const int zInnerStride = iter.innerStride(0);
+					const int xInnerStride = iter.innerStride(1);
+					TadBlockInformation runInfo(1, iter.outerLength(), 8192 / (innerLength > 0 ? innerLength : 1));
+
+#pragma omp parallel for schedule(static) if (runInfo.isSplit())
+					for (int c = 0; c < runInfo.chunksPerTad; c++) {
+						StridedIterator chunkIter = iter;
+						chunkIter.seek(runInfo.chunkStart(c));
+
+						for (Nd4jIndex run = runInfo.chunkStart(c); run < runInfo.chunkEnd(c); run++) {
+							T *zIter = z + chunkIter.offsets[0];
+							T *xIter = x + chunkIter.offsets[1];
+#pragma omp simd
+							for (Nd4jIndex i = 0; i < innerLength; i++)
+								zIter[i * zInnerStride] = OpType::op(xIter[i * xInnerStride], extraParams);
+
+							chunkIter.next();
+						}
+					}
+
+					return;
+				}
+
+				// dimensions other than the tiled plane
+				int outerRank = 0;
+				Nd4jIndex outerShape[MAX_RANK];
+				Nd4jIndex outerZStrides[MAX_RANK];
+				Nd4jIndex outerXStrides[MAX_RANK];
+				Nd4jIndex numOuter = 1;
+				for (int d = 0; d < inner; d++) {
+					if (d == fast)
+						continue;
+
+					outerShape[outerRank] = iter.shape[d];
+					outerZStrides[outerRank] = iter.strides[0][d];
+					outerXStrides[outerRank] = iter.strides[1][d];
+					numOuter *= iter.shape[d];
+					outerRank++;
+				}
+
+				const Nd4jIndex fastLength = iter.shape[fast];
+				const Nd4jIndex zFastStride = iter.strides[0][fast];
+				const Nd4jIndex xFastStride = iter.strides[1][fast];
+				const Nd4jIndex zInnerStride = iter.strides[0][inner];
+				const Nd4jIndex xInnerStride = iter.strides[1][inner];
+
+				const Nd4jIndex fastBlocks = (fastLength + blockLength - 1) / blockLength;
+				const Nd4jIndex innerBlocks = (innerLength + blockLength - 1) / blockLength;
+				const Nd4jIndex numBlocks = numOuter * fastBlocks * innerBlocks;
+
+#pragma omp parallel for schedule(static) if (numBlocks > 1 && numOuter * fastLength * innerLength > 8192)
+				for (Nd4jIndex b = 0; b < numBlocks; b++) {
+					Nd4jIndex innerBlock = b % innerBlocks;
+					Nd4jIndex fastBlock = (b / innerBlocks) % fastBlocks;
+					Nd4jIndex outer = b / (innerBlocks * fastBlocks);
+
+					Nd4jIndex zOffset = fastBlock * blockLength * zFastStride + innerBlock * blockLength * zInnerStride;
+					Nd4jIndex xOffset = fastBlock * blockLength * xFastStride + innerBlock * blockLength * xInnerStride;
+					for (int d = outerRank - 1; d >= 0; d--) {
+						Nd4jIndex coord = outer % outerShape[d];
+						outer /= outerShape[d];
+						zOffset += coord * outerZStrides[d];
+						xOffset += coord * outerXStrides[d];
+					}
+
+					Nd4jIndex fastEnd = (fastBlock + 1) * blockLength < fastLength ? (fastBlock + 1) * blockLength : fastLength;
+					Nd4jIndex innerEnd = (innerBlock + 1) * blockLength < innerLength ? (innerBlock + 1) * blockLength : innerLength;
+
+					transposeTile<OpType>(x + xOffset, xFastStride, xInnerStride,
+										  z + zOffset, zFastStride, zInnerStride,
+										  fastEnd - fastBlock * blockLength, innerEnd - innerBlock * blockLength, extraParams);
+				}
+			}
+
+		private:
+			/**
+			 * Side of the blocks handed to threads, and of the tiles
+			 * they are cut into
+			 */
+			static const Nd4jIndex blockLength = 256;
+			static const Nd4jIndex tileLength = 64;
+
+			static inline Nd4jIndex absStride(int stride) {
+				return stride < 0 ? -stride : stride;
+			}
+
+			/**
+			 * rows x cols tile, x is contiguous-ish along rows and z along
+			 * cols; halves the longer side until the tile is small enough
+			 */
+			template<typename OpType>
+			static void transposeTile(T *x, Nd4jIndex xRowStride, Nd4jIndex xColStride,
+									  T *z, Nd4jIndex zRowStride, Nd4jIndex zColStride,
+									  Nd4jIndex rows, Nd4jIndex cols, T *extraParams) {
+				if (rows > tileLength || cols > tileLength) {
+					if (rows >= cols) {
+						Nd4jIndex half = rows / 2;
+						transposeTile<OpType>(x, xRowStride, xColStride, z, zRowStride, zColStride, half, cols, extraParams);
+						transposeTile<OpType>(x + half * xRowStride, xRowStride, xColStride, z + half * zRowStride, zRowStride, zColStride, rows - half, cols, extraParams);
+					}
+					else {
+						Nd4jIndex half = cols / 2;
+						transposeTile<OpType>(x, xRowStride, xColStride, z, zRowStride, zColStride, rows, half, extraParams);
+						transposeTile<OpType>(x + half * xColStride, xRowStride, xColStride, z + half * zColStride, zRowStride, zColStride, rows, cols - half, extraParams);
+					}
+
+					return;
+				}
+
+				for (Nd4jIndex r = 0; r < rows; r++) {
+					T *xRow = x + r * xRowStride;
+					T *zRow = z + r * zRowStride;
+#pragma omp simd
+					for (Nd4jIndex c = 0; c < cols; c++)
+						zRow[c * zColStride] = OpType::op(xRow[c * xColStride], extraParams);
+				}
+			}
+		};
+	}
+}
+
+#endif //LIBND4J_PERMUTE_H
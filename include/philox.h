@@ -0,0 +1,225 @@
+/*
+ * philox.h
+ *
+ * Counter based random numbers (Philox4x32-10, Salmon et al.,
+ * "Parallel random numbers: as easy as 1, 2, 3").
+ *
+ * Every draw is a pure function of (seed, offset + index, sub): there
+ * is no state shared between threads, so random ops can be split any
+ * way between threads (or vectorised) and still give the same numbers
+ * for the same seed and offset.
+ */
+
+#ifndef LIBND4J_PHILOX_H
+#define LIBND4J_PHILOX_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <templatemath.h>
+
+namespace nd4j {
+	namespace random {
+
+		typedef unsigned int uint32;
+		typedef unsigned long long uint64;
+
+		class RandomGenerator {
+		public:
+			/**
+			 * @param seed the key of the stream
+			 * @param offset the counter of element 0, a caller continuing a
+			 * stream passes the previous offset plus the number of elements drawn
+			 */
+			RandomGenerator(Nd4jIndex seed, Nd4jIndex offset) {
+				key0 = (uint32) (uint64) seed;
+				key1 = (uint32) ((uint64) seed >> 32);
+				this->offset = (uint64) offset;
+			}
+
+			/**
+			 * Philox4x32-10 of a full counter and key
+			 *
+			 * @param counter the 4 counter words
+			 * @param key the 2 key words
+			 * @param out the 4 random words
+			 */
+#ifdef __CUDACC__
+			__host__ __device__
+#endif
+			static inline void philox(const uint32 *counter, const uint32 *key, uint32 *out) {
+				uint32 c0 = counter[0];
+				uint32 c1 = counter[1];
+				uint32 c2 = counter[2];
+				uint32 c3 = counter[3];
+				uint32 k0 = key[0];
+				uint32 k1 = key[1];
+
+				for (int r = 0; r < 10; r++) {
+					uint64 p0 = (uint64) 0xD2511F53U * c0;
+					uint64 p1 = (uint64) 0xCD9E8D57U * c2;
+					uint32 n0 = (uint32) (p1 >> 32) ^ c1 ^ k0;
+					uint32 n2 = (uint32) (p0 >> 32) ^ c3 ^ k1;
+					c1 = (uint32) p1;
+					c3 = (uint32) p0;
+					c0 = n0;
+					c2 = n2;
+					k0 += 0x9E3779B9U;
+					k1 += 0xBB67AE85U;
+				}
+
+				out[0] = c0;
+				out[1] = c1;
+				out[2] = c2;
+				out[3] = c3;
+			}
+
+			/**
+			 * The 4 random words of block sub at stream position
+			 * offset + index
+			 */
+#ifdef __CUDACC__
+			__host__ __device__
+#endif
+			inline void block(Nd4jIndex index, uint32 sub, uint32 *out) const {
+				blockAt(offset + (uint64) index, sub, out);
+			}
+
+			/**
+			 * The 4 random words of block sub at an absolute position
+			 */
+#ifdef __CUDACC__
+			__host__ __device__
+#endif
+			inline void blockAt(uint64 position, uint32 sub, uint32 *out) const {
+				uint32 counter[4] = {(uint32) position, (uint32) (position >> 32), sub, 0};
+				uint32 key[2] = {key0, key1};
+				philox(counter, key, out);
+			}
+
+			/**
+			 * The absolute stream position of element index
+			 */
+#ifdef __CUDACC__
+			__host__ __device__
+#endif
+			inline uint64 position(Nd4jIndex index) const {
+				return offset + (uint64) index;
+			}
+
+			/**
+			 * Uniforms one block yields: 4 of 24 bits for float,
+			 * 2 of 53 bits for double
+			 */
+			template<typename T>
+#ifdef __CUDACC__
+			__host__ __device__
+#endif
+			static inline int lanes() {
+				return 4;
+			}
+
+			/**
+			 * All lanes<T>() uniforms in [0, 1) of block sub at an
+			 * absolute position
+			 */
+			template<typename T>
+#ifdef __CUDACC__
+			__host__ __device__
+#endif
+			inline void uniforms(uint64 position, uint32 sub, T *out) const {
+				uint32 words[4];
+				blockAt(position, sub, words);
+				if (lanes<T>() == 2) {
+					out[0] = toUniform<T>(words[0], words[1]);
+					out[1] = toUniform<T>(words[2], words[3]);
+				}
+				else {
+					for (int l = 0; l < 4; l++)
+						out[l] = toUniform<T>(words[l], 0);
+				}
+			}
+
+			/**
+			 * All lanes<T>() standard normals of block sub at an absolute
+			 * position, Box-Muller pairs of its uniforms
+			 */
+			template<typename T>
+#ifdef __CUDACC__
+			__host__ __device__
+#endif
+			inline void gaussians(uint64 position, uint32 sub, T *out) const {
+				T u[4];
+				uniforms<T>(position, sub, u);
+				for (int l = 0; l < lanes<T>(); l += 2) {
+					// 1 - u is in (0, 1], safe for the log
+					T radius = nd4j::math::nd4j_sqrt<T>((T) -2.0 * nd4j::math::nd4j_log<T>((T) 1.0 - u[l]));
+					T angle = (T) 6.283185307179586477 * u[l + 1];
+					out[l] = radius * nd4j::math::nd4j_cos<T>(angle);
+					out[l + 1] = radius * nd4j::math::nd4j_sin<T>(angle);
+				}
+			}
+
+			/**
+			 * Uniform in [0, 1) from the first words of block sub
+			 */
+			template<typename T>
+#ifdef __CUDACC__
+			__host__ __device__
+#endif
+			inline T uniform(Nd4jIndex index, uint32 sub) const {
+				uint32 words[4];
+				block(index, sub, words);
+				return toUniform<T>(words[0], words[1]);
+			}
+
+			/**
+			 * 24 random bits for float, 53 for double
+			 */
+			template<typename T>
+#ifdef __CUDACC__
+			__host__ __device__
+#endif
+			static inline T toUniform(uint32 w0, uint32 w1) {
+				return (T) (w0 >> 8) * (T) 5.9604644775390625E-8;
+			}
+
+		private:
+			uint32 key0;
+			uint32 key1;
+			uint64 offset;
+		};
+
+		template<>
+#ifdef __CUDACC__
+		__host__ __device__
+#endif
+		inline int RandomGenerator::lanes<double>() {
+			return 2;
+		}
+
+		template<>
+#ifdef __CUDACC__
+		__host__ __device__
+#endif
+		inline double RandomGenerator::toUniform<double>(uint32 w0, uint32 w1) {
+			return ((double) (w0 >> 5) * 67108864.0 + (double) (w1 >> 6)) * 1.1102230246251565404E-16;
+		}
+
+#ifndef __CUDACC__
+		/**
+		 * Uniform in [0, 1) from a stream private to the calling thread,
+		 * for element wise ops that don't know the index of the element.
+		 * Lock free, but the result depends on how elements are split
+		 * between threads; the random ops are the reproducible way.
+		 */
+		template<typename T>
+		inline T threadUniform() {
+			static thread_local uint64 drawn = 0;
+			RandomGenerator generator((Nd4jIndex) (size_t) &drawn, 0);
+			return generator.uniform<T>((Nd4jIndex) drawn++, 0);
+		}
+#endif
+	}
+}
+
+#endif //LIBND4J_PHILOX_H
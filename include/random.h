@@ -0,0 +1,214 @@
+/*
+ * random.h
+ *
+ * Random fills and dropout driven by the counter based generator
+ * in philox.h.
+ */
+
+#ifndef LIBND4J_RANDOM_H
+#define LIBND4J_RANDOM_H
+
+#include <dll.h>
+#include <shape.h>
+#include <omp.h>
+#include <pairwise_util.h>
+#include <ops.h>
+#include <op_boilerplate.h>
+#include <philox.h>
+
+#ifdef __JNI__
+#include <jni.h>
+#endif
+
+#define RANDOM_OPS \
+        (0, simdOps::UniformDistribution), \
+        (1, simdOps::GaussianDistribution), \
+        (2, simdOps::TruncatedNormalDistribution), \
+        (3, simdOps::BernoulliDistribution), \
+        (4, simdOps::BinomialDistribution), \
+        (5, simdOps::RandomDropOut), \
+        (6, simdOps::RandomDropOutInverted)
+
+/**
+ * Elements a random op fills at once
+ */
+#define ND4J_RANDOM_TILE 1024
+
+namespace functions {
+	namespace random {
+
+		template<typename T>
+		class RandomFunction {
+		public:
+
+			static void exec(const int opNum,
+				Nd4jIndex seed,
+				Nd4jIndex offset,
+				T *x,
+				int *xShapeInfo,
+				T *result,
+				int *resultShapeInfo,
+				T *extraParams) {
+                            DISPATCH_BY_OPNUM(exec, PARAMS(seed, offset, x, xShapeInfo, result, resultShapeInfo, extraParams), RANDOM_OPS);
+			}
+
+			/**
+			 * Fills result with op(x[i], i), where i is the position of the
+			 * element in c order and every op draws its numbers for element i
+			 * from position offset + i of the stream keyed by seed (normals
+			 * from the block shared by the lanes around that position).
+			 * Elements go through the op in tiles of ND4J_RANDOM_TILE.
+			 *
+			 * The numbers only depend on seed, offset and the shape, not on
+			 * the number of threads or the order of the arrays, so results
+			 * are reproducible. A caller continuing a stream passes the
+			 * previous offset plus the previous length.
+			 *
+			 * Distribution ops ignore x, which may be null. DropOut ops
+			 * read it, it has to have the shape of result (x and result may
+			 * be the same buffer).
+			 *
+			 * @param seed the seed of the stream
+			 * @param offset the counter of the first element
+			 * @param x the input, null for the distribution ops
+			 * @param xShapeInfo the shape information for the input
+			 * @param result the result buffer
+			 * @param resultShapeInfo the shape information for the result
+			 * @param extraParams the parameters of the distribution
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void exec(Nd4jIndex seed,
+				Nd4jIndex offset,
+				T *x,
+				int *xShapeInfo,
+				T *result,
+				int *resultShapeInfo,
+				T *extraParams) {
+				const Nd4jIndex length = shape::length(resultShapeInfo);
+				if (length < 1)
+					return;
+
+				if (x != nullptr && shape::length(xShapeInfo) != length) {
+					printf("Random: x and result need the same length\n");
+					return;
+				}
+
+				nd4j::random::RandomGenerator generator(seed, offset);
+				nd4j::random::RandomGenerator *rng = &generator;
+
+				/*
+				 * Each array is walked in the c order of its own shape:
+				 * c strides are the first operand of its iterator and the
+				 * array's strides the second. Linear c ordered arrays skip
+				 * the iterator.
+				 */
+				const bool xLinear = x == nullptr || (shape::order(xShapeInfo) == 'c' && shape::elementWiseStride(xShapeInfo) > 0);
+				const bool resultLinear = shape::order(resultShapeInfo) == 'c' && shape::elementWiseStride(resultShapeInfo) > 0;
+				const int xStride = x == nullptr ? 0 : shape::elementWiseStride(xShapeInfo);
+				const int resultStride = shape::elementWiseStride(resultShapeInfo);
+
+				int xPositions[MAX_RANK];
+				int resultPositions[MAX_RANK];
+				int *xWalkerShapeInfo = xLinear ? resultShapeInfo : xShapeInfo;
+				cStrides(xWalkerShapeInfo, xPositions);
+				cStrides(resultShapeInfo, resultPositions);
+				StridedIterator xWalker(shape::rank(xWalkerShapeInfo), shape::shapeOf(xWalkerShapeInfo), xPositions, shape::stride(xWalkerShapeInfo));
+				StridedIterator resultWalker(shape::rank(resultShapeInfo), shape::shapeOf(resultShapeInfo), resultPositions, shape::stride(resultShapeInfo));
+
+				const Nd4jIndex numTiles = (length + ND4J_RANDOM_TILE - 1) / ND4J_RANDOM_TILE;
+
+#pragma omp parallel if (length > 2048)
+				{
+					T tile[ND4J_RANDOM_TILE];
+
+#pragma omp for schedule(static)
+					for (Nd4jIndex t = 0; t < numTiles; t++) {
+						const Nd4jIndex start = t * ND4J_RANDOM_TILE;
+						const int n = (int) (start + ND4J_RANDOM_TILE < length ? ND4J_RANDOM_TILE : length - start);
+
+						if (x == nullptr) {
+							for (int e = 0; e < n; e++)
+								tile[e] = (T) 0.0;
+						}
+						else if (xLinear) {
+							T *in = x + start * xStride;
+#pragma omp simd
+							for (int e = 0; e < n; e++)
+								tile[e] = in[e * xStride];
+						}
+						else {
+							copyRange<true>(x, xWalker, start, n, tile);
+						}
+
+						OpType::fill(tile, start, n, rng, extraParams);
+
+						if (resultLinear) {
+							T *out = result + start * resultStride;
+#pragma omp simd
+							for (int e = 0; e < n; e++)
+								out[e * resultStride] = tile[e];
+						}
+						else {
+							copyRange<false>(result, resultWalker, start, n, tile);
+						}
+					}
+				}
+			}
+
+		private:
+			/**
+			 * The strides of a c ordered array of the shape of shapeInfo
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void cStrides(int *shapeInfo, int *strides) {
+				const int rank = shape::rank(shapeInfo);
+				int *shape = shape::shapeOf(shapeInfo);
+				int stride = 1;
+				for (int d = rank - 1; d >= 0; d--) {
+					strides[d] = stride;
+					stride *= shape[d];
+				}
+			}
+
+			/**
+			 * Copies elements [start, start + n) (in c order) between x,
+			 * the second operand of walker, and tile: into the tile when
+			 * toTile is set and out of it otherwise
+			 */
+			template<bool toTile>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void copyRange(T *x, const StridedIterator &walker, Nd4jIndex start, int n, T *tile) {
+				StridedIterator iter = walker;
+				const Nd4jIndex innerLength = iter.innerLength();
+				const int innerStride = iter.innerStride(1);
+				Nd4jIndex first = start % innerLength;
+				iter.seek(start / innerLength);
+
+				for (int done = 0; done < n; iter.next()) {
+					T *run = x + iter.offsets[1];
+					int count = (int) (innerLength - first < n - done ? innerLength - first : n - done);
+					if (toTile) {
+						for (int i = 0; i < count; i++)
+							tile[done + i] = run[(first + i) * innerStride];
+					}
+					else {
+						for (int i = 0; i < count; i++)
+							run[(first + i) * innerStride] = tile[done + i];
+					}
+
+					done += count;
+					first = 0;
+				}
+			}
+		};
+	}
+}
+
+#endif //LIBND4J_RANDOM_H
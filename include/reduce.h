@@ -2,6 +2,7 @@
 //#include <string>
 #include <sharedmem.h>
 #include <stdio.h>
+#include <algorithm>
 #include <shape.h>
 #include <omp.h>
 #include <templatemath.h>
@@ -10,6 +11,10 @@
 #include <pairwise_util.h>
 #include <ops.h>
 #include <op_boilerplate.h>
+#include <deterministic.h>
+#include <isa_dispatch.h>
+#include <mask.h>
+#include <vector>
 
 #pragma once
 #ifdef __CUDACC__
@@ -21,6 +26,27 @@
 #endif
 
 
+#ifdef __CUDACC__
+/**
+ * Order statistics (13 Median, 14 Quantile) are cpu only, they need a
+ * scratch copy of every tad the cuda kernels don't have. Asking cuda
+ * for them is reported as an unknown op rather than giving wrong results.
+ */
+#define REDUCE_OPS \
+        (0, simdOps::Mean), \
+        (1, simdOps::Sum), \
+        (3, simdOps::Max), \
+        (4, simdOps::Min), \
+        (5, simdOps::Norm1), \
+        (6, simdOps::Norm2), \
+        (7, simdOps::NormMax), \
+        (8, simdOps::Prod), \
+        (9, simdOps::StandardDeviation), \
+        (10,simdOps::Variance), \
+		(11, simdOps::ASum), \
+        (12, simdOps::MatchCondition), \
+        (15, simdOps::LogSumExp)
+#else
 #define REDUCE_OPS \
         (0, simdOps::Mean), \
         (1, simdOps::Sum), \
@@ -33,13 +59,145 @@
         (9, simdOps::StandardDeviation), \
         (10,simdOps::Variance), \
 		(11, simdOps::ASum), \
-        (12, simdOps::MatchCondition)
+        (12, simdOps::MatchCondition), \
+        (13, simdOps::Median), \
+        (14, simdOps::Quantile), \
+        (15, simdOps::LogSumExp)
+#endif
 
         
 //an op for the kernel
 namespace functions {
     namespace reduce {
 
+/**
+ * Ops computed from the mean and the second central moment.
+ * These are reduced in a single pass (see ReduceFunction::moments)
+ * instead of the mean being computed up front by the caller.
+ */
+		template<typename OpType>
+		struct IsMomentsOp {
+			static const bool value = false;
+		};
+
+		template<typename T> struct IsMomentsOp<simdOps::Variance<T> > { static const bool value = true; };
+		template<typename T> struct IsMomentsOp<simdOps::StandardDeviation<T> > { static const bool value = true; };
+
+/**
+ * Result of a reduction over no elements (empty segments): the op's
+ * starting value, which is the identity of its update (0 for sums,
+ * means and moments, 1 for Prod, -MAX_FLOAT for LogSumExp), and
+ * -MAX_FLOAT / MAX_FLOAT for Max / Min, whose starting value is the
+ * first element
+ */
+		template<typename OpType>
+		struct EmptyReduction {
+			template<typename T>
+			static inline T value() {
+				T zero = (T) 0.0;
+				return OpType::startingValue(&zero);
+			}
+		};
+
+		template<typename T> struct EmptyReduction<simdOps::Max<T> > {
+			template<typename X>
+			static inline X value() { return (X) -MAX_FLOAT; }
+		};
+
+		template<typename T> struct EmptyReduction<simdOps::Min<T> > {
+			template<typename X>
+			static inline X value() { return (X) MAX_FLOAT; }
+		};
+
+/**
+ * Order statistics of at least this many elements are selected
+ * by all threads together (see ReduceFunction::selectRanks)
+ */
+#define ND4J_PARALLEL_SELECT 65536
+
+/**
+ * Order statistics, computed by introselect on a scratch copy
+ * of every tad rather than by op/update (see ReduceFunction::selectQuantile)
+ */
+		template<typename OpType>
+		struct IsOrderStatistic {
+			static const bool value = false;
+
+			template<typename T>
+			static inline T quantile(T *extraParams) {
+				return (T) 0.5;
+			}
+		};
+
+		template<typename T>
+		struct IsOrderStatistic<simdOps::Median<T> > {
+			static const bool value = true;
+
+			static inline T quantile(T *extraParams) {
+				return (T) 0.5;
+			}
+		};
+
+		template<typename T>
+		struct IsOrderStatistic<simdOps::Quantile<T> > {
+			static const bool value = true;
+
+			static inline T quantile(T *extraParams) {
+				return extraParams[0];
+			}
+		};
+
+/**
+ * Log-sum-exp, contiguous data is reduced in blocks with a
+ * single exp per element (see ReduceFunction::logSumExp)
+ */
+		template<typename OpType>
+		struct IsLogSumExp {
+			static const bool value = false;
+		};
+
+		template<typename T> struct IsLogSumExp<simdOps::LogSumExp<T> > { static const bool value = true; };
+
+/**
+ * Op number of a ReductionState that keeps count, mean, variance,
+ * min and max of everything accumulated at once
+ */
+#define ND4J_SUMMARY_STATE -1
+
+/**
+ * Partial result of a reduction over data that arrives in chunks.
+ * Chunks are folded in with ReduceFunction::accumulateState, states
+ * built from different parts of the data with the same op can be
+ * combined with mergeState and finalizeState applies the op's post
+ * processing. Summary states (ND4J_SUMMARY_STATE) are finalized
+ * with finalizeSummary instead.
+ */
+		template<typename T>
+		class ReductionState {
+		public:
+			int opNum;
+			// number of elements accumulated so far
+			Nd4jIndex n;
+			// accumulated value before postProcess, all but the moments ops
+			T value;
+			// running mean and second central moment, moments ops and summaries
+			T mean;
+			T M2;
+			// extremes, summaries only
+			T min;
+			T max;
+
+			ReductionState(int opNum) {
+				this->opNum = opNum;
+				n = 0;
+				value = (T) 0.0;
+				mean = (T) 0.0;
+				M2 = (T) 0.0;
+				min = (T) 0.0;
+				max = (T) 0.0;
+			}
+		};
+
 /**
  * A reduce function
  * reduces a vector down to
@@ -423,6 +581,64 @@ template<typename OpType>
                             DISPATCH_BY_OPNUM(exec, PARAMS(x, xShapeInfo, extraParams, result, resultShapeInfoBuffer, dimension, dimensionLength, tadShapeInfo, tadOffset), REDUCE_OPS);
 			}
 
+			static void execSegmented(const int opNum,
+				T *x,
+				int xElementWiseStride,
+				Nd4jIndex *segmentOffsets,
+				int numSegments,
+				T *extraParams,
+				T *result) {
+                            DISPATCH_BY_OPNUM(execSegmented, PARAMS(x, xElementWiseStride, segmentOffsets, numSegments, extraParams, result), REDUCE_OPS);
+			}
+
+			static void accumulateState(ReductionState<T> *state, T *x, int *xShapeInfo, T *extraParams) {
+				const int opNum = state->opNum;
+				if (opNum == ND4J_SUMMARY_STATE) {
+					accumulateSummary(state, x, xShapeInfo);
+					return;
+				}
+
+                            DISPATCH_BY_OPNUM(accumulateState, PARAMS(state, x, xShapeInfo, extraParams), REDUCE_OPS);
+			}
+
+			static void mergeState(ReductionState<T> *state, ReductionState<T> *other, T *extraParams) {
+				const int opNum = state->opNum;
+				if (other->opNum != opNum) {
+					printf("Reduction states of ops [%d] and [%d] can't be merged\n", opNum, other->opNum);
+					return;
+				}
+
+				if (opNum == ND4J_SUMMARY_STATE) {
+					mergeSummary(state, other);
+					return;
+				}
+
+                            DISPATCH_BY_OPNUM(mergeState, PARAMS(state, other, extraParams), REDUCE_OPS);
+			}
+
+			static T finalizeState(ReductionState<T> *state, T *extraParams) {
+				const int opNum = state->opNum;
+				if (opNum == ND4J_SUMMARY_STATE) {
+					printf("Summary states are finalized with finalizeSummary\n");
+					return (T) 0.0;
+				}
+
+                            RETURNING_DISPATCH_BY_OPNUM(finalizeState, PARAMS(state, extraParams), REDUCE_OPS);
+			}
+
+			static void execMasked(const int opNum,
+				T *x,
+				int *xShapeInfo,
+				T *mask,
+				int *maskShapeInfo,
+				T *condition,
+				T *extraParams,
+				T *result,
+				int *dimension,
+				int dimensionLength, int *tadShapeInfo, int *tadOffsets) {
+                            DISPATCH_BY_OPNUM(execMasked, PARAMS(x, xShapeInfo, mask, maskShapeInfo, condition, extraParams, result, dimension, dimensionLength, tadShapeInfo, tadOffsets), REDUCE_OPS);
+			}
+
 			/**
 			 * Reduce down to 1 number
 			 * @param x the input
@@ -435,12 +651,29 @@ template<typename OpType>
 #ifdef __CUDACC__
 			__host__
 #endif
+			ND4J_ISA_DISPATCH
 			static T execScalar(T *x, int *xShapeInfo, T *extraParams) {
 				const Nd4jIndex length = shape::length(xShapeInfo);
 				int xElementWiseStride = shape::elementWiseStride(xShapeInfo);
 				if (xElementWiseStride >= 1) {
 					return execScalar<OpType>(x, xElementWiseStride, length, extraParams);
 				}
+				else if (IsOrderStatistic<OpType>::value) {
+					StridedIterator iter(shape::rank(xShapeInfo), shape::shapeOf(xShapeInfo), shape::stride(xShapeInfo));
+					T *scratch = new T[length];
+					gather(x, iter, scratch);
+					T ret = selectQuantile<OpType>(scratch, length, extraParams);
+					delete[] scratch;
+					return ret;
+				}
+				else if (IsMomentsOp<OpType>::value) {
+					StridedIterator iter(shape::rank(xShapeInfo), shape::shapeOf(xShapeInfo), shape::stride(xShapeInfo));
+					Nd4jIndex n = 0;
+					T mean = (T) 0.0;
+					T M2 = (T) 0.0;
+					tadMoments(x, iter, 1, nullptr, &n, &mean, &M2);
+					return momentsToValue<OpType>(n, mean, M2);
+				}
 				else {
 					int shapeIter[MAX_RANK];
 					int coord[MAX_RANK];
@@ -501,6 +734,7 @@ template<typename OpType>
 #ifdef __CUDACC__
 			__host__
 #endif
+			ND4J_ISA_DISPATCH
 			static void exec(T *x,
 				int *xShapeInfo,
 				T *extraParams,
@@ -545,48 +779,226 @@ template<typename OpType>
 				int numTads = shape::length(xShapeInfo) / tadLength;
 				int tadEWS = shape::elementWiseStride(tadOnlyShapeInfo);
 
-				if (tadEWS > 0 && (numTads == 1 || shape::isVector(tadOnlyShapeInfo) || shape::isScalar(tadOnlyShapeInfo))) {
+				const bool useEWS = tadEWS > 0 && (numTads == 1 || shape::isVector(tadOnlyShapeInfo) || shape::isScalar(tadOnlyShapeInfo));
+
+				/**
+				 * Few, long tads: either split every tad between the threads,
+				 * or for the fixed block kernels (EWS moments, deterministic
+				 * mode), which parallelize within a tad themselves, walk tads
+				 * one by one. Non-EWS moments are chunked by tadMoments.
+				 */
+				TadBlockInformation info(numTads, tadLength);
+				const bool parallelTads = !info.isSplit();
+
+				if (IsOrderStatistic<OpType>::value) {
+					StridedIterator tadIter(tadRank, shape::shapeOf(tadOnlyShapeInfo), shape::stride(tadOnlyShapeInfo));
+					const int threads = omp_get_max_threads();
+
+					if (resultLength < threads && tadLength >= ND4J_PARALLEL_SELECT) {
+						// few long tads: every tad is gathered and selected by all threads
+						T *scratch = new T[tadLength];
+						for (int i = 0; i < resultLength; i++) {
+							T *tadStart = x + tadOffsets[i];
+							if (useEWS) {
+#pragma omp parallel for simd schedule(static)
+								for (int j = 0; j < tadLength; j++)
+									scratch[j] = tadStart[j * tadEWS];
+							}
+							else {
+								gather(tadStart, tadIter, scratch);
+							}
+
+							result[i] = selectQuantile<OpType>(scratch, tadLength, extraParams);
+						}
 
-#pragma omp parallel for if (resultLength > 16 && tadLength > 16)
-					for (int i = 0; i < resultLength; i++) {
-						T *iter = x + tadOffsets[i];
-						T start = OpType::startingValue(iter);
-						if (tadEWS == 1) {
+						delete[] scratch;
+					}
+					else {
+						// one scratch tad per thread, so no more threads than tads
+#pragma omp parallel num_threads(resultLength < threads ? resultLength : threads) if (resultLength > 1 && tadLength > 16)
+						{
+							T *scratch = new T[tadLength];
 
+#pragma omp for schedule(guided)
+							for (int i = 0; i < resultLength; i++) {
+								T *tadStart = x + tadOffsets[i];
+								if (useEWS) {
 #pragma omp simd
-							for (int j = 0; j < tadLength; j++) {
-								start = OpType::update(start, OpType::op(iter[j], extraParams), extraParams);
+									for (int j = 0; j < tadLength; j++)
+										scratch[j] = tadStart[j * tadEWS];
+								}
+								else {
+									gather(tadStart, tadIter, scratch);
+								}
 
+								result[i] = selectQuantile<OpType>(scratch, tadLength, extraParams);
 							}
+
+							delete[] scratch;
 						}
-						else {
+					}
+
+					if (tad != nullptr)
+						delete tad;
+
+					return;
+				}
+
+				if (IsMomentsOp<OpType>::value) {
+					if (useEWS) {
+#pragma omp parallel for schedule(guided) if (parallelTads && resultLength > 16 && tadLength > 16)
+						for (int i = 0; i < resultLength; i++) {
+							T mean = (T) 0.0;
+							T M2 = (T) 0.0;
+							moments(x + tadOffsets[i], tadEWS, tadLength, mean, M2);
+							result[i] = momentsToValue<OpType>(tadLength, mean, M2);
+						}
+					}
+					else {
+						StridedIterator tadIter(tadRank, shape::shapeOf(tadOnlyShapeInfo), shape::stride(tadOnlyShapeInfo));
+						Nd4jIndex *counts = new Nd4jIndex[resultLength];
+						T *means = new T[resultLength];
+						T *m2s = new T[resultLength];
+						tadMoments(x, tadIter, resultLength, tadOffsets, counts, means, m2s);
+
+						for (int i = 0; i < resultLength; i++)
+							result[i] = momentsToValue<OpType>(counts[i], means[i], m2s[i]);
+
+						delete[] counts;
+						delete[] means;
+						delete[] m2s;
+					}
+
+					if (tad != nullptr)
+						delete tad;
+
+					return;
+				}
+
+				if (IsLogSumExp<OpType>::value && useEWS) {
+#pragma omp parallel for schedule(guided) if (parallelTads && resultLength > 16 && tadLength > 16)
+					for (int i = 0; i < resultLength; i++)
+						result[i] = OpType::postProcess(logSumExp<OpType>(x + tadOffsets[i], tadEWS, tadLength, extraParams), tadLength, extraParams);
+
+					if (tad != nullptr)
+						delete tad;
+
+					return;
+				}
+
+				if (useEWS) {
+
+					if (nd4j::reduction::isDeterministic()) {
+#pragma omp parallel for if (parallelTads && resultLength > 16 && tadLength > 16)
+						for (int i = 0; i < resultLength; i++) {
+							T start = nd4j::reduction::execScalar<T, OpType>(x + tadOffsets[i], tadEWS, tadLength, extraParams);
+							result[i] = OpType::postProcess(start, tadLength, extraParams);
+						}
+					}
+					else if (info.isSplit()) {
+						T *partials = new T[info.numChunks()];
+
+#pragma omp parallel for schedule(static)
+						for (Nd4jIndex c = 0; c < info.numChunks(); c++) {
+							T *iter = x + tadOffsets[c / info.chunksPerTad];
+							int chunk = (int) (c % info.chunksPerTad);
+							Nd4jIndex chunkEnd = info.chunkEnd(chunk);
+							T start = OpType::startingValue(iter);
+
 #pragma omp simd
-							for (int j = 0; j < tadLength; j++) {
+							for (Nd4jIndex j = info.chunkStart(chunk); j < chunkEnd; j++) {
 								start = OpType::update(start, OpType::op(iter[j * tadEWS], extraParams), extraParams);
 							}
+
+							partials[c] = start;
+						}
+
+						mergeChunks<OpType>(partials, info, result, tadLength, extraParams);
+						delete[] partials;
+					}
+					else {
+#pragma omp parallel for if (resultLength > 16 && tadLength > 16)
+						for (int i = 0; i < resultLength; i++) {
+							T *iter = x + tadOffsets[i];
+							T start = OpType::startingValue(iter);
+							if (tadEWS == 1) {
+
+#pragma omp simd
+								for (int j = 0; j < tadLength; j++) {
+									start = OpType::update(start, OpType::op(iter[j], extraParams), extraParams);
+
+								}
+							}
+							else {
+#pragma omp simd
+								for (int j = 0; j < tadLength; j++) {
+									start = OpType::update(start, OpType::op(iter[j * tadEWS], extraParams), extraParams);
+								}
+							}
+							result[i] = OpType::postProcess(start, tadLength, extraParams);
 						}
-						result[i] = OpType::postProcess(start, tadLength, extraParams);
 					}
 				}
 				else {
 					int *tadShape = shape::shapeOf(tadOnlyShapeInfo);
 					int *tadStride = shape::stride(tadOnlyShapeInfo);
 
-#pragma omp  parallel for schedule(guided) if (resultLength > 16 && tadLength > 16)
-					for (int i = 0; i < resultLength; i++) {
-						int offset = tadOffsets[i];
-						int xCoord[MAX_RANK];
+					// all tads share shape and strides, so the coalesced iterator is prepared once
+					StridedIterator tadIter(tadRank, tadShape, tadStride);
+					const Nd4jIndex innerLength = tadIter.innerLength();
+					const int innerStride = tadIter.innerStride(0);
 
-						T start = OpType::startingValue(x + offset);
+					// non-EWS tads are split on whole innermost runs
+					TadBlockInformation runInfo(numTads, tadIter.outerLength(), 8192 / innerLength);
+
+					if (nd4j::reduction::isDeterministic()) {
+						deterministicTads<OpType>(x, tadIter, tadOffsets, resultLength, tadLength, result, extraParams);
+					}
+					else if (runInfo.isSplit()) {
+						T *partials = new T[runInfo.numChunks()];
+
+#pragma omp parallel for schedule(static)
+						for (Nd4jIndex c = 0; c < runInfo.numChunks(); c++) {
+							T *tadStart = x + tadOffsets[c / runInfo.chunksPerTad];
+							int chunk = (int) (c % runInfo.chunksPerTad);
+							StridedIterator iter = tadIter;
+							iter.seek(runInfo.chunkStart(chunk));
+
+							T start = OpType::startingValue(tadStart);
+							for (Nd4jIndex run = runInfo.chunkStart(chunk); run < runInfo.chunkEnd(chunk); run++) {
+								T *xIter = tadStart + iter.offsets[0];
+#pragma omp simd
+								for (Nd4jIndex j = 0; j < innerLength; j++) {
+									start = OpType::update(start, OpType::op(xIter[j * innerStride], extraParams), extraParams);
+								}
 
-						for (int j = 0; j < tadLength; j++) {
-							shape::ind2subC(tadRank, tadShape, j, xCoord);
-							int xOffset = shape::getOffset(offset, tadShape, tadStride, xCoord, tadRank);
+								iter.next();
+							}
 
-							start = OpType::update(start, OpType::op(x[xOffset], extraParams), extraParams);
+							partials[c] = start;
 						}
 
-						result[i] = OpType::postProcess(start, tadLength, extraParams);;
+						mergeChunks<OpType>(partials, runInfo, result, tadLength, extraParams);
+						delete[] partials;
+					}
+					else {
+#pragma omp  parallel for schedule(guided) if (resultLength > 16 && tadLength > 16)
+						for (int i = 0; i < resultLength; i++) {
+							T *tadStart = x + tadOffsets[i];
+							StridedIterator iter = tadIter;
+
+							T start = OpType::startingValue(tadStart);
+
+							do {
+								T *xIter = tadStart + iter.offsets[0];
+#pragma omp simd
+								for (Nd4jIndex j = 0; j < innerLength; j++) {
+									start = OpType::update(start, OpType::op(xIter[j * innerStride], extraParams), extraParams);
+								}
+							} while (iter.next());
+
+							result[i] = OpType::postProcess(start, tadLength, extraParams);
+						}
 					}
 				}
 
@@ -594,6 +1006,64 @@ template<typename OpType>
 					delete tad;
 			}
 
+			/**
+			 * Non-EWS tads in deterministic mode: every tad is reduced by
+			 * one thread in iteration order with plain (optionally
+			 * compensated) loops. It is kept out of the ISA dispatched
+			 * exec, so the rounding is the same on every machine.
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			ND4J_ISA_INVARIANT
+			static void deterministicTads(T *x, const StridedIterator &tadIter, int *tadOffsets, int numTads, Nd4jIndex tadLength, T *result, T *extraParams) {
+				const Nd4jIndex innerLength = tadIter.innerLength();
+				const int innerStride = tadIter.innerStride(0);
+				const bool compensated = nd4j::reduction::IsSummation<OpType>::value && nd4j::reduction::isCompensated();
+
+#pragma omp parallel for schedule(guided) if (numTads > 16 && tadLength > 16)
+				for (int i = 0; i < numTads; i++) {
+					T *tadStart = x + tadOffsets[i];
+					StridedIterator iter = tadIter;
+					T start = OpType::startingValue(tadStart);
+					T compensation = (T) 0.0;
+
+					do {
+						T *xIter = tadStart + iter.offsets[0];
+						if (compensated) {
+							for (Nd4jIndex j = 0; j < innerLength; j++)
+								nd4j::reduction::compensatedAdd<T>(start, compensation, OpType::op(xIter[j * innerStride], extraParams));
+						}
+						else {
+							for (Nd4jIndex j = 0; j < innerLength; j++)
+								start = OpType::update(start, OpType::op(xIter[j * innerStride], extraParams), extraParams);
+						}
+					} while (iter.next());
+
+					result[i] = OpType::postProcess(start + compensation, tadLength, extraParams);
+				}
+			}
+
+			/**
+			 * Merges per chunk partials of a split tad reduction
+			 * (see TadBlockInformation) in chunk order and post processes them
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void mergeChunks(T *partials, TadBlockInformation &info, T *result, Nd4jIndex tadLength, T *extraParams) {
+#pragma omp parallel for if (info.numTads > 16)
+				for (Nd4jIndex i = 0; i < info.numTads; i++) {
+					T start = partials[i * info.chunksPerTad];
+					for (int c = 1; c < info.chunksPerTad; c++)
+						start = OpType::update(start, partials[i * info.chunksPerTad + c], extraParams);
+
+					result[i] = OpType::postProcess(start, tadLength, extraParams);
+				}
+			}
+
 
 
 
@@ -619,84 +1089,473 @@ template<typename OpType>
 				return execScalar<OpType>(x, xShapeInfo, extraParams);
 			}
 
-
-
 			/**
-			* Reduce down to 1 number
-			* @param x the input
-			* @param xShapeInfo the shape information
-			* for the input
-			* @param extraParams the extra params
-			* @return
-			*/
+			 * Folds x into state.
+			 *
+			 * Plain ops keep their accumulated value before postProcess,
+			 * every chunk is reduced in fixed size blocks (see deterministic.h)
+			 * and combined with the state via update. Moments ops keep the
+			 * exact running mean and M2 and merge chunks with Chan's formula.
+			 */
 			template<typename OpType>
 #ifdef __CUDACC__
 			__host__
 #endif
-			static T execScalar(const T *x, int xElementWiseStride, Nd4jIndex length, T *extraParams) {
-				T startingVal = OpType::startingValue(x);
-				if (xElementWiseStride == 1) {
-					if (length < 8000) {
-						T local = OpType::startingValue(x);
-#pragma omp simd
-						for (Nd4jIndex i = 0; i < length; i++) {
-							T curr = OpType::op(x[i], extraParams);
-							local = OpType::update(local, curr, extraParams);
+			static void accumulateState(ReductionState<T> *state, T *x, int *xShapeInfo, T *extraParams) {
+				const Nd4jIndex length = shape::length(xShapeInfo);
+				if (length < 1)
+					return;
 
-						}
-						local = OpType::postProcess(local, length, extraParams);
+				if (IsOrderStatistic<OpType>::value) {
+					printf("Order statistics can't be accumulated in chunks\n");
+					return;
+				}
 
-						return local;
+				int xElementWiseStride = shape::elementWiseStride(xShapeInfo);
+				if (IsMomentsOp<OpType>::value) {
+					Nd4jIndex n = 0;
+					T mean = (T) 0.0;
+					T M2 = (T) 0.0;
+					if (xElementWiseStride >= 1) {
+						moments(x, xElementWiseStride, length, mean, M2);
+						n = length;
 					}
-
 					else {
-						T finalVal = startingVal;
-						BlockInformation info(length);
-						T *blocks = new T[info.chunks];
-#pragma omp parallel
-						{
-							T local = OpType::startingValue(x);
-							for (int i = omp_get_thread_num(); i < info.chunks; i += info.threads) {
-								Nd4jIndex newOffset = (i * info.items);
-								const T *chunk = x + newOffset;
-								Nd4jIndex itemsToLoop = info.items;
-								if (newOffset >= length) {
-									break;
-								}
-
-								//handle modulo case
-								if (newOffset + info.items >= length) {
-									itemsToLoop = length - newOffset;
-								}
-#pragma omp simd
-								for (Nd4jIndex j = 0; j < itemsToLoop; j++) {
-									T curr = OpType::op(chunk[j], extraParams);
-									local = OpType::update(local, curr, extraParams);
-								}
-
-							}
-
-							blocks[omp_get_thread_num()] = local;
-						}
-
-#pragma omp simd
-						for (int i = 0; i < info.threads; i++) {
-							finalVal = OpType::update(finalVal, blocks[i], extraParams);
-						}
-
-
-						finalVal = OpType::postProcess(finalVal, length, extraParams);
-						delete[] blocks;
-						return finalVal;
-
+						StridedIterator iter(shape::rank(xShapeInfo), shape::shapeOf(xShapeInfo), shape::stride(xShapeInfo));
+						tadMoments(x, iter, 1, nullptr, &n, &mean, &M2);
 					}
 
+					mergeMoments(state->n, state->mean, state->M2, n, mean, M2);
+					return;
 				}
 
+				T value;
+				if (xElementWiseStride >= 1) {
+					value = nd4j::reduction::execScalar<T, OpType>(x, xElementWiseStride, length, extraParams);
+				}
 				else {
-					if (length < 8000) {
-						T local = OpType::startingValue(x);
-#pragma omp simd
+					StridedIterator iter(shape::rank(xShapeInfo), shape::shapeOf(xShapeInfo), shape::stride(xShapeInfo));
+					const Nd4jIndex innerLength = iter.innerLength();
+					const int innerStride = iter.innerStride(0);
+					value = OpType::startingValue(x);
+					do {
+						T *xIter = x + iter.offsets[0];
+						for (Nd4jIndex i = 0; i < innerLength; i++)
+							value = OpType::update(value, OpType::op(xIter[i * innerStride], extraParams), extraParams);
+					} while (iter.next());
+				}
+
+				state->value = state->n == 0 ? value : OpType::update(state->value, value, extraParams);
+				state->n += length;
+			}
+
+			/**
+			 * Merges other into state, other is left untouched
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void mergeState(ReductionState<T> *state, ReductionState<T> *other, T *extraParams) {
+				if (other->n == 0)
+					return;
+
+				if (IsMomentsOp<OpType>::value) {
+					mergeMoments(state->n, state->mean, state->M2, other->n, other->mean, other->M2);
+					return;
+				}
+
+				state->value = state->n == 0 ? other->value : OpType::update(state->value, other->value, extraParams);
+				state->n += other->n;
+			}
+
+			/**
+			 * The reduction of everything accumulated into state,
+			 * as execScalar would have returned it for the concatenated
+			 * data (up to rounding). An empty state finalizes to 0.
+			 * Moments ops finalize from the state's running mean, only
+			 * the other ops' postProcess reads extraParams.
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static T finalizeState(ReductionState<T> *state, T *extraParams) {
+				if (state->n == 0)
+					return (T) 0.0;
+
+				if (IsMomentsOp<OpType>::value)
+					return momentsToValue<OpType>(state->n, state->mean, state->M2);
+
+				return OpType::postProcess(state->value, state->n, extraParams);
+			}
+
+			/**
+			 * Folds x into a summary state: the moments are taken like
+			 * Variance does, with min and max in the same sweep
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void accumulateSummary(ReductionState<T> *state, T *x, int *xShapeInfo) {
+				const Nd4jIndex length = shape::length(xShapeInfo);
+				if (length < 1)
+					return;
+
+				ReductionState<T> chunk(ND4J_SUMMARY_STATE);
+				int xElementWiseStride = shape::elementWiseStride(xShapeInfo);
+				if (xElementWiseStride >= 1) {
+					moments(x, xElementWiseStride, length, chunk.mean, chunk.M2, &chunk.min, &chunk.max);
+					chunk.n = length;
+				}
+				else {
+					StridedIterator iter(shape::rank(xShapeInfo), shape::shapeOf(xShapeInfo), shape::stride(xShapeInfo));
+					tadMoments(x, iter, 1, nullptr, &chunk.n, &chunk.mean, &chunk.M2, &chunk.min, &chunk.max);
+				}
+
+				mergeSummary(state, &chunk);
+			}
+
+			/**
+			 * Merges summary state other into state, other is left untouched
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void mergeSummary(ReductionState<T> *state, ReductionState<T> *other) {
+				if (other->n == 0)
+					return;
+
+				if (state->n == 0) {
+					state->min = other->min;
+					state->max = other->max;
+				}
+				else {
+					state->min = nd4j::math::nd4j_min<T>(state->min, other->min);
+					state->max = nd4j::math::nd4j_max<T>(state->max, other->max);
+				}
+
+				mergeMoments(state->n, state->mean, state->M2, other->n, other->mean, other->M2);
+			}
+
+			/**
+			 * Writes {count, mean, variance, min, max} of everything
+			 * accumulated into a summary state to result. The variance is
+			 * bias corrected like the Variance op's, an empty state gives zeros.
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void finalizeSummary(ReductionState<T> *state, T *result) {
+				if (state->opNum != ND4J_SUMMARY_STATE) {
+					printf("Only summary states can be finalized with finalizeSummary\n");
+					return;
+				}
+
+				result[0] = (T) state->n;
+				result[1] = state->n > 0 ? state->mean : (T) 0.0;
+				result[2] = state->n > 1 ? state->M2 / (T) (state->n - 1) : (T) 0.0;
+				result[3] = state->n > 0 ? state->min : (T) 0.0;
+				result[4] = state->n > 0 ? state->max : (T) 0.0;
+			}
+
+			/**
+			 * Reduces the selected elements of every tad of x in a single
+			 * pass, elements are selected by a mask array or a condition
+			 * (see mask.h). result[i] is the reduction of the selected
+			 * elements of tad i, postProcess is given the number of selected
+			 * elements. A tad without selected elements reduces to
+			 * EmptyReduction<OpType>, like an empty segment of execSegmented.
+			 * Without a mask of x's shape nothing is written.
+			 *
+			 * Chunks of a tad are reduced into ReductionStates and merged
+			 * with mergeState, long tads are split between threads when
+			 * there are fewer tads than threads.
+			 *
+			 * @param x the input
+			 * @param xShapeInfo the shape information for the input
+			 * @param mask optional mask of the same shape as x, non zero entries are reduced
+			 * @param maskShapeInfo the shape information for the mask
+			 * @param condition {compare, eps, mode} as for MatchCondition, used without a mask
+			 * @param extraParams the extra params for the op
+			 * @param result the result buffer, one value per tad
+			 * @param dimension the dimensions to reduce along, null or MAX_DIMENSION for the whole array
+			 * @param dimensionLength the number of dimensions
+			 * @param tadShapeInfo optional precomputed tad shape information for x
+			 * @param tadOffsets optional precomputed tad offsets for x
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void execMasked(T *x,
+				int *xShapeInfo,
+				T *mask,
+				int *maskShapeInfo,
+				T *condition,
+				T *extraParams,
+				T *result,
+				int *dimension,
+				int dimensionLength, int *tadShapeInfo, int *tadOffsets) {
+				if (shape::length(xShapeInfo) < 1)
+					return;
+				if (mask != nullptr && !nd4j::mask::MaskedTads<T>::fits(xShapeInfo, maskShapeInfo))
+					return;
+
+				nd4j::mask::MaskedTads<T> tads(xShapeInfo, mask != nullptr ? maskShapeInfo : nullptr, dimension, dimensionLength, tadShapeInfo, tadOffsets, false);
+
+				if (IsOrderStatistic<OpType>::value) {
+					const int threads = omp_get_max_threads();
+
+#pragma omp parallel num_threads(tads.numTads < threads ? tads.numTads : threads) if (tads.numTads > 1)
+					{
+						T *scratch = new T[tads.tadLength];
+
+#pragma omp for schedule(guided)
+						for (int i = 0; i < tads.numTads; i++) {
+							Nd4jIndex n = 0;
+							auto visitor = [&](T value, Nd4jIndex j) {
+								scratch[n++] = value;
+							};
+							nd4j::mask::forEachSelected(tads, x, mask, condition, i, 0, tads.tadLength, visitor);
+
+							result[i] = n > 0 ? selectQuantile<OpType>(scratch, n, extraParams) : EmptyReduction<OpType>::template value<T>();
+						}
+
+						delete[] scratch;
+					}
+
+					return;
+				}
+
+				TadBlockInformation info(tads.numTads, tads.tadLength);
+				std::vector<ReductionState<T> > partials(info.numChunks(), ReductionState<T>(0));
+
+#pragma omp parallel for schedule(guided) if (info.numChunks() > 1)
+				for (Nd4jIndex c = 0; c < info.numChunks(); c++) {
+					int i = (int) (c / info.chunksPerTad);
+					int chunk = (int) (c % info.chunksPerTad);
+					ReductionState<T> &partial = partials[c];
+
+					if (IsMomentsOp<OpType>::value) {
+						// selected values are gathered into blocks, see iteratorMoments
+						T block[ND4J_MASK_BLOCK];
+						int filled = 0;
+						auto flush = [&]() {
+							T blockMean;
+							T blockM2;
+							blockMoments(block, 1, filled, blockMean, blockM2);
+							mergeMoments(partial.n, partial.mean, partial.M2, filled, blockMean, blockM2);
+							filled = 0;
+						};
+						auto visitor = [&](T value, Nd4jIndex j) {
+							block[filled++] = value;
+							if (filled == ND4J_MASK_BLOCK)
+								flush();
+						};
+						nd4j::mask::forEachSelected(tads, x, mask, condition, i, info.chunkStart(chunk), info.chunkEnd(chunk), visitor);
+						if (filled > 0)
+							flush();
+					}
+					else {
+						// ops like max start from the first element, which has to be a selected one
+						auto visitor = [&](T value, Nd4jIndex j) {
+							if (partial.n == 0)
+								partial.value = OpType::startingValue(&value);
+							partial.value = OpType::update(partial.value, OpType::op(value, extraParams), extraParams);
+							partial.n++;
+						};
+						nd4j::mask::forEachSelected(tads, x, mask, condition, i, info.chunkStart(chunk), info.chunkEnd(chunk), visitor);
+					}
+				}
+
+#pragma omp parallel for schedule(static) if (tads.numTads > 32)
+				for (int i = 0; i < tads.numTads; i++) {
+					ReductionState<T> &state = partials[(Nd4jIndex) i * info.chunksPerTad];
+					for (int c = 1; c < info.chunksPerTad; c++)
+						mergeState<OpType>(&state, &partials[(Nd4jIndex) i * info.chunksPerTad + c], extraParams);
+
+					// a tad with nothing selected reduces like an empty segment
+					result[i] = state.n > 0 ? finalizeState<OpType>(&state, extraParams) : EmptyReduction<OpType>::template value<T>();
+				}
+			}
+
+			/**
+			 * Reduces variable length segments of a buffer in one call.
+			 *
+			 * Segment i covers elements [segmentOffsets[i], segmentOffsets[i + 1])
+			 * of x, so segmentOffsets holds numSegments + 1 entries.
+			 * Every segment is reduced as if execScalar had been called on it,
+			 * the result for segment i is written to result[i]. Empty segments
+			 * (equal offsets) don't read x and get EmptyReduction<OpType>.
+			 * Offsets have to be non negative and non decreasing, otherwise
+			 * nothing is written.
+			 *
+			 * Segments long enough to be split between threads by execScalar
+			 * are reduced one after another, each using all threads. The rest
+			 * are handed out to threads dynamically, longest first, so a few
+			 * long segments can't leave the other threads idle at the end.
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void execSegmented(T *x,
+				int xElementWiseStride,
+				Nd4jIndex *segmentOffsets,
+				int numSegments,
+				T *extraParams,
+				T *result) {
+				// execScalar reduces anything shorter than this on the calling thread
+				const Nd4jIndex serialLength = 8000;
+
+				if (numSegments < 1)
+					return;
+
+				if (segmentOffsets[0] < 0) {
+					printf("Segmented reduce: offsets can't be negative\n");
+					return;
+				}
+
+				for (int i = 0; i < numSegments; i++) {
+					if (segmentOffsets[i + 1] < segmentOffsets[i]) {
+						printf("Segmented reduce: offset [%d] decreases\n", i + 1);
+						return;
+					}
+				}
+
+				int *order = new int[numSegments];
+				int numShort = 0;
+				for (int i = 0; i < numSegments; i++) {
+					Nd4jIndex length = segmentOffsets[i + 1] - segmentOffsets[i];
+					if (length == 0)
+						result[i] = EmptyReduction<OpType>::template value<T>();
+					else if (length >= serialLength)
+						result[i] = execScalar<OpType>(x + segmentOffsets[i] * xElementWiseStride, xElementWiseStride, length, extraParams);
+					else
+						order[numShort++] = i;
+				}
+
+				std::sort(order, order + numShort, [segmentOffsets](int a, int b) {
+					return segmentOffsets[a + 1] - segmentOffsets[a] > segmentOffsets[b + 1] - segmentOffsets[b];
+				});
+
+#pragma omp parallel for schedule(dynamic, 1) if (numShort > 1)
+				for (int i = 0; i < numShort; i++) {
+					int segment = order[i];
+					Nd4jIndex length = segmentOffsets[segment + 1] - segmentOffsets[segment];
+					result[segment] = execScalar<OpType>(x + segmentOffsets[segment] * xElementWiseStride, xElementWiseStride, length, extraParams);
+				}
+
+				delete[] order;
+			}
+
+
+
+			/**
+			* Reduce down to 1 number
+			* @param x the input
+			* @param xShapeInfo the shape information
+			* for the input
+			* @param extraParams the extra params
+			* @return
+			*/
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			ND4J_ISA_DISPATCH
+			static T execScalar(const T *x, int xElementWiseStride, Nd4jIndex length, T *extraParams) {
+				if (IsOrderStatistic<OpType>::value) {
+					T *scratch = new T[length];
+
+#pragma omp parallel for simd if (length > 8000)
+					for (Nd4jIndex i = 0; i < length; i++)
+						scratch[i] = x[i * xElementWiseStride];
+
+					T ret = selectQuantile<OpType>(scratch, length, extraParams);
+					delete[] scratch;
+					return ret;
+				}
+
+				if (IsMomentsOp<OpType>::value) {
+					T mean = (T) 0.0;
+					T M2 = (T) 0.0;
+					moments(x, xElementWiseStride, length, mean, M2);
+					return momentsToValue<OpType>(length, mean, M2);
+				}
+
+				if (IsLogSumExp<OpType>::value)
+					return OpType::postProcess(logSumExp<OpType>(x, xElementWiseStride, length, extraParams), length, extraParams);
+
+				if (nd4j::reduction::isDeterministic()) {
+					T reduction = nd4j::reduction::execScalar<T, OpType>(x, xElementWiseStride, length, extraParams);
+					return OpType::postProcess(reduction, length, extraParams);
+				}
+
+				T startingVal = OpType::startingValue(x);
+				if (xElementWiseStride == 1) {
+					if (length < 8000) {
+						T local = OpType::startingValue(x);
+#pragma omp simd
+						for (Nd4jIndex i = 0; i < length; i++) {
+							T curr = OpType::op(x[i], extraParams);
+							local = OpType::update(local, curr, extraParams);
+
+						}
+						local = OpType::postProcess(local, length, extraParams);
+
+						return local;
+					}
+
+					else {
+						T finalVal = startingVal;
+						BlockInformation info(length);
+						T *blocks = new T[info.chunks];
+#pragma omp parallel
+						{
+							T local = OpType::startingValue(x);
+							for (int i = omp_get_thread_num(); i < info.chunks; i += info.threads) {
+								Nd4jIndex newOffset = (i * info.items);
+								const T *chunk = x + newOffset;
+								Nd4jIndex itemsToLoop = info.items;
+								if (newOffset >= length) {
+									break;
+								}
+
+								//handle modulo case
+								if (newOffset + info.items >= length) {
+									itemsToLoop = length - newOffset;
+								}
+#pragma omp simd
+								for (Nd4jIndex j = 0; j < itemsToLoop; j++) {
+									T curr = OpType::op(chunk[j], extraParams);
+									local = OpType::update(local, curr, extraParams);
+								}
+
+							}
+
+							blocks[omp_get_thread_num()] = local;
+						}
+
+#pragma omp simd
+						for (int i = 0; i < info.threads; i++) {
+							finalVal = OpType::update(finalVal, blocks[i], extraParams);
+						}
+
+
+						finalVal = OpType::postProcess(finalVal, length, extraParams);
+						delete[] blocks;
+						return finalVal;
+
+					}
+
+				}
+
+				else {
+					if (length < 8000) {
+						T local = OpType::startingValue(x);
+#pragma omp simd
 						for (Nd4jIndex i = 0; i < length; i++) {
 							T curr = OpType::op(x[i * xElementWiseStride], extraParams);
 							local = OpType::update(local, curr, extraParams);
@@ -747,6 +1606,586 @@ template<typename OpType>
 				}
 
 			}
+
+
+			/**
+			 * Mean and second central moment (M2) of a block
+			 * short enough to stay in cache between the two passes.
+			 * The mean is accumulated relative to the first element
+			 * so large offsets don't swamp the sum. When low and high are
+			 * given the first pass also takes the minimum and maximum.
+			 * Compiled for the baseline only, so moments round the same
+			 * on every machine.
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			ND4J_ISA_INVARIANT
+			static inline void blockMoments(const T *x, int xStride, Nd4jIndex n, T &mean, T &M2, T *low = nullptr, T *high = nullptr) {
+				const T shift = x[0];
+				T sum = (T) 0.0;
+				if (low == nullptr) {
+#pragma omp simd reduction(+:sum)
+					for (Nd4jIndex i = 0; i < n; i++) {
+						sum += x[i * xStride] - shift;
+					}
+				}
+				else {
+					T blockLow = shift;
+					T blockHigh = shift;
+#pragma omp simd reduction(+:sum) reduction(min:blockLow) reduction(max:blockHigh)
+					for (Nd4jIndex i = 0; i < n; i++) {
+						T v = x[i * xStride];
+						sum += v - shift;
+						blockLow = nd4j::math::nd4j_min<T>(blockLow, v);
+						blockHigh = nd4j::math::nd4j_max<T>(blockHigh, v);
+					}
+
+					*low = blockLow;
+					*high = blockHigh;
+				}
+
+				mean = shift + sum / (T) n;
+				T localMean = mean;
+				T m2 = (T) 0.0;
+#pragma omp simd reduction(+:m2)
+				for (Nd4jIndex i = 0; i < n; i++) {
+					T delta = x[i * xStride] - localMean;
+					m2 += delta * delta;
+				}
+
+				M2 = m2;
+			}
+
+			/**
+			 * Merges the moments of b into a,
+			 * see SummaryStatsReduce::update
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void mergeMoments(Nd4jIndex &nA, T &meanA, T &M2A, Nd4jIndex nB, T meanB, T M2B) {
+				if (nB == 0)
+					return;
+
+				if (nA == 0) {
+					nA = nB;
+					meanA = meanB;
+					M2A = M2B;
+					return;
+				}
+
+				Nd4jIndex n = nA + nB;
+				T delta = meanB - meanA;
+				T fraction = (T) ((double) nB / (double) n);
+				meanA += delta * fraction;
+				M2A += M2B + delta * delta * (T) nA * fraction;
+				nA = n;
+			}
+
+			/**
+			 * Single pass mean and M2 of length elements spaced xElementWiseStride apart.
+			 * Fixed size blocks are reduced in parallel and merged in a fixed
+			 * pairwise tree, so the result doesn't depend on the number of threads.
+			 * When low and high are given the minimum and maximum are taken
+			 * in the same pass.
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void moments(const T *x, int xElementWiseStride, Nd4jIndex length, T &mean, T &M2, T *low = nullptr, T *high = nullptr) {
+				Nd4jIndex blocks = nd4j::reduction::numBlocks(length);
+				if (blocks <= 1) {
+					if (length > 0)
+						blockMoments(x, xElementWiseStride, length, mean, M2, low, high);
+					return;
+				}
+
+				Nd4jIndex *counts = new Nd4jIndex[blocks];
+				T *means = new T[blocks];
+				T *m2s = new T[blocks];
+				T *lows = low == nullptr ? nullptr : new T[blocks];
+				T *highs = low == nullptr ? nullptr : new T[blocks];
+
+#pragma omp parallel for schedule(static)
+				for (Nd4jIndex b = 0; b < blocks; b++) {
+					Nd4jIndex start = b * ND4J_DETERMINISTIC_BLOCK;
+					counts[b] = start + ND4J_DETERMINISTIC_BLOCK < length ? ND4J_DETERMINISTIC_BLOCK : length - start;
+					blockMoments(x + start * xElementWiseStride, xElementWiseStride, counts[b], means[b], m2s[b],
+								 lows == nullptr ? nullptr : lows + b, highs == nullptr ? nullptr : highs + b);
+				}
+
+				for (Nd4jIndex width = 1; width < blocks; width *= 2)
+					for (Nd4jIndex b = 0; b + width < blocks; b += 2 * width)
+						mergeMoments(counts[b], means[b], m2s[b], counts[b + width], means[b + width], m2s[b + width]);
+
+				mean = means[0];
+				M2 = m2s[0];
+
+				if (low != nullptr) {
+					*low = lows[0];
+					*high = highs[0];
+					for (Nd4jIndex b = 1; b < blocks; b++) {
+						*low = nd4j::math::nd4j_min<T>(*low, lows[b]);
+						*high = nd4j::math::nd4j_max<T>(*high, highs[b]);
+					}
+
+					delete[] lows;
+					delete[] highs;
+				}
+
+				delete[] counts;
+				delete[] means;
+				delete[] m2s;
+			}
+
+			/**
+			 * Single pass mean and M2 of the next runs innermost runs of a
+			 * strided iterator, runs are split into cache sized blocks and
+			 * merged in order. low and high, when given, are folded with
+			 * the minimum and maximum (and set by the first block when n is 0).
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void iteratorMoments(const T *x, StridedIterator &iter, Nd4jIndex runs, Nd4jIndex &n, T &mean, T &M2, T *low = nullptr, T *high = nullptr) {
+				const Nd4jIndex innerLength = iter.innerLength();
+				const int innerStride = iter.innerStride(0);
+				for (Nd4jIndex r = 0; r < runs; r++) {
+					const T *run = x + iter.offsets[0];
+					for (Nd4jIndex start = 0; start < innerLength; start += ND4J_DETERMINISTIC_BLOCK) {
+						Nd4jIndex blockLength = start + ND4J_DETERMINISTIC_BLOCK < innerLength ? ND4J_DETERMINISTIC_BLOCK : innerLength - start;
+						T blockMean;
+						T blockM2;
+						T blockLow;
+						T blockHigh;
+						blockMoments(run + start * innerStride, innerStride, blockLength, blockMean, blockM2,
+									 low == nullptr ? nullptr : &blockLow, low == nullptr ? nullptr : &blockHigh);
+						if (low != nullptr) {
+							*low = n == 0 ? blockLow : nd4j::math::nd4j_min<T>(*low, blockLow);
+							*high = n == 0 ? blockHigh : nd4j::math::nd4j_max<T>(*high, blockHigh);
+						}
+
+						mergeMoments(n, mean, M2, blockLength, blockMean, blockM2);
+					}
+
+					iter.next();
+				}
+			}
+
+			/**
+			 * Single pass mean and M2 of numTads strided tads starting at
+			 * x + tadOffsets[i] (x for a null tadOffsets), all walked by
+			 * tadIter. Tads are cut into chunks of whole innermost runs of
+			 * about a block each; the chunks of all tads are reduced in
+			 * parallel and merged per tad in a fixed pairwise tree. The
+			 * chunks only depend on the shape, so few long tads use every
+			 * thread and the result doesn't depend on the number of threads.
+			 * When low and high are given the minimum and maximum of every
+			 * tad are taken in the same pass.
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void tadMoments(const T *x, StridedIterator &tadIter, int numTads, int *tadOffsets, Nd4jIndex *n, T *mean, T *M2, T *low = nullptr, T *high = nullptr) {
+				const Nd4jIndex innerLength = tadIter.innerLength();
+				const Nd4jIndex runsPerTad = tadIter.outerLength();
+				Nd4jIndex runsPerChunk = ND4J_DETERMINISTIC_BLOCK / (innerLength > 0 ? innerLength : 1);
+				if (runsPerChunk < 1)
+					runsPerChunk = 1;
+
+				const Nd4jIndex chunksPerTad = (runsPerTad + runsPerChunk - 1) / runsPerChunk;
+				const Nd4jIndex numChunks = numTads * chunksPerTad;
+				if (chunksPerTad < 1) {
+					for (int i = 0; i < numTads; i++) {
+						n[i] = 0;
+						mean[i] = (T) 0.0;
+						M2[i] = (T) 0.0;
+					}
+
+					return;
+				}
+
+				Nd4jIndex *counts = new Nd4jIndex[numChunks];
+				T *means = new T[numChunks];
+				T *m2s = new T[numChunks];
+				T *lows = low == nullptr ? nullptr : new T[numChunks];
+				T *highs = low == nullptr ? nullptr : new T[numChunks];
+
+#pragma omp parallel for schedule(static) if (numChunks > 1 && numTads * runsPerTad * innerLength > 8192)
+				for (Nd4jIndex c = 0; c < numChunks; c++) {
+					const Nd4jIndex tad = c / chunksPerTad;
+					const Nd4jIndex firstRun = (c % chunksPerTad) * runsPerChunk;
+					StridedIterator iter = tadIter;
+					iter.seek(firstRun);
+
+					counts[c] = 0;
+					means[c] = (T) 0.0;
+					m2s[c] = (T) 0.0;
+					iteratorMoments(x + (tadOffsets == nullptr ? 0 : tadOffsets[tad]), iter, runsPerTad - firstRun < runsPerChunk ? runsPerTad - firstRun : runsPerChunk, counts[c], means[c], m2s[c],
+									lows == nullptr ? nullptr : lows + c, highs == nullptr ? nullptr : highs + c);
+				}
+
+#pragma omp parallel for schedule(static) if (numTads > 16 && chunksPerTad > 1)
+				for (int i = 0; i < numTads; i++) {
+					Nd4jIndex *tadCounts = counts + i * chunksPerTad;
+					T *tadMeans = means + i * chunksPerTad;
+					T *tadM2s = m2s + i * chunksPerTad;
+					for (Nd4jIndex width = 1; width < chunksPerTad; width *= 2)
+						for (Nd4jIndex b = 0; b + width < chunksPerTad; b += 2 * width)
+							mergeMoments(tadCounts[b], tadMeans[b], tadM2s[b], tadCounts[b + width], tadMeans[b + width], tadM2s[b + width]);
+
+					n[i] = tadCounts[0];
+					mean[i] = tadMeans[0];
+					M2[i] = tadM2s[0];
+
+					if (low != nullptr) {
+						low[i] = lows[i * chunksPerTad];
+						high[i] = highs[i * chunksPerTad];
+						for (Nd4jIndex b = 1; b < chunksPerTad; b++) {
+							low[i] = nd4j::math::nd4j_min<T>(low[i], lows[i * chunksPerTad + b]);
+							high[i] = nd4j::math::nd4j_max<T>(high[i], highs[i * chunksPerTad + b]);
+						}
+					}
+				}
+
+				if (lows != nullptr) {
+					delete[] lows;
+					delete[] highs;
+				}
+
+				delete[] counts;
+				delete[] means;
+				delete[] m2s;
+			}
+
+			/**
+			 * Log-sum-exp of n elements spaced stride apart: the block max
+			 * is subtracted before exponentiating, so every element costs
+			 * one exp and nothing overflows
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline T blockLogSumExp(const T *x, int stride, Nd4jIndex n) {
+				T max = x[0];
+				for (Nd4jIndex i = 1; i < n; i++)
+					max = nd4j::math::nd4j_max<T>(max, x[i * stride]);
+
+				// empty (all -inf) and infinite blocks
+				if (!(max > (T) -MAX_FLOAT && max < (T) MAX_FLOAT))
+					return max;
+
+				T sum = (T) 0.0;
+#pragma omp simd reduction(+:sum)
+				for (Nd4jIndex i = 0; i < n; i++)
+					sum += nd4j::math::nd4j_exp<T>(x[i * stride] - max);
+
+				return max + nd4j::math::nd4j_log<T>(sum);
+			}
+
+			/**
+			 * Log-sum-exp of length elements spaced xElementWiseStride apart.
+			 * Fixed size blocks are reduced in parallel and merged with the
+			 * op's update in a fixed pairwise tree, so the result doesn't
+			 * depend on the number of threads.
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static T logSumExp(const T *x, int xElementWiseStride, Nd4jIndex length, T *extraParams) {
+				Nd4jIndex blocks = nd4j::reduction::numBlocks(length);
+				if (blocks == 0)
+					return OpType::startingValue(x);
+
+				if (blocks == 1)
+					return blockLogSumExp(x, xElementWiseStride, length);
+
+				T *partials = new T[blocks];
+
+#pragma omp parallel for schedule(static)
+				for (Nd4jIndex b = 0; b < blocks; b++) {
+					Nd4jIndex start = b * ND4J_DETERMINISTIC_BLOCK;
+					Nd4jIndex n = start + ND4J_DETERMINISTIC_BLOCK < length ? ND4J_DETERMINISTIC_BLOCK : length - start;
+					partials[b] = blockLogSumExp(x + start * xElementWiseStride, xElementWiseStride, n);
+				}
+
+				T ret = nd4j::reduction::mergeTree<T, OpType>(partials, nullptr, blocks, extraParams);
+				delete[] partials;
+
+				return ret;
+			}
+
+			/**
+			 * Copies the elements visited by iter into scratch, long
+			 * iterations are split between threads by whole innermost runs
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void gather(const T *x, const StridedIterator &iter, T *scratch) {
+				const Nd4jIndex innerLength = iter.innerLength();
+				const int innerStride = iter.innerStride(0);
+				const Nd4jIndex runs = iter.outerLength();
+
+#pragma omp parallel if (runs > 1 && runs * innerLength >= ND4J_PARALLEL_SELECT)
+				{
+					const Nd4jIndex first = runs * omp_get_thread_num() / omp_get_num_threads();
+					const Nd4jIndex last = runs * (omp_get_thread_num() + 1) / omp_get_num_threads();
+					if (first < last) {
+						StridedIterator chunk = iter;
+						chunk.seek(first);
+						for (Nd4jIndex r = first; r < last; r++) {
+							const T *run = x + chunk.offsets[0];
+							T *target = scratch + r * innerLength;
+#pragma omp simd
+							for (Nd4jIndex i = 0; i < innerLength; i++)
+								target[i] = run[i * innerStride];
+
+							chunk.next();
+						}
+					}
+				}
+			}
+
+			/**
+			 * Quantile IsOrderStatistic<OpType>::quantile(extraParams) of the length values
+			 * in scratch, linearly interpolated between the closest ranks. NaN
+			 * propagates: scratch holding a NaN gives NaN (selection needs a strict
+			 * weak ordering, which NaN breaks).
+			 *
+			 * Uses std::nth_element (introselect). Long scratches are selected by
+			 * all threads (see selectRanks) when called outside of a parallel
+			 * region, ranks are exact so the result doesn't depend on the number
+			 * of threads. Reorders scratch.
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static T selectQuantile(T *scratch, Nd4jIndex length, T *extraParams) {
+				if (length < 1)
+					return (T) 0.0;
+
+				const bool parallel = length >= ND4J_PARALLEL_SELECT && omp_get_max_threads() > 1 && !omp_in_parallel();
+
+				Nd4jIndex nans = 0;
+#pragma omp parallel for simd reduction(+:nans) if (parallel)
+				for (Nd4jIndex i = 0; i < length; i++)
+					nans += scratch[i] != scratch[i] ? 1 : 0;
+
+				if (nans > 0) {
+					for (Nd4jIndex i = 0; i < length; i++)
+						if (scratch[i] != scratch[i])
+							return scratch[i];
+				}
+
+				double q = (double) IsOrderStatistic<OpType>::quantile(extraParams);
+				q = q < 0.0 ? 0.0 : q > 1.0 ? 1.0 : q;
+
+				double position = q * (double) (length - 1);
+				Nd4jIndex rank = (Nd4jIndex) position;
+
+				T low;
+				T high;
+				if (parallel) {
+					T *buffer = new T[length];
+					selectRanks(scratch, buffer, length, rank, low, high);
+					delete[] buffer;
+				}
+				else {
+					std::nth_element(scratch, scratch + rank, scratch + length);
+					low = scratch[rank];
+					high = rank + 1 < length ? minimum(scratch + rank + 1, length - rank - 1) : low;
+				}
+
+				if (rank + 1 >= length || position == (double) rank)
+					return low;
+
+				return low + (high - low) * (T) (position - (double) rank);
+			}
+
+			/**
+			 * Smallest of length (> 0) values
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline T minimum(const T *x, Nd4jIndex length) {
+				T ret = x[0];
+				for (Nd4jIndex i = 1; i < length; i++)
+					ret = x[i] < ret ? x[i] : ret;
+
+				return ret;
+			}
+
+			/**
+			 * Parallel selection of the rank-th (low) and rank + 1-th (high)
+			 * smallest of length NaN free values in data, using buffer
+			 * (length values) as scratch. Every round counts the values below
+			 * and equal to a median of nine pivot in parallel per chunk and
+			 * compacts the side holding rank into the other buffer, until
+			 * few enough remain for std::nth_element. Both buffers are reordered.
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void selectRanks(T *data, T *buffer, Nd4jIndex length, Nd4jIndex rank, T &low, T &high) {
+				const int chunks = omp_get_max_threads();
+				Nd4jIndex *less = new Nd4jIndex[chunks];
+				Nd4jIndex *equal = new Nd4jIndex[chunks];
+				Nd4jIndex *targets = new Nd4jIndex[chunks];
+				T *src = data;
+				T *dst = buffer;
+				Nd4jIndex n = length;
+
+				// smallest value known to lie above everything left in src
+				bool bounded = false;
+				T above = (T) 0.0;
+
+				while (n >= ND4J_PARALLEL_SELECT) {
+					T samples[9];
+					for (int s = 0; s < 9; s++)
+						samples[s] = src[(n - 1) * s / 8];
+					std::sort(samples, samples + 9);
+					const T pivot = samples[4];
+					const Nd4jIndex chunkLength = (n + chunks - 1) / chunks;
+
+#pragma omp parallel for schedule(static)
+					for (int c = 0; c < chunks; c++) {
+						Nd4jIndex start = c * chunkLength;
+						Nd4jIndex end = start + chunkLength < n ? start + chunkLength : n;
+						Nd4jIndex l = 0;
+						Nd4jIndex e = 0;
+#pragma omp simd reduction(+:l,e)
+						for (Nd4jIndex i = start; i < end; i++) {
+							l += src[i] < pivot ? 1 : 0;
+							e += src[i] == pivot ? 1 : 0;
+						}
+
+						less[c] = l;
+						equal[c] = e;
+					}
+
+					Nd4jIndex totalLess = 0;
+					Nd4jIndex totalEqual = 0;
+					for (int c = 0; c < chunks; c++) {
+						totalLess += less[c];
+						totalEqual += equal[c];
+					}
+
+					if (rank >= totalLess && rank < totalLess + totalEqual) {
+						low = pivot;
+						if (rank + 1 < totalLess + totalEqual) {
+							high = pivot;
+						}
+						else if (totalLess + totalEqual < n) {
+							// smallest value above the pivot, from the per chunk minima
+							T *minima = new T[chunks];
+							bool *found = new bool[chunks];
+
+#pragma omp parallel for schedule(static)
+							for (int c = 0; c < chunks; c++) {
+								Nd4jIndex start = c * chunkLength;
+								Nd4jIndex end = start + chunkLength < n ? start + chunkLength : n;
+								found[c] = false;
+								for (Nd4jIndex i = start; i < end; i++) {
+									if (src[i] > pivot && (!found[c] || src[i] < minima[c])) {
+										minima[c] = src[i];
+										found[c] = true;
+									}
+								}
+							}
+
+							bool any = false;
+							for (int c = 0; c < chunks; c++) {
+								if (found[c] && (!any || minima[c] < high)) {
+									high = minima[c];
+									any = true;
+								}
+							}
+
+							delete[] minima;
+							delete[] found;
+						}
+						else {
+							high = bounded ? above : pivot;
+						}
+
+						delete[] less;
+						delete[] equal;
+						delete[] targets;
+						return;
+					}
+
+					const bool keepLess = rank < totalLess;
+					if (keepLess) {
+						above = pivot;
+						bounded = true;
+					}
+					else {
+						rank -= totalLess + totalEqual;
+					}
+
+					Nd4jIndex target = 0;
+					for (int c = 0; c < chunks; c++) {
+						Nd4jIndex start = c * chunkLength;
+						Nd4jIndex end = start + chunkLength < n ? start + chunkLength : n;
+						Nd4jIndex count = end > start ? end - start : 0;
+						targets[c] = target;
+						target += keepLess ? less[c] : count - less[c] - equal[c];
+					}
+
+#pragma omp parallel for schedule(static)
+					for (int c = 0; c < chunks; c++) {
+						Nd4jIndex start = c * chunkLength;
+						Nd4jIndex end = start + chunkLength < n ? start + chunkLength : n;
+						T *out = dst + targets[c];
+						if (keepLess) {
+							for (Nd4jIndex i = start; i < end; i++)
+								if (src[i] < pivot)
+									*out++ = src[i];
+						}
+						else {
+							for (Nd4jIndex i = start; i < end; i++)
+								if (src[i] > pivot)
+									*out++ = src[i];
+						}
+					}
+
+					n = target;
+					T *swap = src;
+					src = dst;
+					dst = swap;
+				}
+
+				std::nth_element(src, src + rank, src + n);
+				low = src[rank];
+				if (rank + 1 < n)
+					high = minimum(src + rank + 1, n - rank - 1);
+				else
+					high = bounded ? above : low;
+
+				delete[] less;
+				delete[] equal;
+				delete[] targets;
+			}
+
+			/**
+			 * Final value of a moments op from its running moments: the
+			 * op's postProcess is given the exact mean and no bias
+			 * correction term, so the caller's extraParams (the mean and
+			 * bias the cuda kernels take) are never needed
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline T momentsToValue(Nd4jIndex n, T mean, T M2) {
+				T params[2] = {mean, (T) 0.0};
+				return OpType::postProcess(M2, n, params);
+			}
 		};
 
 #ifdef __CUDACC__
@@ -19,6 +19,7 @@
 #include <shape.h>
 #include <ops.h>
 #include <op_boilerplate.h>
+#include <deterministic.h>
 
 #ifdef __JNI__
 #include <jni.h>
@@ -579,6 +580,11 @@ template<typename OpType>
 				char xOrder = shape::order(xShapeInfo);
 				char yOrder = shape::order(yShapeInfo);
 				if(xOrder == yOrder && (xElementWiseStride  >= 1 && yElementWiseStride >= 1)) {
+					if (nd4j::reduction::isDeterministic()) {
+						startingVal = nd4j::reduction::execScalar<T, OpType>(x, xElementWiseStride, y, yElementWiseStride, length, extraParamsVals);
+						return  OpType::postProcess(startingVal, length, extraParamsVals);
+					}
+
 					if (xElementWiseStride == 1 && yElementWiseStride == 1) {
 #pragma omp simd
 						for(int i = 0; i < length; i++) {
@@ -753,7 +759,51 @@ template<typename OpType>
                      */
 					int tadElementWiseStride = shape::elementWiseStride(xTad.tadOnlyShapeInfo);
 					int tadLength = shape::length(xTad.tadOnlyShapeInfo);
-#pragma omp parallel for
+
+					// few, long tads: split every tad between threads, merge partials in chunk order
+					TadBlockInformation info(resultLength, tadLength);
+					if (info.isSplit() && !nd4j::reduction::isDeterministic()) {
+						const int extraParamsLen = OpType::extraParamsLen > 0 ? OpType::extraParamsLen : 1;
+						T *partials = new T[info.numChunks()];
+						T *chunkExtraParams = new T[info.numChunks() * extraParamsLen];
+
+#pragma omp parallel for schedule(static)
+						for (Nd4jIndex c = 0; c < info.numChunks(); c++) {
+							Nd4jIndex offset = xTad.tadOffsets[c / info.chunksPerTad];
+							int chunk = (int) (c % info.chunksPerTad);
+							Nd4jIndex chunkStart = info.chunkStart(chunk);
+							Nd4jIndex chunkEnd = info.chunkEnd(chunk);
+							T *localExtraParams = chunkExtraParams + c * extraParamsLen;
+							for (int extraParamsIdx = 0; extraParamsIdx < extraParamsLen; extraParamsIdx++)
+								localExtraParams[extraParamsIdx] = startingVal;
+
+							T local = OpType::op(x[offset + tadElementWiseStride * chunkStart], y[offset + tadElementWiseStride * chunkStart], localExtraParams);
+							for (Nd4jIndex j = chunkStart + 1; j < chunkEnd; j++) {
+								local = OpType::update(local, OpType::op(x[offset + tadElementWiseStride * j], y[offset + tadElementWiseStride * j], localExtraParams), localExtraParams);
+							}
+
+							partials[c] = local;
+						}
+
+#pragma omp parallel for if (resultLength > 16)
+						for (Nd4jIndex i = 0; i < resultLength; i++) {
+							T *localExtraParams = chunkExtraParams + i * info.chunksPerTad * extraParamsLen;
+							T local = partials[i * info.chunksPerTad];
+							for (int c = 1; c < info.chunksPerTad; c++) {
+								local = OpType::update(local, partials[i * info.chunksPerTad + c], localExtraParams);
+								OpType::aggregateExtraParams(localExtraParams, localExtraParams + c * extraParamsLen);
+							}
+
+							result[i] = OpType::postProcess(local, tadLength, localExtraParams);
+						}
+
+						delete[] partials;
+						delete[] chunkExtraParams;
+						return;
+					}
+
+					// in deterministic mode the per tad kernel parallelizes itself when tads are few
+#pragma omp parallel for if (!info.isSplit())
 					for(Nd4jIndex i = 0; i < resultLength; i++) {
 						T *localExtraParams = nullptr;
 						if(OpType::extraParamsLen > 0)
@@ -763,9 +813,14 @@ template<typename OpType>
 						}
 
 						Nd4jIndex offset = xTad.tadOffsets[i];
-						result[i] = OpType::op(x[offset], y[offset], localExtraParams);
-						for(int j = 1; j < tadLength; j++) {
-							result[i] = OpType::update(result[i], OpType::op(x[offset + tadElementWiseStride * j],y[offset + tadElementWiseStride * j], localExtraParams), localExtraParams);
+						if (nd4j::reduction::isDeterministic()) {
+							result[i] = nd4j::reduction::execScalar<T, OpType>(x + offset, tadElementWiseStride, y + offset, tadElementWiseStride, tadLength, localExtraParams);
+						}
+						else {
+							result[i] = OpType::op(x[offset], y[offset], localExtraParams);
+							for(int j = 1; j < tadLength; j++) {
+								result[i] = OpType::update(result[i], OpType::op(x[offset + tadElementWiseStride * j],y[offset + tadElementWiseStride * j], localExtraParams), localExtraParams);
+							}
 						}
 
 						result[i] = OpType::postProcess(result[i],tadLength, localExtraParams);
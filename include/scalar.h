@@ -15,6 +15,8 @@
 #include <templatemath.h>
 #include <ops.h>
 #include <op_boilerplate.h>
+#include <isa_dispatch.h>
+#include <pairwise_util.h>
 
 #ifdef __CUDACC__
 #include <cuda.h>
@@ -303,6 +305,7 @@ template<typename OpType>
          */
 
 		  template<typename OpType>
+		  ND4J_ISA_DISPATCH
 		  static  void transform(T *x,
                            int *xShapeInfo,
                            T *result,
@@ -312,81 +315,35 @@ template<typename OpType>
                 char resultOrdering = shape::order(resultShapeInfo);
                 int xElementWiseStride = shape::elementWiseStride(xShapeInfo);
                 int resultElementWiseStride = shape::elementWiseStride(resultShapeInfo);
-                if(xOrdering != resultOrdering || xElementWiseStride < 1 || resultElementWiseStride < 0) {
-                    int shapeIter[MAX_RANK];
-                    int coord[MAX_RANK];
-                    int dim;
-                    int xStridesIter[MAX_RANK];
-                    int resultStridesIter[MAX_RANK];
-                    int *xShape = shape::shapeOf(xShapeInfo);
-                    int *xStride = shape::stride(xShapeInfo);
-                    int *resultStride = shape::stride(resultShapeInfo);
-                    int rank = shape::rank(xShapeInfo);
-                    if(PrepareTwoRawArrayIter<T>(rank,
-                                                 xShape,
-                                                 x,
-                                                 xStride,
-                                                 result,
-                                                 resultStride,
-                                                 &rank,
-                                                 shapeIter,
-                                                 &x,
-                                                 xStridesIter,
-                                                 &result,
-                                                 resultStridesIter) >= 0) {
-                        ND4J_RAW_ITER_START(dim, rank, coord, shapeIter); {
-                                /* Process the innermost dimension */
-                                T *xIter = x;
-                                T *resultIter = result;
-                                resultIter[0] = OpType::op(xIter[0],scalar,extraParams);
-                            } ND4J_RAW_ITER_TWO_NEXT(dim,
-                                                     rank,
-                                                     coord,
-                                                     shapeIter,
-                                                     x,
-                                                     xStridesIter,
-                                                     result,
-                                                     resultStridesIter);
-                    }
-                    else {
-                        printf("Unable to prepare array\n");
-                    }
+                if(xOrdering != resultOrdering || xElementWiseStride < 1 || resultElementWiseStride < 1) {
+                    // x and result share the shape, so one coalesced iterator walks both
+                    StridedIterator iter(shape::rank(xShapeInfo), shape::shapeOf(xShapeInfo), shape::stride(xShapeInfo), shape::stride(resultShapeInfo));
+                    const Nd4jIndex innerLength = iter.innerLength();
+                    const int xInnerStride = iter.innerStride(0);
+                    const int resultInnerStride = iter.innerStride(1);
+
+                    // whole innermost runs are distributed between threads
+                    TadBlockInformation runInfo(1, iter.outerLength(), 8192 / (innerLength > 0 ? innerLength : 1));
+
+#pragma omp parallel for schedule(static) if (runInfo.isSplit())
+                    for (int c = 0; c < runInfo.chunksPerTad; c++) {
+                        StridedIterator chunkIter = iter;
+                        chunkIter.seek(runInfo.chunkStart(c));
+
+                        for (Nd4jIndex run = runInfo.chunkStart(c); run < runInfo.chunkEnd(c); run++) {
+                            T *xIter = x + chunkIter.offsets[0];
+                            T *resultIter = result + chunkIter.offsets[1];
+#pragma omp simd
+                            for (Nd4jIndex i = 0; i < innerLength; i++)
+                                resultIter[i * resultInnerStride] = OpType::op(xIter[i * xInnerStride], scalar, extraParams);
 
+                            chunkIter.next();
+                        }
+                    }
                 }
                 else {
                     const Nd4jIndex n = shape::length(xShapeInfo);
-
-
-                    if(xElementWiseStride >= 1 && resultElementWiseStride >= 1) {
-                        transform<OpType>(x,xElementWiseStride,result,resultElementWiseStride,scalar,extraParams,n);
-                    }
-                    else {
-                        int *xShape = shape::shapeOf(xShapeInfo);
-                        int *resultShape = shape::shapeOf(resultShapeInfo);
-
-                        int *xStride = shape::stride(xShapeInfo);
-                        int *resultStride = shape::stride(resultShapeInfo);
-                        int xRank = shape::rank(xShapeInfo);
-                        int resultRank = shape::rank(resultShapeInfo);
-
-                        int xOffset = shape::offset(xShapeInfo);
-                        int resultOffset = shape::offset(resultShapeInfo);
-
-#pragma omp parallel for simd schedule(guided) if (n > 2048)
-                        for (Nd4jIndex i = 0; i < n; i++) {
-                            int *xIdx = shape::ind2sub(xRank, xShape, i);
-                            int *resultIdx = shape::ind2sub(resultRank, resultShape, i);
-                            int xOffset2 = shape::getOffset(xOffset, xShape, xStride, xIdx, xRank);
-                            int resultOffset2 = shape::getOffset(resultOffset, resultShape, resultStride, resultIdx, resultRank);
-
-                            result[resultOffset2] = OpType::op(x[xOffset2], scalar,extraParams);
-
-                            delete[] xIdx;
-                            delete[] resultIdx;
-
-                        }
-
-                    }
+                    transform<OpType>(x,xElementWiseStride,result,resultElementWiseStride,scalar,extraParams,n);
                 }
 
 
@@ -406,6 +363,7 @@ template<typename OpType>
              */
 
 			template<typename OpType>
+			ND4J_ISA_DISPATCH
 			static void transform(T *x, int xStride, T *result, int resultStride,
                            T scalar, T *extraParams, const Nd4jIndex n) {
                 if (xStride == 1 && resultStride == 1) {
@@ -0,0 +1,298 @@
+/*
+ * scan.h
+ *
+ * Inclusive and exclusive scans (cumulative sum, product,
+ * max and min) along dimensions.
+ */
+
+#ifndef LIBND4J_SCAN_H
+#define LIBND4J_SCAN_H
+
+#include <algorithm>
+#include <dll.h>
+#include <shape.h>
+#include <omp.h>
+#include <templatemath.h>
+#include <pairwise_util.h>
+#include <ops.h>
+#include <op_boilerplate.h>
+#include <deterministic.h>
+
+#ifdef __JNI__
+#include <jni.h>
+#endif
+
+/**
+ * Scans reuse the reduce ops: the running value starts at
+ * startingValue and every element is folded in with update.
+ */
+#define SCAN_OPS \
+        (0, simdOps::Sum), \
+        (1, simdOps::Prod), \
+        (2, simdOps::Max), \
+        (3, simdOps::Min)
+
+namespace functions {
+	namespace scan {
+
+		template<typename T>
+		class Scan {
+		public:
+
+			static void exec(const int opNum,
+				T *x,
+				int *xShapeInfo,
+				T *extraParams,
+				T *result,
+				int *resultShapeInfo,
+				int *dimension,
+				int dimensionLength,
+				bool exclusive, bool reverse, int *tadShapeInfo, int *tadOffsets) {
+                            DISPATCH_BY_OPNUM(exec, PARAMS(x, xShapeInfo, extraParams, result, resultShapeInfo, dimension, dimensionLength, exclusive, reverse, tadShapeInfo, tadOffsets), SCAN_OPS);
+			}
+
+			/**
+			 * Scans every tad of x along the given dimensions into the
+			 * matching tad of result (which has the same shape as x,
+			 * x and result may be the same buffer).
+			 *
+			 * Elements of a tad are visited in c order of the scanned dimensions
+			 * (the highest dimension varies fastest), or in reverse c order
+			 * when reverse is set. An inclusive scan writes update(previous, x[i])
+			 * to result[i], an exclusive scan writes the value before x[i] was
+			 * folded in. The running value starts at the op's starting value:
+			 * 0 for sum, 1 for product and the first visited element for max
+			 * and min, so an exclusive cummax/cummin writes that first element
+			 * twice (result[0] = x[0], result[i] = max(x[0] .. x[i - 1])).
+			 *
+			 * A null dimension (or MAX_DIMENSION) scans the whole array.
+			 *
+			 * When there are fewer tads than threads, long tads are scanned
+			 * in two passes: chunk totals in parallel, a sequential scan of
+			 * the totals, then every chunk is scanned in parallel starting
+			 * from its carry in. The split (and so the rounding of sums)
+			 * depends on the number of threads, deterministic mode keeps
+			 * every tad on a single thread.
+			 *
+			 * @param x the input
+			 * @param xShapeInfo the shape information for the input
+			 * @param extraParams the extra params for the op
+			 * @param result the result buffer
+			 * @param resultShapeInfo the shape information for the result
+			 * @param dimension the dimensions to scan along
+			 * @param dimensionLength the number of dimensions
+			 * @param exclusive whether to do an exclusive scan
+			 * @param reverse whether to scan from the last element to the first
+			 * @param tadShapeInfo unused, the tads are described by xShapeInfo
+			 * @param tadOffsets optional precomputed tad offsets for x
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void exec(T *x,
+				int *xShapeInfo,
+				T *extraParams,
+				T *result,
+				int *resultShapeInfo,
+				int *dimension,
+				int dimensionLength,
+				bool exclusive, bool reverse, int *tadShapeInfo, int *tadOffsets) {
+				const Nd4jIndex length = shape::length(xShapeInfo);
+				if (length < 1)
+					return;
+
+				int *xTadOffsets = tadOffsets;
+				int *resultTadOffsets;
+				shape::TAD *xTad = nullptr;
+				shape::TAD *resultTad = nullptr;
+				int wholeOffset = 0;
+
+				Nd4jIndex tadLength;
+				int numTads;
+
+				if (dimension == nullptr || dimension[0] == MAX_DIMENSION || dimensionLength >= shape::rank(xShapeInfo)) {
+					xTadOffsets = &wholeOffset;
+					resultTadOffsets = &wholeOffset;
+					tadLength = length;
+					numTads = 1;
+				}
+				else {
+					if (xTadOffsets == nullptr) {
+						xTad = new shape::TAD(xShapeInfo, dimension, dimensionLength);
+						xTad->createTadOnlyShapeInfo();
+						xTad->createOffsets();
+						xTadOffsets = xTad->tadOffsets;
+					}
+
+					resultTad = new shape::TAD(resultShapeInfo, dimension, dimensionLength);
+					resultTad->createTadOnlyShapeInfo();
+					resultTad->createOffsets();
+					resultTadOffsets = resultTad->tadOffsets;
+
+					tadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
+					numTads = (int) (length / tadLength);
+				}
+
+				/*
+				 * The tad is described by the scanned dimensions of x and result
+				 * themselves (tad shape information may permute them). The first
+				 * operand of the iterator is the c ordered position within the
+				 * tad, so runs are visited in scan order while x and result are
+				 * addressed through their own strides. A reverse scan starts at
+				 * the last element and walks negated strides.
+				 */
+				int xRank = shape::rank(xShapeInfo);
+				int rank = 0;
+				int scanned[MAX_RANK];
+				if (numTads == 1) {
+					for (int i = 0; i < xRank; i++)
+						scanned[rank++] = i;
+				}
+				else {
+					for (int i = 0; i < dimensionLength; i++)
+						scanned[rank++] = dimension[i] < 0 ? dimension[i] + xRank : dimension[i];
+					std::sort(scanned, scanned + rank);
+				}
+
+				int tadShape[MAX_RANK];
+				int positions[MAX_RANK];
+				int xStrides[MAX_RANK];
+				int resultStrides[MAX_RANK];
+				Nd4jIndex xFirst = 0;
+				Nd4jIndex resultFirst = 0;
+				int position = 1;
+				for (int i = rank - 1; i >= 0; i--) {
+					int xStride = shape::stride(xShapeInfo)[scanned[i]];
+					int resultStride = shape::stride(resultShapeInfo)[scanned[i]];
+					tadShape[i] = shape::shapeOf(xShapeInfo)[scanned[i]];
+					positions[i] = position;
+					position *= tadShape[i];
+					xStrides[i] = reverse ? -xStride : xStride;
+					resultStrides[i] = reverse ? -resultStride : resultStride;
+					if (reverse) {
+						xFirst += (Nd4jIndex) (tadShape[i] - 1) * xStride;
+						resultFirst += (Nd4jIndex) (tadShape[i] - 1) * resultStride;
+					}
+				}
+
+				StridedIterator tadIter(rank, tadShape, positions, xStrides, resultStrides);
+
+				TadBlockInformation info(numTads, tadLength);
+
+				if (info.isSplit() && !nd4j::reduction::isDeterministic()) {
+					T *carries = new T[info.numChunks()];
+
+#pragma omp parallel for schedule(static)
+					for (Nd4jIndex chunk = 0; chunk < info.numChunks(); chunk++) {
+						int i = (int) (chunk / info.chunksPerTad);
+						int c = (int) (chunk % info.chunksPerTad);
+						T *tadX = x + xTadOffsets[i] + xFirst;
+						carries[chunk] = reduceRange<OpType>(tadX, tadIter, info.chunkStart(c), info.chunkEnd(c), OpType::startingValue(tadX), extraParams);
+					}
+
+					// chunk totals become the value carried into every chunk
+					for (int i = 0; i < numTads; i++) {
+						T carry = OpType::startingValue(x + xTadOffsets[i] + xFirst);
+						for (int c = 0; c < info.chunksPerTad; c++) {
+							T total = carries[i * info.chunksPerTad + c];
+							carries[i * info.chunksPerTad + c] = carry;
+							carry = OpType::update(carry, total, extraParams);
+						}
+					}
+
+#pragma omp parallel for schedule(static)
+					for (Nd4jIndex chunk = 0; chunk < info.numChunks(); chunk++) {
+						int i = (int) (chunk / info.chunksPerTad);
+						int c = (int) (chunk % info.chunksPerTad);
+						scanRange<OpType>(x + xTadOffsets[i] + xFirst, result + resultTadOffsets[i] + resultFirst, tadIter, info.chunkStart(c), info.chunkEnd(c), carries[chunk], exclusive, extraParams);
+					}
+
+					delete[] carries;
+				}
+				else {
+#pragma omp parallel for schedule(guided) if (numTads > 1)
+					for (int i = 0; i < numTads; i++) {
+						T *tadX = x + xTadOffsets[i] + xFirst;
+						scanRange<OpType>(tadX, result + resultTadOffsets[i] + resultFirst, tadIter, 0, tadLength, OpType::startingValue(tadX), exclusive, extraParams);
+					}
+				}
+
+				if (xTad != nullptr)
+					delete xTad;
+				if (resultTad != nullptr)
+					delete resultTad;
+			}
+
+			/**
+			 * Folds elements [start, end) (in scan order) of a tad into value
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline T reduceRange(T *x, const StridedIterator &tadIter, Nd4jIndex start, Nd4jIndex end, T value, T *extraParams) {
+				StridedIterator iter = tadIter;
+				Nd4jIndex innerLength = iter.innerLength();
+				int xStride = iter.innerStride(1);
+				Nd4jIndex first = start % innerLength;
+				iter.seek(start / innerLength);
+
+				for (Nd4jIndex remaining = end - start; remaining > 0; iter.next()) {
+					T *xRun = x + iter.offsets[1];
+					Nd4jIndex last = first + remaining < innerLength ? first + remaining : innerLength;
+					for (Nd4jIndex i = first; i < last; i++)
+						value = OpType::update(value, OpType::op(xRun[i * xStride], extraParams), extraParams);
+
+					remaining -= last - first;
+					first = 0;
+				}
+
+				return value;
+			}
+
+			/**
+			 * Scans elements [start, end) (in scan order) of a tad starting
+			 * from carry, returns the carry out
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline T scanRange(T *x, T *result, const StridedIterator &tadIter, Nd4jIndex start, Nd4jIndex end, T carry, bool exclusive, T *extraParams) {
+				StridedIterator iter = tadIter;
+				Nd4jIndex innerLength = iter.innerLength();
+				int xStride = iter.innerStride(1);
+				int resultStride = iter.innerStride(2);
+				Nd4jIndex first = start % innerLength;
+				iter.seek(start / innerLength);
+
+				for (Nd4jIndex remaining = end - start; remaining > 0; iter.next()) {
+					T *xRun = x + iter.offsets[1];
+					T *resultRun = result + iter.offsets[2];
+					Nd4jIndex last = first + remaining < innerLength ? first + remaining : innerLength;
+					if (exclusive) {
+						for (Nd4jIndex i = first; i < last; i++) {
+							T curr = OpType::op(xRun[i * xStride], extraParams);
+							resultRun[i * resultStride] = carry;
+							carry = OpType::update(carry, curr, extraParams);
+						}
+					}
+					else {
+						for (Nd4jIndex i = first; i < last; i++) {
+							carry = OpType::update(carry, OpType::op(xRun[i * xStride], extraParams), extraParams);
+							resultRun[i * resultStride] = carry;
+						}
+					}
+
+					remaining -= last - first;
+					first = 0;
+				}
+
+				return carry;
+			}
+		};
+	}
+}
+
+#endif //LIBND4J_SCAN_H
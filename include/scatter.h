@@ -0,0 +1,215 @@
+/*
+ * scatter.h
+ *
+ * Accumulating scatters: rows of updates combined into the rows of
+ * a target picked by an index array.
+ */
+
+#ifndef LIBND4J_SCATTER_H
+#define LIBND4J_SCATTER_H
+
+#include <dll.h>
+#include <shape.h>
+#include <omp.h>
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include <pairwise_util.h>
+#include <ops.h>
+#include <op_boilerplate.h>
+
+#ifdef __JNI__
+#include <jni.h>
+#endif
+
+/**
+ * Scatters reuse the pairwise ops: target = op(target, update).
+ * Copy keeps the last update of every row.
+ */
+#define SCATTER_OPS \
+        (0, simdOps::Add), \
+        (1, simdOps::Max), \
+        (2, simdOps::Min), \
+        (3, simdOps::Multiply), \
+        (4, simdOps::Subtract), \
+        (5, simdOps::Copy)
+
+namespace functions {
+	namespace scatter {
+
+		/**
+		 * Target elements [start, end) of one row and the updates
+		 * (positions into the sorted order) applied to them
+		 */
+		struct ScatterChunk {
+			Nd4jIndex row;
+			Nd4jIndex first;
+			Nd4jIndex last;
+			Nd4jIndex start;
+			Nd4jIndex end;
+		};
+
+		template<typename T>
+		class Scatter {
+		public:
+
+			static void exec(const int opNum,
+				T *target,
+				int *targetShapeInfo,
+				T *updates,
+				int *updatesShapeInfo,
+				Nd4jIndex *indices,
+				T *extraParams) {
+                            DISPATCH_BY_OPNUM(exec, PARAMS(target, targetShapeInfo, updates, updatesShapeInfo, indices, extraParams), SCATTER_OPS);
+			}
+
+			/**
+			 * For every i, combines row i of updates into row indices[i] of
+			 * target: target[indices[i]] = op(target[indices[i]], updates[i]).
+			 * Rows are the slices along dimension 0, updates has one row per
+			 * index and rows of the same length as the target's.
+			 *
+			 * Indices may repeat. Instead of atomics the updates are sorted
+			 * by target row (keeping their order within a row) and every
+			 * target element is written by exactly one thread, which applies
+			 * its updates in index order, so results don't depend on the
+			 * number of threads. Rows receiving many updates are split into
+			 * column ranges so a few hot rows still use every thread.
+			 *
+			 * @param target the array updated in place
+			 * @param targetShapeInfo the shape information for the target
+			 * @param updates the update rows
+			 * @param updatesShapeInfo the shape information for the updates
+			 * @param indices the target row of every update row
+			 * @param extraParams the extra params for the op
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void exec(T *target,
+				int *targetShapeInfo,
+				T *updates,
+				int *updatesShapeInfo,
+				Nd4jIndex *indices,
+				T *extraParams) {
+				const int rank = shape::rank(targetShapeInfo);
+				const Nd4jIndex numRows = shape::shapeOf(targetShapeInfo)[0];
+				const Nd4jIndex rowLength = numRows > 0 ? shape::length(targetShapeInfo) / numRows : 0;
+				const Nd4jIndex numUpdates = shape::shapeOf(updatesShapeInfo)[0];
+				if (numUpdates < 1 || rowLength < 1)
+					return;
+
+				if (shape::length(updatesShapeInfo) != numUpdates * rowLength) {
+					printf("Scatter: update rows need [%lld] elements\n", (long long) rowLength);
+					return;
+				}
+
+				for (Nd4jIndex i = 0; i < numUpdates; i++) {
+					if (indices[i] < 0 || indices[i] >= numRows) {
+						printf("Scatter: index [%lld] is out of range for [%lld] rows\n", (long long) indices[i], (long long) numRows);
+						return;
+					}
+				}
+
+				const Nd4jIndex targetRowStride = shape::stride(targetShapeInfo)[0];
+				const Nd4jIndex updatesRowStride = shape::stride(updatesShapeInfo)[0];
+
+				int targetStride;
+				int updatesStride;
+				Nd4jIndex *targetOffsets = cOrderElementOffsets(rank - 1, shape::shapeOf(targetShapeInfo) + 1, shape::stride(targetShapeInfo) + 1, rowLength, targetStride);
+				Nd4jIndex *updatesOffsets = cOrderElementOffsets(shape::rank(updatesShapeInfo) - 1, shape::shapeOf(updatesShapeInfo) + 1, shape::stride(updatesShapeInfo) + 1, rowLength, updatesStride);
+
+				// updates ordered by target row, then by position
+				std::vector<Nd4jIndex> order(numUpdates);
+				for (Nd4jIndex i = 0; i < numUpdates; i++)
+					order[i] = i;
+
+				std::sort(order.begin(), order.end(), IndexOrder(indices));
+
+				std::vector<ScatterChunk> chunks;
+				chunkRows(indices, order, rowLength, chunks);
+
+#pragma omp parallel for schedule(dynamic) if (chunks.size() > 1 && numUpdates * rowLength > 8192)
+				for (Nd4jIndex c = 0; c < (Nd4jIndex) chunks.size(); c++) {
+					const ScatterChunk &chunk = chunks[c];
+					T *row = target + chunk.row * targetRowStride;
+					for (Nd4jIndex k = chunk.first; k < chunk.last; k++) {
+						T *update = updates + order[k] * updatesRowStride;
+						if (targetOffsets == nullptr && updatesOffsets == nullptr) {
+#pragma omp simd
+							for (Nd4jIndex e = chunk.start; e < chunk.end; e++)
+								row[e * targetStride] = OpType::op(row[e * targetStride], update[e * updatesStride], extraParams);
+						}
+						else {
+							for (Nd4jIndex e = chunk.start; e < chunk.end; e++) {
+								Nd4jIndex targetOffset = targetOffsets == nullptr ? e * targetStride : targetOffsets[e];
+								Nd4jIndex updateOffset = updatesOffsets == nullptr ? e * updatesStride : updatesOffsets[e];
+								row[targetOffset] = OpType::op(row[targetOffset], update[updateOffset], extraParams);
+							}
+						}
+					}
+				}
+
+				if (targetOffsets != nullptr)
+					delete[] targetOffsets;
+				if (updatesOffsets != nullptr)
+					delete[] updatesOffsets;
+			}
+
+			/**
+			 * Cuts the sorted updates into one chunk per target row, rows
+			 * with much more than their share of the work are split into
+			 * column ranges (of at least 64 elements)
+			 */
+			static void chunkRows(Nd4jIndex *indices, std::vector<Nd4jIndex> &order, Nd4jIndex rowLength, std::vector<ScatterChunk> &chunks) {
+				const Nd4jIndex numUpdates = (Nd4jIndex) order.size();
+				Nd4jIndex share = numUpdates * rowLength / (4 * omp_get_max_threads());
+				if (share < 8192)
+					share = 8192;
+
+				Nd4jIndex maxPieces = rowLength / 64;
+				if (maxPieces < 1)
+					maxPieces = 1;
+
+				Nd4jIndex first = 0;
+				while (first < numUpdates) {
+					Nd4jIndex row = indices[order[first]];
+					Nd4jIndex last = first + 1;
+					while (last < numUpdates && indices[order[last]] == row)
+						last++;
+
+					Nd4jIndex pieces = ((last - first) * rowLength + share - 1) / share;
+					if (pieces > maxPieces)
+						pieces = maxPieces;
+
+					Nd4jIndex pieceLength = (rowLength + pieces - 1) / pieces;
+					for (Nd4jIndex start = 0; start < rowLength; start += pieceLength) {
+						ScatterChunk chunk;
+						chunk.row = row;
+						chunk.first = first;
+						chunk.last = last;
+						chunk.start = start;
+						chunk.end = start + pieceLength < rowLength ? start + pieceLength : rowLength;
+						chunks.push_back(chunk);
+					}
+
+					first = last;
+				}
+			}
+
+		private:
+			struct IndexOrder {
+				Nd4jIndex *indices;
+
+				IndexOrder(Nd4jIndex *indices) : indices(indices) {}
+
+				inline bool operator()(Nd4jIndex a, Nd4jIndex b) const {
+					return indices[a] < indices[b] || (indices[a] == indices[b] && a < b);
+				}
+			};
+		};
+	}
+}
+
+#endif //LIBND4J_SCATTER_H
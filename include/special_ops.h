@@ -1,5 +1,7 @@
 #pragma once
 #include <ops.h>
+#include <pairwise_util.h>
+#include <isa_dispatch.h>
 
 namespace functions {
 	namespace broadcast {
@@ -424,13 +426,21 @@ namespace simdOps {
 		}
 #endif
 
+		/**
+		 * Gathers the columns back into the image: every row of the
+		 * image (example, depth, height) is owned by one thread, which
+		 * adds up all the patch elements that land on it, so rows are
+		 * distributed between threads without atomics even for a single
+		 * example with a single channel. Within a row the contributions
+		 * of every (kernel row, kernel column) are added for all patches
+		 * at once, walking both arrays with their strides.
+		 */
 		static void execSpecial(
 			T *dx,
 			int *xShapeBuffer,
 			T *result,
 			int *resultShapeBuffer,
 			T *extraParams) {
-			int inOffset = 0;
 			int *inShape = shape::shapeOf(xShapeBuffer);
 			int *inStride = shape::stride(xShapeBuffer);
 
@@ -442,125 +452,52 @@ namespace simdOps {
 			int padWidth = (int)extraParams[2];
 			int padHeight = (int)extraParams[3];
 
-
-			int exampleFrom = 0;
-			int exampleTo = inShape[0];
-			int depthFrom = 0;
-			int depthTo = inShape[1];
-
-			int outArrayOffset = 0;
 			int *outShape = shape::shapeOf(resultShapeBuffer);
 			int *outStride = shape::stride(resultShapeBuffer);
 
-
-			T *fIn = dx;
-			T *fOut = result;
-#pragma omp parallel for collapse(2)
-			for (int ex = exampleFrom; ex < exampleTo; ex++) {
-				for (int d = depthFrom; d < depthTo; d++) {
-					int outIndices[4];
-					int inIndices[6];
-
-					int inStride2 = inStride[2];
-					int inStride3 = inStride[3];
-					int outStride2 = outStride[2];
-					int outStride3 = outStride[3];
-					int outShape2 = outShape[2];
-					int outShape3 = outShape[3];
-
-					int yOutTo = inShape[4];
-					int xOutTo = inShape[5];
-
-
-					bool padding = padHeight > 0 || padWidth > 0;
-					inIndices[0] = ex;
-					inIndices[1] = d;
-					outIndices[0] = ex;
-					outIndices[1] = d;
-
-					for (int x = 0; x < xOutTo; x++) {  //Patch number along width
-						for (int y = 0; y < yOutTo; y++) {  //Patch number along height
-							inIndices[4] = y;   //patch number (along height)
-							inIndices[5] = x;   //patch number (along width)
-							int baseOffsetIn = getOffsetUnsafe6(inOffset, inShape, inStride, inIndices);
-
-							if (padding) {
-								int i = y * strideY -
-									padHeight;    //index along height of first element of patch in original img
-								int j = x * strideX -
-									padWidth;     //index along width of first element in patch in original img
-								outIndices[2] = i;  //along height
-								outIndices[3] = j;  //along width
-
-								int baseOffsetOut = getOffsetUnsafe4(outArrayOffset, outShape, outStride,
-									outIndices);
-
-								if (inStride2 <= inStride3) {
-									//Want dimension 2 (along height) in inner loop for cache efficiency
-									for (int patchX = 0; patchX < kernelWidth; patchX++) {
-										if (j + patchX < 0 || j + patchX >= outShape3)
-											continue;
-
-										for (int patchY = 0; patchY < kernelHeight; patchY++) {
-											if (i + patchY < 0 || i + patchY >= outShape2)
-												continue;
-											fOut[baseOffsetOut + patchY * outStride2 + patchX * outStride3] +=
-												fIn[baseOffsetIn + patchY * inStride2 + patchX * inStride3];
-										}
-									}
-								}
-								else {
-									//Want dimension 3 (along width) in inner loop for cache efficiency
-									for (int patchY = 0; patchY < kernelHeight; patchY++) {
-										if (i + patchY < 0 || i + patchY >= outShape2)
-											continue;
-										for (int patchX = 0; patchX < kernelWidth; patchX++) {
-											if (j + patchX < 0 || j + patchX >= outShape3)
-												continue;
-											fOut[baseOffsetOut + patchY * outStride2 + patchX * outStride3] +=
-												fIn[baseOffsetIn + patchY * inStride2 + patchX * inStride3];
-										}
-									}
-								}
-							}
-							else {
-								//No padding
-								int i = y *
-									strideY;    //index along height of first element of patch in output img
-								int j = x *
-									strideX;     //index along width of first element in patch in output img
-
-								outIndices[2] = i;
-								outIndices[3] = j;
-
-								int baseOffsetOut = getOffsetUnsafe4(outArrayOffset, outShape, outStride,
-									outIndices);
-
-								if (inStride2 <= inStride3) {
-									//Want dimension 2 (along height) in inner loop for cache efficiency
-									for (int patchX = 0; patchX < kernelWidth; patchX++) {
-										for (int patchY = 0; patchY < kernelHeight; patchY++) {
-											fOut[baseOffsetOut + patchY * outStride2 + patchX * outStride3] +=
-												fIn[baseOffsetIn + patchY * inStride2 + patchX * inStride3];
-										}
-									}
-								}
-								else {
-									//Want dimension 3 (along width) in inner loop for cache efficiency
-									for (int patchY = 0; patchY < kernelHeight; patchY++) {
-										for (int patchX = 0; patchX < kernelWidth; patchX++) {
-											fOut[baseOffsetOut + patchY * outStride2 + patchX * outStride3] +=
-												fIn[baseOffsetIn + patchY * inStride2 + patchX * inStride3];
-										}
-									}
-								}
-							}
-						}
+			int depth = outShape[1];
+			int imgHeight = outShape[2];
+			int imgWidth = outShape[3];
+			int yOutTo = inShape[4];
+			int xOutTo = inShape[5];
+
+			Nd4jIndex rows = (Nd4jIndex) outShape[0] * depth * imgHeight;
+
+#pragma omp parallel for schedule(static) if (rows > 1 && shape::length(xShapeBuffer) > 8192)
+			for (Nd4jIndex r = 0; r < rows; r++) {
+				int iy = (int) (r % imgHeight);
+				int d = (int) ((r / imgHeight) % depth);
+				int ex = (int) (r / ((Nd4jIndex) imgHeight * depth));
+
+				T *outRow = result + (Nd4jIndex) ex * outStride[0] + (Nd4jIndex) d * outStride[1] + (Nd4jIndex) iy * outStride[2];
+				T *in = dx + (Nd4jIndex) ex * inStride[0] + (Nd4jIndex) d * inStride[1];
+				Nd4jIndex outStepX = (Nd4jIndex) strideX * outStride[3];
+
+				for (int patchY = 0; patchY < kernelHeight; patchY++) {
+					//patch (along height) whose row patchY is this row
+					int y = iy + padHeight - patchY;
+					if (y < 0 || y % strideY != 0 || y / strideY >= yOutTo)
+						continue;
+
+					y /= strideY;
+					for (int patchX = 0; patchX < kernelWidth; patchX++) {
+						//patches (along width) whose column patchX lies within the image
+						int last = imgWidth - 1 + padWidth - patchX;
+						if (last < 0)
+							continue;
+
+						int xFrom = patchX < padWidth ? (padWidth - patchX + strideX - 1) / strideX : 0;
+						int xTo = last / strideX + 1 < xOutTo ? last / strideX + 1 : xOutTo;
+
+						T *patch = in + (Nd4jIndex) patchY * inStride[2] + (Nd4jIndex) patchX * inStride[3] + (Nd4jIndex) y * inStride[4];
+						T *out = outRow + (Nd4jIndex) (xFrom * strideX - padWidth + patchX) * outStride[3];
+						Nd4jIndex inStep = inStride[5];
+#pragma omp simd
+						for (int x = xFrom; x < xTo; x++)
+							out[(x - xFrom) * outStepX] += patch[x * inStep];
 					}
 				}
 			}
-
-
 		}
 
 		op_def static T op(T d1, T *params) {
@@ -610,6 +547,530 @@ namespace simdOps {
 
 
 
+	/**
+	 * Fused softmax along the rows of a matrix, all elements of a
+	 * vector, or the tensors along the given dimensions (TADs) of an
+	 * array of any rank.
+	 *
+	 * Every row is swept twice. The online pass keeps the running max
+	 * and the sum of exp(x - max) block by block, rescaling the sum
+	 * whenever a block raises the max, and already stores exp(x - shift)
+	 * with the shift (running max) of every block. The second pass
+	 * only rescales every block by exp(shift - max) / sum, so there is
+	 * one exp per element. Log softmax writes x - max - log(sum)
+	 * directly in the second pass.
+	 *
+	 * Rows are distributed between threads; when there are fewer rows
+	 * than threads the rows are split into chunks whose (max, sum)
+	 * pairs are merged before the second pass.
+	 */
+	template<typename T>
+	class SoftMaxRows {
+	public:
+		enum Output {
+			Probabilities,
+			LogProbabilities,
+			Derivative
+		};
+
+		/**
+		 * Without extraParams (or with extraParams[0] == 0) softmax runs
+		 * along the rows of a matrix, or the whole of a vector. Otherwise
+		 * extraParams holds the number of dimensions followed by the
+		 * dimensions to run along (negative ones count from the back,
+		 * MAX_DIMENSION for the whole array), as for IsMax.
+		 *
+		 * @param output softmax, log softmax or softmax * (1 - softmax)
+		 * @param dx the input
+		 * @param xShapeBuffer the shape information for the input
+		 * @param result the result buffer, may be dx
+		 * @param resultShapeBuffer the shape information for the result
+		 * @param extraParams the dimensions, may be null
+		 */
+		static void exec(Output output, T *dx, int *xShapeBuffer, T *result, int *resultShapeBuffer, T *extraParams) {
+			int rank = shape::rank(xShapeBuffer);
+			int *xShape = shape::shapeOf(xShapeBuffer);
+			int *xStride = shape::stride(xShapeBuffer);
+			int *resultStride = shape::stride(resultShapeBuffer);
+
+			if (extraParams != nullptr && extraParams[0] >= 1) {
+				// dimensions of length 1 don't change the grouping, they are dropped
+				// (TADs of vectors along their only long dimension aren't usable)
+				int dimensionLength = 0;
+				int dimension[MAX_RANK];
+				bool wholeArray = false;
+				for (int i = 0; i < (int) extraParams[0]; i++) {
+					if (extraParams[i + 1] == (T) MAX_DIMENSION) {
+						wholeArray = true;
+						break;
+					}
+
+					int d = (int) extraParams[i + 1];
+					if (d < 0)
+						d += rank;
+					if (d < 0 || d >= rank) {
+						printf("SoftMax: dimension [%d] is out of range for rank [%d]\n", (int) extraParams[i + 1], rank);
+						return;
+					}
+
+					bool seen = false;
+					for (int j = 0; j < dimensionLength; j++)
+						seen |= dimension[j] == d;
+					if (xShape[d] != 1 && !seen)
+						dimension[dimensionLength++] = d;
+				}
+
+				int longDimensions = 0;
+				for (int i = 0; i < rank; i++)
+					longDimensions += xShape[i] != 1;
+				wholeArray |= dimensionLength == longDimensions;
+
+				if (!wholeArray && dimensionLength == 0) {
+					// every element is on its own
+					T value = output == Probabilities ? (T) 1.0 : (T) 0.0;
+					Nd4jIndex length = shape::length(xShapeBuffer);
+					int resultElementWiseStride = shape::elementWiseStride(resultShapeBuffer);
+					if (resultElementWiseStride >= 1) {
+#pragma omp parallel for simd schedule(static) if (length > 8192)
+						for (Nd4jIndex e = 0; e < length; e++)
+							result[e * resultElementWiseStride] = value;
+						return;
+					}
+
+					// the order doesn't matter either, result is walked in its own memory order
+					StridedIterator walker(rank, xShape, resultStride, resultStride);
+					TadBlockInformation info(1, length, 8192);
+#pragma omp parallel for schedule(static) if (info.chunksPerTad > 1)
+					for (int c = 0; c < info.chunksPerTad; c++) {
+						auto visitor = [&](T *x, Nd4jIndex xStep, T *z, Nd4jIndex zStep, Nd4jIndex count) {
+#pragma omp simd
+							for (Nd4jIndex i = 0; i < count; i++)
+								z[i * zStep] = value;
+						};
+						visitRuns(result, result, walker, info.chunkStart(c), info.chunkEnd(c), visitor);
+					}
+					return;
+				}
+
+				int xElementWiseStride = shape::elementWiseStride(xShapeBuffer);
+				int resultElementWiseStride = shape::elementWiseStride(resultShapeBuffer);
+				if (wholeArray && xElementWiseStride >= 1 && resultElementWiseStride >= 1 && shape::order(xShapeBuffer) == shape::order(resultShapeBuffer)) {
+					// the order of the elements doesn't matter
+					execRows(output, 1, shape::length(xShapeBuffer), dx, nullptr, 0, xElementWiseStride, result, nullptr, 0, resultElementWiseStride);
+				}
+				else if (wholeArray) {
+					execStrided(output, rank, xShape, dx, xStride, result, resultStride);
+				}
+				else {
+					execAlong(output, dx, xShapeBuffer, result, resultShapeBuffer, dimension, dimensionLength);
+				}
+
+				return;
+			}
+
+			if (rank == 1 || (rank == 2 && (xShape[0] == 1 || xShape[1] == 1))) {
+				int d = rank == 1 || xShape[0] != 1 ? 0 : 1;
+				execRows(output, 1, xShape[d], dx, nullptr, 0, xStride[d], result, nullptr, 0, resultStride[d]);
+			}
+			else if (rank == 2) {
+				execRows(output, xShape[0], xShape[1], dx, nullptr, xStride[0], xStride[1], result, nullptr, resultStride[0], resultStride[1]);
+			}
+		}
+
+		/**
+		 * Softmax along the TADs of the given dimensions
+		 */
+		static void execAlong(Output output, T *dx, int *xShapeBuffer, T *result, int *resultShapeBuffer, int *dimension, int dimensionLength) {
+			shape::TAD xTad(xShapeBuffer, dimension, dimensionLength);
+			xTad.createTadOnlyShapeInfo();
+			xTad.createOffsets();
+
+			int *xTadShapeInfo = xTad.tadOnlyShapeInfo;
+			bool sameStrides = true;
+			for (int i = 0; i < shape::rank(xShapeBuffer); i++)
+				sameStrides &= shape::stride(xShapeBuffer)[i] == shape::stride(resultShapeBuffer)[i];
+
+			if (sameStrides) {
+				execTads(output, xTad.numTads, shape::rank(xTadShapeInfo), shape::shapeOf(xTadShapeInfo),
+						 dx, xTad.tadOffsets, shape::stride(xTadShapeInfo), result, xTad.tadOffsets, shape::stride(xTadShapeInfo));
+				return;
+			}
+
+			shape::TAD resultTad(resultShapeBuffer, dimension, dimensionLength);
+			resultTad.createTadOnlyShapeInfo();
+			resultTad.createOffsets();
+
+			execTads(output, xTad.numTads, shape::rank(xTadShapeInfo), shape::shapeOf(xTadShapeInfo),
+					 dx, xTad.tadOffsets, shape::stride(xTadShapeInfo), result, resultTad.tadOffsets, shape::stride(resultTad.tadOnlyShapeInfo));
+		}
+
+		/**
+		 * Softmax over each of numTads tensors of the given shape
+		 * starting at xOffsets / resultOffsets. Tensors that aren't a
+		 * constant stride apart element to element are gathered into a
+		 * contiguous buffer, processed there and scattered back.
+		 */
+		static void execTads(Output output, int numTads, int tadRank, int *tadShape,
+							 T *dx, int *xOffsets, int *xTadStride,
+							 T *result, int *resultOffsets, int *resultTadStride) {
+			Nd4jIndex tadLength = 1;
+			for (int i = 0; i < tadRank; i++)
+				tadLength *= tadShape[i];
+
+			if (numTads < 1 || tadLength < 1)
+				return;
+
+			int xElementStride;
+			int resultElementStride;
+			Nd4jIndex *xElementOffsets = cOrderElementOffsets(tadRank, tadShape, xTadStride, tadLength, xElementStride);
+			Nd4jIndex *resultElementOffsets = cOrderElementOffsets(tadRank, tadShape, resultTadStride, tadLength, resultElementStride);
+
+			if (xElementOffsets == nullptr && resultElementOffsets == nullptr) {
+				execRows(output, numTads, tadLength, dx, xOffsets, 0, xElementStride, result, resultOffsets, 0, resultElementStride);
+				return;
+			}
+
+#pragma omp parallel if (numTads > 1 && numTads * tadLength > 8192)
+			{
+				std::vector<T> buffer(tadLength);
+				std::vector<T> shifts(numBlocks(tadLength));
+
+#pragma omp for schedule(guided)
+				for (int i = 0; i < numTads; i++) {
+					T *x = dx + xOffsets[i];
+					T *z = result + resultOffsets[i];
+					for (Nd4jIndex e = 0; e < tadLength; e++)
+						buffer[e] = x[xElementOffsets == nullptr ? e * xElementStride : xElementOffsets[e]];
+
+					T max, sum;
+					online(output, buffer.data(), 1, buffer.data(), 1, 0, tadLength, shifts.data(), max, sum);
+					normalise(output, buffer.data(), 1, buffer.data(), 1, 0, tadLength, shifts.data(), max, sum);
+
+					for (Nd4jIndex e = 0; e < tadLength; e++)
+						z[resultElementOffsets == nullptr ? e * resultElementStride : resultElementOffsets[e]] = buffer[e];
+				}
+			}
+
+			if (xElementOffsets != nullptr)
+				delete[] xElementOffsets;
+			if (resultElementOffsets != nullptr)
+				delete[] resultElementOffsets;
+		}
+
+		/**
+		 * Softmax over rows elements elementStride apart. Row r starts at
+		 * offsets[r], or at r * rowStride when offsets is null.
+		 */
+		static void execRows(Output output, Nd4jIndex rows, Nd4jIndex rowLength,
+							 T *dx, int *xOffsets, Nd4jIndex xRowStride, Nd4jIndex xElementStride,
+							 T *result, int *resultOffsets, Nd4jIndex resultRowStride, Nd4jIndex resultElementStride) {
+			if (rows < 1 || rowLength < 1)
+				return;
+
+			TadBlockInformation info(rows, rowLength, 4096);
+			if (!info.isSplit()) {
+#pragma omp parallel if (rows > 1 && rows * rowLength > 8192)
+				{
+					std::vector<T> shifts(numBlocks(rowLength));
+
+#pragma omp for schedule(guided)
+					for (Nd4jIndex r = 0; r < rows; r++) {
+						T *x = dx + rowOffset(xOffsets, xRowStride, r);
+						T *z = result + rowOffset(resultOffsets, resultRowStride, r);
+						T max, sum;
+						online(output, x, xElementStride, z, resultElementStride, 0, rowLength, shifts.data(), max, sum);
+						normalise(output, x, xElementStride, z, resultElementStride, 0, rowLength, shifts.data(), max, sum);
+					}
+				}
+
+				return;
+			}
+
+			const Nd4jIndex numChunks = info.numChunks();
+			const Nd4jIndex chunkBlocks = numBlocks(info.chunkLength);
+			std::vector<T> maxes(numChunks);
+			std::vector<T> sums(numChunks);
+			std::vector<T> shifts(numChunks * chunkBlocks);
+
+#pragma omp parallel for schedule(static)
+			for (Nd4jIndex c = 0; c < numChunks; c++) {
+				Nd4jIndex r = c / info.chunksPerTad;
+				int chunk = (int) (c % info.chunksPerTad);
+				online(output, dx + rowOffset(xOffsets, xRowStride, r), xElementStride, result + rowOffset(resultOffsets, resultRowStride, r), resultElementStride,
+					   info.chunkStart(chunk), info.chunkEnd(chunk), shifts.data() + c * chunkBlocks, maxes[c], sums[c]);
+			}
+
+			for (Nd4jIndex r = 0; r < rows; r++) {
+				for (int chunk = 1; chunk < info.chunksPerTad; chunk++)
+					merge(maxes[r * info.chunksPerTad], sums[r * info.chunksPerTad], maxes[r * info.chunksPerTad + chunk], sums[r * info.chunksPerTad + chunk]);
+			}
+
+#pragma omp parallel for schedule(static)
+			for (Nd4jIndex c = 0; c < numChunks; c++) {
+				Nd4jIndex r = c / info.chunksPerTad;
+				int chunk = (int) (c % info.chunksPerTad);
+				normalise(output, dx + rowOffset(xOffsets, xRowStride, r), xElementStride, result + rowOffset(resultOffsets, resultRowStride, r), resultElementStride,
+						  info.chunkStart(chunk), info.chunkEnd(chunk), shifts.data() + c * chunkBlocks, maxes[r * info.chunksPerTad], sums[r * info.chunksPerTad]);
+			}
+		}
+
+		/**
+		 * Softmax over the whole of an array whose elements aren't a
+		 * constant stride apart. The runs of a StridedIterator over x and
+		 * result are cut into chunks the way a long row is split between
+		 * threads. The max is taken first, so the pass taking the sum can
+		 * store exp(x - max) and a third pass only scales it.
+		 */
+		static void execStrided(Output output, int rank, int *shape, T *dx, int *xStride, T *result, int *resultStride) {
+			Nd4jIndex length = 1;
+			for (int i = 0; i < rank; i++)
+				length *= shape[i];
+
+			if (length < 1)
+				return;
+
+			StridedIterator walker(rank, shape, xStride, resultStride);
+			TadBlockInformation info(1, length, 4096);
+			const int numChunks = info.chunksPerTad;
+			std::vector<T> maxes(numChunks);
+			std::vector<T> sums(numChunks);
+
+#pragma omp parallel for schedule(static) if (numChunks > 1)
+			for (int c = 0; c < numChunks; c++) {
+				bool empty = true;
+				T max = (T) 0.0;
+				auto visitor = [&](T *x, Nd4jIndex xStep, T *z, Nd4jIndex zStep, Nd4jIndex count) {
+					if (empty) {
+						max = x[0];
+						empty = false;
+					}
+
+					T runMax = max;
+#pragma omp simd reduction(max:runMax)
+					for (Nd4jIndex i = 0; i < count; i++)
+						runMax = nd4j::math::nd4j_max<T>(runMax, x[i * xStep]);
+					max = runMax;
+				};
+				visitRuns(dx, result, walker, info.chunkStart(c), info.chunkEnd(c), visitor);
+				maxes[c] = max;
+			}
+
+			T max = maxes[0];
+			for (int c = 1; c < numChunks; c++)
+				max = nd4j::math::nd4j_max<T>(max, maxes[c]);
+
+#pragma omp parallel for schedule(static) if (numChunks > 1)
+			for (int c = 0; c < numChunks; c++) {
+				T sum = (T) 0.0;
+				auto visitor = [&](T *x, Nd4jIndex xStep, T *z, Nd4jIndex zStep, Nd4jIndex count) {
+					T runSum = (T) 0.0;
+					if (output == LogProbabilities) {
+#pragma omp simd reduction(+:runSum)
+						for (Nd4jIndex i = 0; i < count; i++)
+							runSum += nd4j::math::nd4j_fastexp<T>(x[i * xStep] - max);
+					}
+					else {
+#pragma omp simd reduction(+:runSum)
+						for (Nd4jIndex i = 0; i < count; i++) {
+							T e = nd4j::math::nd4j_fastexp<T>(x[i * xStep] - max);
+							z[i * zStep] = e;
+							runSum += e;
+						}
+					}
+					sum += runSum;
+				};
+				visitRuns(dx, result, walker, info.chunkStart(c), info.chunkEnd(c), visitor);
+				sums[c] = sum;
+			}
+
+			T sum = (T) 0.0;
+			for (int c = 0; c < numChunks; c++)
+				sum += sums[c];
+
+			const T shift = max + nd4j::math::nd4j_fastlog<T>(sum);
+			const T scale = (T) 1.0 / sum;
+
+#pragma omp parallel for schedule(static) if (numChunks > 1)
+			for (int c = 0; c < numChunks; c++) {
+				auto visitor = [&](T *x, Nd4jIndex xStep, T *z, Nd4jIndex zStep, Nd4jIndex count) {
+					if (output == LogProbabilities) {
+#pragma omp simd
+						for (Nd4jIndex i = 0; i < count; i++)
+							z[i * zStep] = x[i * xStep] - shift;
+					}
+					else if (output == Derivative) {
+#pragma omp simd
+						for (Nd4jIndex i = 0; i < count; i++) {
+							T p = z[i * zStep] * scale;
+							z[i * zStep] = p * ((T) 1.0 - p);
+						}
+					}
+					else {
+#pragma omp simd
+						for (Nd4jIndex i = 0; i < count; i++)
+							z[i * zStep] *= scale;
+					}
+				};
+				visitRuns(dx, result, walker, info.chunkStart(c), info.chunkEnd(c), visitor);
+			}
+		}
+
+		/**
+		 * Calls visitor(x, xStep, z, zStep, count) for the runs of
+		 * elements [start, end) in the visiting order of walker, whose
+		 * operands are x and result
+		 */
+		template<typename Visitor>
+		static inline void visitRuns(T *dx, T *result, const StridedIterator &walker, Nd4jIndex start, Nd4jIndex end, Visitor &visitor) {
+			StridedIterator iter = walker;
+			const Nd4jIndex innerLength = iter.innerLength();
+			const Nd4jIndex xStep = iter.innerStride(0);
+			const Nd4jIndex resultStep = iter.innerStride(1);
+			Nd4jIndex first = start % innerLength;
+			iter.seek(start / innerLength);
+
+			for (Nd4jIndex remaining = end - start; remaining > 0; iter.next()) {
+				Nd4jIndex last = first + remaining < innerLength ? first + remaining : innerLength;
+				visitor(dx + iter.offsets[0] + first * xStep, xStep, result + iter.offsets[1] + first * resultStep, resultStep, last - first);
+				remaining -= last - first;
+				first = 0;
+			}
+		}
+
+		static inline Nd4jIndex rowOffset(int *offsets, Nd4jIndex rowStride, Nd4jIndex row) {
+			return offsets != nullptr ? offsets[row] : row * rowStride;
+		}
+
+		/**
+		 * Number of blocks (and shifts) of a range of the given length
+		 */
+		static inline Nd4jIndex numBlocks(Nd4jIndex length) {
+			return (length + blockLength - 1) / blockLength;
+		}
+
+		/**
+		 * First pass over elements [start, end) of a row: their max and
+		 * the sum of exp(x - max). Unless output is LogProbabilities it
+		 * also stores exp(x - shifts[k]) into result for every block k.
+		 */
+		static inline void online(Output output, T *x, Nd4jIndex xStride, T *result, Nd4jIndex resultStride, Nd4jIndex start, Nd4jIndex end, T *shifts, T &max, T &sum) {
+			if (xStride == 1 && resultStride == 1)
+				onlineBlocks<true>(output, x, 1, result, 1, start, end, shifts, max, sum);
+			else
+				onlineBlocks<false>(output, x, xStride, result, resultStride, start, end, shifts, max, sum);
+		}
+
+		/**
+		 * Folds the (max, sum) of another part of a row into max and sum
+		 */
+		static inline void merge(T &max, T &sum, T otherMax, T otherSum) {
+			if (otherMax > max) {
+				sum = sum * nd4j::math::nd4j_fastexp<T>(max - otherMax) + otherSum;
+				max = otherMax;
+			}
+			else {
+				sum += otherSum * nd4j::math::nd4j_fastexp<T>(otherMax - max);
+			}
+		}
+
+		/**
+		 * Second pass over elements [start, end), given the max and sum
+		 * of the whole row and the shifts the first pass stored
+		 */
+		static inline void normalise(Output output, T *x, Nd4jIndex xStride, T *result, Nd4jIndex resultStride, Nd4jIndex start, Nd4jIndex end, T *shifts, T max, T sum) {
+			if (xStride == 1 && resultStride == 1)
+				normaliseBlocks<true>(output, x, 1, result, 1, start, end, shifts, max, sum);
+			else
+				normaliseBlocks<false>(output, x, xStride, result, resultStride, start, end, shifts, max, sum);
+		}
+
+	private:
+		/**
+		 * Short enough for a block to stay in L1 between its max and its
+		 * sum
+		 */
+		static const Nd4jIndex blockLength = 1024;
+
+		/*
+		 * The kernels are instantiated for unit strides separately (a
+		 * runtime stride of 1 doesn't make for contiguous vector loads)
+		 * and carry the ISA dispatch themselves, so the exp inlined into
+		 * them is compiled for the widest vectors available
+		 */
+		template<bool contiguous>
+		ND4J_ISA_DISPATCH
+		static void onlineBlocks(Output output, T *x, Nd4jIndex xStride, T *result, Nd4jIndex resultStride, Nd4jIndex start, Nd4jIndex end, T *shifts, T &max, T &sum) {
+			const Nd4jIndex xStep = contiguous ? 1 : xStride;
+			const Nd4jIndex resultStep = contiguous ? 1 : resultStride;
+			max = x[start * xStep];
+			sum = (T) 0.0;
+			for (Nd4jIndex b = start; b < end; b += blockLength) {
+				Nd4jIndex blockEnd = b + blockLength < end ? b + blockLength : end;
+				T blockMax = x[b * xStep];
+#pragma omp simd reduction(max:blockMax)
+				for (Nd4jIndex i = b; i < blockEnd; i++)
+					blockMax = nd4j::math::nd4j_max<T>(blockMax, x[i * xStep]);
+
+				if (blockMax > max) {
+					sum *= nd4j::math::nd4j_fastexp<T>(max - blockMax);
+					max = blockMax;
+				}
+
+				T blockSum = (T) 0.0;
+				const T shift = max;
+				if (output == LogProbabilities) {
+#pragma omp simd reduction(+:blockSum)
+					for (Nd4jIndex i = b; i < blockEnd; i++)
+						blockSum += nd4j::math::nd4j_fastexp<T>(x[i * xStep] - shift);
+				}
+				else {
+					shifts[(b - start) / blockLength] = shift;
+#pragma omp simd reduction(+:blockSum)
+					for (Nd4jIndex i = b; i < blockEnd; i++) {
+						T e = nd4j::math::nd4j_fastexp<T>(x[i * xStep] - shift);
+						result[i * resultStep] = e;
+						blockSum += e;
+					}
+				}
+
+				sum += blockSum;
+			}
+		}
+
+		template<bool contiguous>
+		ND4J_ISA_DISPATCH
+		static void normaliseBlocks(Output output, T *x, Nd4jIndex xStride, T *result, Nd4jIndex resultStride, Nd4jIndex start, Nd4jIndex end, T *shifts, T max, T sum) {
+			const Nd4jIndex xStep = contiguous ? 1 : xStride;
+			const Nd4jIndex resultStep = contiguous ? 1 : resultStride;
+			if (output == LogProbabilities) {
+				const T shift = max + nd4j::math::nd4j_fastlog<T>(sum);
+#pragma omp simd
+				for (Nd4jIndex i = start; i < end; i++)
+					result[i * resultStep] = x[i * xStep] - shift;
+
+				return;
+			}
+
+			for (Nd4jIndex b = start; b < end; b += blockLength) {
+				Nd4jIndex blockEnd = b + blockLength < end ? b + blockLength : end;
+				const T scale = nd4j::math::nd4j_fastexp<T>(shifts[(b - start) / blockLength] - max) / sum;
+				if (output == Derivative) {
+#pragma omp simd
+					for (Nd4jIndex i = b; i < blockEnd; i++) {
+						T p = result[i * resultStep] * scale;
+						result[i * resultStep] = p * ((T) 1.0 - p);
+					}
+				}
+				else {
+#pragma omp simd
+					for (Nd4jIndex i = b; i < blockEnd; i++)
+						result[i * resultStep] *= scale;
+				}
+			}
+		}
+	};
+
+
 	template<typename T>
 	class SoftMax {
 	public:
@@ -676,94 +1137,7 @@ namespace simdOps {
 			T *result,
 			int *resultShapeBuffer,
 			T *extraParams) {
-			if (shape::isMatrix(xShapeBuffer)) {
-				int *shape = shape::shapeOf(xShapeBuffer);
-				//iterate along rows
-				int dimension[1] = { 0 };
-				int maxDimension[1] = { 1 };
-				//compute the row wise maxes
-				std::vector <T> maxResult(shape[0]);
-				for (int i = 0; i < shape[0]; i++)
-					maxResult[i] = 0.0;
-				int maxShape[2] = { shape[0], 1 };
-				int *maxResultShapeBuffer = shape::shapeBuffer(2, maxShape);
-				functions::reduce::ReduceFunction<T>::template exec<simdOps::Max<T>>(dx, xShapeBuffer, extraParams, maxResult.data(), maxResultShapeBuffer, maxDimension, 1,
-					nullptr, nullptr);
-
-				//subtract max of each row
-				functions::broadcast::Broadcast<T>::template exec<simdOps::Subtract<T>>(result, resultShapeBuffer, maxResult.data(), maxResultShapeBuffer, result, dimension, 1,
-					nullptr, nullptr);
-
-				//after subtracting the row wise maxes take the exp
-				functions::transform::Transform<T>::template exec<simdOps::Exp<T>>(result, resultShapeBuffer, result, resultShapeBuffer, extraParams);
-
-				//take the sum for the exponential
-				functions::reduce::ReduceFunction<T>::template exec<simdOps::Sum<T>>(result, resultShapeBuffer, extraParams, maxResult.data(), maxResultShapeBuffer, maxDimension, 1,
-					nullptr, nullptr);
-
-				//divide by the sum
-				functions::broadcast::Broadcast<T>::template exec<simdOps::Divide<T>>(result, resultShapeBuffer, maxResult.data(), maxResultShapeBuffer, result, dimension, 1,
-					nullptr, nullptr);
-
-				delete[] maxResultShapeBuffer;
-			}
-			else if (shape::isVector(xShapeBuffer)) {
-				T max = 0;
-				T sum = 0;
-				int elementWiseStride = shape::elementWiseStride(xShapeBuffer);
-				int resultElementWiseStride = shape::elementWiseStride(resultShapeBuffer);
-				int length = shape::length(xShapeBuffer);
-				if (elementWiseStride >= 1 && resultElementWiseStride >= 1) {
-					if (elementWiseStride == 1 && resultElementWiseStride == 1) {
-						for (int i = 0; i < length; i++) {
-							max = nd4j::math::nd4j_max<T>(max, dx[i]);
-						}
-
-
-						for (int i = 0; i < length; i++) {
-							result[i] = dx[i] - max;
-						}
-
-						for (int i = 0; i < length; i++) {
-							result[i] = nd4j::math::nd4j_exp<T>(result[i]);
-						}
-
-
-						for (int i = 0; i < length; i++) {
-							sum += result[i];
-						}
-
-
-						for (int i = 0; i < length; i++) {
-							result[i] /= sum;
-						}
-
-
-					}
-					else {
-
-						for (int i = 0; i < length; i++) {
-							max = nd4j::math::nd4j_max<T>(max, dx[i * elementWiseStride]);
-						}
-						for (int i = 0; i < length; i++) {
-							result[i * resultElementWiseStride] = dx[i * elementWiseStride] - max;
-						}
-						for (int i = 0; i < length; i++) {
-							result[i * resultElementWiseStride] = nd4j::math::nd4j_exp<T>(
-								result[i * resultElementWiseStride]);
-						}
-						for (int i = 0; i < length; i++) {
-							sum += result[i * resultElementWiseStride];
-						}
-						for (int i = 0; i < length; i++) {
-							result[i * resultElementWiseStride] /= sum;
-						}
-					}
-
-				}
-
-
-			}
+			SoftMaxRows<T>::exec(SoftMaxRows<T>::Probabilities, dx, xShapeBuffer, result, resultShapeBuffer, extraParams);
 		}
 
 		op_def static T op(T d1, T *params) {
@@ -838,87 +1212,7 @@ namespace simdOps {
 			T *result,
 			int *resultShapeBuffer,
 			T *extraParams) {
-
-			if (shape::isMatrix(xShapeBuffer, 2)) {
-				int *shape = shape::shapeOf(xShapeBuffer);
-				//iterate along rows
-				int dimension[1] = { 0 };
-				int maxDimension[1] = { 1 };
-				//compute the row wise maxes
-				std::vector <T> maxResult(shape[0]);
-				for (int i = 0; i < shape[0]; i++)
-					maxResult[i] = 0.0;
-				int maxShape[2] = { shape[0], 1 };
-				int *maxResultShapeBuffer = shape::shapeBuffer(2, maxShape);
-				functions::reduce::ReduceFunction<T>::template exec<simdOps::Max<T>>(dx, xShapeBuffer, extraParams, maxResult.data(), maxResultShapeBuffer, maxDimension, 1,
-					nullptr, nullptr);
-
-				//subtract max of each row
-				functions::broadcast::Broadcast<T>::template exec<simdOps::Subtract<T>>(result, resultShapeBuffer, maxResult.data(), maxResultShapeBuffer, result, dimension, 1,
-					nullptr, nullptr);
-
-				//after subtracting the row wise maxes take the exp
-				functions::transform::Transform<T>::template exec<simdOps::Exp<T>>(result, resultShapeBuffer, result, resultShapeBuffer, extraParams);
-
-				//take the sum for the exponential
-				functions::reduce::ReduceFunction<T>::template exec<simdOps::Sum<T>>(result, resultShapeBuffer, extraParams, maxResult.data(), maxResultShapeBuffer, maxDimension, 1,
-					nullptr, nullptr);
-
-				//divide by the sum
-				functions::broadcast::Broadcast<T>::template exec<simdOps::Divide<T>>(result, resultShapeBuffer, maxResult.data(), maxResultShapeBuffer, result, dimension, 1,
-					nullptr, nullptr);
-
-				functions::transform::Transform<T>::template exec<simdOps::Log<T>>(result, resultShapeBuffer, result, resultShapeBuffer, extraParams);
-
-
-
-				delete[] maxResultShapeBuffer;
-			}
-			else if (shape::isVector(xShapeBuffer, 2)) {
-				T max = 0;
-				T sum = 0;
-
-				int elementWiseStride = shape::elementWiseStride(xShapeBuffer);
-				int length = shape::length(xShapeBuffer);
-				if (elementWiseStride == 1) {
-#pragma omp parallel for simd reduction(max:max) shared(result)
-					for (int i = 0; i < length; i++) {
-						max = nd4j::math::nd4j_max<T>(max, result[i]);
-					}
-
-#pragma omp parallel for simd reduction(+:sum)  shared(result)
-					for (int i = 0; i < length; i++) {
-						result[i] -= max;
-						result[i] = nd4j::math::nd4j_exp<T>(result[i]);
-						sum += result[i];
-					}
-
-#pragma omp parallel for simd
-					for (int i = 0; i < length; i++) {
-						result[i] /= sum;
-						result[i] = nd4j::math::nd4j_log<T>(result[i]);
-					}
-				}
-				else {
-#pragma omp parallel for simd reduction(max:max) shared(result, elementWiseStride)
-					for (int i = 0; i < length; i++) {
-						max = nd4j::math::nd4j_max<T>(max, result[i * elementWiseStride]);
-					}
-
-#pragma omp parallel for simd reduction(+:sum)  shared(result, elementWiseStride)
-					for (int i = 0; i < length; i++) {
-						result[i * elementWiseStride] -= max;
-						result[i * elementWiseStride] = nd4j::math::nd4j_exp<T>(result[i * elementWiseStride]);
-						sum += result[i * elementWiseStride];
-					}
-
-#pragma omp parallel for simd
-					for (int i = 0; i < length; i++) {
-						result[i * elementWiseStride] /= sum;
-						result[i * elementWiseStride] = nd4j::math::nd4j_log<T>(result[i * elementWiseStride]);
-					}
-				}
-			}
+			SoftMaxRows<T>::exec(SoftMaxRows<T>::LogProbabilities, dx, xShapeBuffer, result, resultShapeBuffer, extraParams);
 		}
 
 		op_def static T op(T d1, T *params) {
@@ -1008,111 +1302,7 @@ namespace simdOps {
 			T *result,
 			int *resultShapeBuffer,
 			T *extraParams) {
-			if (shape::isMatrix(xShapeBuffer, 2)) {
-				int *shape = shape::shapeOf(xShapeBuffer);
-
-				int resultEleStide = shape::elementWiseStride(resultShapeBuffer);
-
-				//iterate along rows
-				int dimension[1] = { 0 };
-				int maxDimension[1] = { 1 };
-				int len = shape::length(xShapeBuffer);
-				//compute the row wise maxes
-				std::vector <T> maxResult(shape[0]);
-#pragma omp simd
-				for (int i = 0; i < shape[0]; i++)
-					maxResult[i] = 0.0;
-				int maxShape[2] = { shape[0], 1 };
-				int *maxResultShapeBuffer = shape::shapeBuffer(2, maxShape);
-				functions::reduce::ReduceFunction<T>::template exec<simdOps::Max<T>>(dx, xShapeBuffer, extraParams, maxResult.data(), maxResultShapeBuffer, maxDimension, 1,
-					nullptr, nullptr);
-
-				//subtract max of each row
-				functions::broadcast::Broadcast<T>::template exec<simdOps::Subtract<T>>(result, resultShapeBuffer, maxResult.data(), maxResultShapeBuffer, result, dimension, 1,
-					nullptr, nullptr);
-
-				//after subtracting the row wise maxes take the exp
-				functions::transform::Transform<T>::template exec<simdOps::Exp<T>>(result, resultShapeBuffer, result, resultShapeBuffer, extraParams);
-
-				//take the sum for the exponential
-				functions::reduce::ReduceFunction<T>::template exec<simdOps::Sum<T>>(result, resultShapeBuffer, extraParams, maxResult.data(), maxResultShapeBuffer, maxDimension,
-					1, nullptr, nullptr);
-
-				//divide by the sum
-				functions::broadcast::Broadcast<T>::template exec<simdOps::Divide<T>>(result, resultShapeBuffer, maxResult.data(), maxResultShapeBuffer, result, dimension, 1, nullptr, nullptr);
-
-				if (resultEleStide >= 1) {
-					if (resultEleStide == 1) {
-#pragma omp simd
-						for (int i = 0; i < len; i++) {
-							result[i] = result[i] * (1 - result[i]);
-						}
-
-					}
-					else {
-#pragma omp simd
-						for (int i = 0; i < len; i++) {
-							result[i * resultEleStide] = result[i * resultEleStide] * (1 - result[i * resultEleStide]);
-						}
-
-					}
-				}
-
-				else {
-					printf("Non element wise stride not supported right now\n");
-				}
-
-
-				delete[] maxResultShapeBuffer;
-			}
-			else if (shape::isVector(xShapeBuffer, 2)) {
-				T max = 0;
-				T sum = 0;
-
-				int elementWiseStride = shape::elementWiseStride(xShapeBuffer);
-				int length = shape::length(xShapeBuffer);
-				if (elementWiseStride == 1) {
-
-#pragma omp parallel for simd reduction(max:max) shared(result) schedule(guided)
-					for (int i = 0; i < length; i++) {
-						max = nd4j::math::nd4j_max<T>(max, result[i]);
-					}
-
-#pragma omp parallel for simd reduction(+:sum)  shared(result) schedule(guided)
-					for (int i = 0; i < length; i++) {
-						result[i] -= max;
-						result[i] = nd4j::math::nd4j_exp<T>(result[i]);
-						sum += result[i];
-					}
-
-#pragma omp parallel for simd schedule(guided)
-					for (int i = 0; i < length; i++) {
-						result[i] /= sum;
-					}
-
-				}
-				else {
-
-#pragma omp parallel for simd reduction(max:max) shared(result) schedule(guided)
-					for (int i = 0; i < length; i++) {
-						max = nd4j::math::nd4j_max<T>(max, result[i * elementWiseStride]);
-					}
-
-
-#pragma omp parallel for simd reduction(+:sum) shared(result, elementWiseStride) schedule(guided)
-					for (int i = 0; i < length; i++) {
-						result[i * elementWiseStride] -= max;
-						result[i * elementWiseStride] = nd4j::math::nd4j_exp<T>(result[i * elementWiseStride]);
-						sum += result[i * elementWiseStride];
-					}
-
-#pragma omp parallel for simd schedule(guided)
-					for (int i = 0; i < length; i++) {
-						result[i * elementWiseStride] /= sum;
-					}
-
-				}
-			}
+			SoftMaxRows<T>::exec(SoftMaxRows<T>::Derivative, dx, xShapeBuffer, result, resultShapeBuffer, extraParams);
 		}
 
 		op_def static T op(T d1, T *params) {
@@ -1170,6 +1360,79 @@ namespace simdOps {
 		}
 #endif
 
+		/**
+		 * First maximum of elements [start, end) of x
+		 */
+		static inline functions::indexreduce::IndexValue<T> firstMax(T *x, int xStride, Nd4jIndex start, Nd4jIndex end) {
+			functions::indexreduce::IndexValue<T> best;
+			best.value = x[start * xStride];
+			best.index = (unsigned int) start;
+			for (Nd4jIndex i = start + 1; i < end; i++) {
+				if (best.value < x[i * xStride]) {
+					best.value = x[i * xStride];
+					best.index = (unsigned int) i;
+				}
+			}
+
+			return best;
+		}
+
+		/**
+		 * Sets every tad of result to one at the first maximum of the
+		 * matching tad of x and to zero everywhere else.
+		 *
+		 * Long tads are split between threads (see TadBlockInformation),
+		 * per chunk maxima are merged in a fixed pairwise tree in which the
+		 * lower index wins ties, so the result doesn't depend on the number
+		 * of threads. All maxima are found before anything is written, so
+		 * x and result may be the same buffer.
+		 */
+		static void execTads(T *x, int *xOffsets, int xStride, T *result, int *resultOffsets, int resultStride, int numTads, Nd4jIndex tadLength) {
+			if (tadLength < 1)
+				return;
+
+			TadBlockInformation info(numTads, tadLength);
+			const int chunksPerTad = info.chunksPerTad;
+			const bool parallel = numTads * tadLength > 8000;
+			functions::indexreduce::IndexValue<T> *partials = new functions::indexreduce::IndexValue<T>[info.numChunks()];
+
+#pragma omp parallel for schedule(guided) if (parallel)
+			for (Nd4jIndex chunk = 0; chunk < info.numChunks(); chunk++) {
+				int i = (int) (chunk / chunksPerTad);
+				int c = (int) (chunk % chunksPerTad);
+				partials[chunk] = firstMax(x + xOffsets[i], xStride, info.chunkStart(c), info.chunkEnd(c));
+			}
+
+			if (info.isSplit()) {
+				for (int i = 0; i < numTads; i++) {
+					functions::indexreduce::IndexValue<T> *tadPartials = partials + (Nd4jIndex) i * chunksPerTad;
+					for (int width = 1; width < chunksPerTad; width *= 2)
+						for (int c = 0; c + width < chunksPerTad; c += 2 * width)
+							if (tadPartials[c].value < tadPartials[c + width].value)
+								tadPartials[c] = tadPartials[c + width];
+				}
+			}
+
+#pragma omp parallel for schedule(guided) if (parallel)
+			for (Nd4jIndex chunk = 0; chunk < info.numChunks(); chunk++) {
+				int i = (int) (chunk / chunksPerTad);
+				int c = (int) (chunk % chunksPerTad);
+				Nd4jIndex start = info.chunkStart(c);
+				Nd4jIndex end = info.chunkEnd(c);
+				Nd4jIndex maxIdx = partials[(Nd4jIndex) i * chunksPerTad].index;
+				T *tadResult = result + resultOffsets[i];
+
+#pragma omp simd
+				for (Nd4jIndex j = start; j < end; j++)
+					tadResult[j * resultStride] = (T) 0.0;
+
+				if (maxIdx >= start && maxIdx < end)
+					tadResult[maxIdx * resultStride] = (T) 1.0;
+			}
+
+			delete[] partials;
+		}
+
 #ifdef __CUDACC__
 		inline __host__
 
@@ -1189,97 +1452,9 @@ namespace simdOps {
 			int resultEleStride = shape::elementWiseStride(resultShapeBuffer);
 			char xOrder = shape::order(xShapeBuffer);
 			char resultOrder = shape::order(resultShapeBuffer);
-			if (xOrder == resultOrder && xOrder == 'c') {
-				if (eleStride == 1 && resultEleStride == 1) {
-					if (length < 8000) {
-						int maxIdx = 0;
-						T currMax = dx[0];
-#pragma omp simd
-						for (int i = 0; i < length; i++) {
-							if (currMax < dx[i]) {
-								currMax = dx[i];
-								maxIdx = i;
-							}
-
-							result[i] = 0.0;
-
-						}
-
-						result[maxIdx] = 1.0;
-
-					}
-					else {
-						int maxIdx = 0;
-						T currMax = dx[0];
-#pragma omp parallel
-{
-						int maxIdxLocal = maxIdx;
-						T currMaxLocal = currMax;
-#pragma omp for nowait
-						for (int i = 0; i < length; i++) {
-							if (currMaxLocal < dx[i]) {
-								currMaxLocal = dx[i];
-								maxIdxLocal = i;
-							}
-							result[i] = 0.0;
-
-						}
-#pragma omp critical
-{
-						if (currMax < currMaxLocal) {
-							currMax = currMaxLocal;
-							maxIdx = maxIdxLocal;
-						}
-}
-}
-						result[maxIdx] = 1.0;
-					}
-
-				}
-				else {
-					if (length < 8000) {
-						int maxIdx = 0;
-						T currMax = dx[0];
-#pragma omp simd
-						for (int i = 0; i < length; i++) {
-							result[i * resultEleStride] = 0.0;
-							if (currMax < dx[i * eleStride]) {
-								currMax = dx[i * eleStride];
-								maxIdx = i;
-							}
-						}
-
-						result[maxIdx * resultEleStride] = 1.0;
-
-					}
-					else {
-						int maxIdx = 0;
-						T currMax = dx[0];
-#pragma omp parallel
-{
-						int maxIdxLocal = maxIdx;
-						T currMaxLocal = currMax;
-#pragma omp for nowait
-						for (int i = 0; i < length; i++) {
-							result[i * resultEleStride] = 0.0;
-							if (currMaxLocal < dx[i * eleStride]) {
-								currMaxLocal = dx[i * eleStride];
-								maxIdxLocal = i;
-							}
-						}
-
-#pragma omp critical
-{
-						if (currMax < currMaxLocal) {
-							currMax = currMaxLocal;
-							maxIdx = maxIdxLocal;
-						}
-}
-}
-						result[maxIdx * resultEleStride] = 1.0;
-					}
-
-				}
+			if (xOrder == resultOrder && xOrder == 'c' && eleStride > 0 && resultEleStride > 0) {
+				int offset = 0;
+				execTads(dx, &offset, eleStride, result, &offset, resultEleStride, 1, length);
 			}
 
 
@@ -1385,98 +1560,11 @@ namespace simdOps {
 					}
 				}
 				else {
-					int eleStride = shape::elementWiseStride(xShapeBuffer);
-					if (eleStride == 1) {
-						int maxIdx = 0;
-						T currMax = dx[0];
-						if (length < 8000) {
-#pragma omp simd
-							for (int i = 0; i < length; i++) {
-								if (currMax < dx[i]) {
-									currMax = dx[i];
-									maxIdx = i;
-								}
-
-								dx[i] = 0.0;
-
-							}
-						}
-						else {
-#pragma omp parallel
-{
-							int maxIdxLocal = maxIdx;
-							T currMaxLocal = currMax;
-#pragma omp for nowait
-							for (int i = 0; i < length; i++) {
-								if (currMaxLocal < dx[i]) {
-									currMaxLocal = dx[i];
-									maxIdxLocal = i;
-								}
-
-								result[i] = 0.0;
-
-							}
-#pragma omp critical
-{
-							if (currMax < currMaxLocal) {
-								currMax = currMaxLocal;
-								maxIdx = maxIdxLocal;
-							}
-}
-}
-						}
-
-						result[maxIdx] = 1.0;
-
-					}
-
-
-					else {
-						int maxIdx = 0;
-						T currMax = dx[0];
-						if (length < 8000) {
-#pragma omp simd
-							for (int i = 0; i < length; i++) {
-								if (currMax < dx[i * eleStride]) {
-									currMax = dx[i * eleStride];
-									maxIdx = i;
-								}
-
-								dx[i] = 0.0;
-
-							}
-						}
-						else {
-#pragma omp parallel
-{
-							int maxIdxLocal = maxIdx;
-							T currMaxLocal = currMax;
-#pragma omp for nowait
-							for (int i = 0; i < length; i++) {
-								if (currMaxLocal < dx[i * eleStride]) {
-									currMaxLocal = dx[i * eleStride];
-									maxIdxLocal = i;
-								}
-
-								result[i] = 0.0;
-
-							}
-#pragma omp critical
-{
-							if (currMax < currMaxLocal) {
-								currMax = currMaxLocal;
-								maxIdx = maxIdxLocal;
-							}
-}
-}
-						}
-
-						result[maxIdx] = 1.0;
-
-					}
+					int offset = 0;
+					execTads(dx, &offset, shape::elementWiseStride(xShapeBuffer), result, &offset, shape::elementWiseStride(resultShapeBuffer), 1, length);
 				}
 
-
+				delete[] dimension;
 			}
 			else {
 				int dimensionLength = (int)extraParams[0];
@@ -1497,7 +1585,16 @@ namespace simdOps {
 				//to the back.
 				//permuted version of the x shape info for setting up the tad problem
 				int *tadShapeShapeInfo = tad.tadOnlyShapeInfo;
-#pragma omp  parallel  for
+				int tadLength = shape::length(tadShapeShapeInfo);
+				int tadEWS = shape::elementWiseStride(tadShapeShapeInfo);
+
+				if (tadEWS > 0 && (tads == 1 || shape::isVector(tadShapeShapeInfo) || shape::isScalar(tadShapeShapeInfo))) {
+					execTads(dx, tad.tadOffsets, tadEWS, result, tad.tadOffsets, tadEWS, tads, tadLength);
+					delete[] dimension;
+					return;
+				}
+
+#pragma omp parallel for schedule(guided)
 				for (int i = 0; i < tads; i++) {
 					int offset = tad.tadOffsets[i];
 					int shapeIter[MAX_RANK];
@@ -1548,6 +1645,8 @@ namespace simdOps {
 						maxCursor[0] = 1.0;
 					}
 				}
+
+				delete[] dimension;
 			}
 		}
 
@@ -27,6 +27,7 @@
 
 #include <ops.h>
 #include <op_boilerplate.h>
+#include <mask.h>
 
 #define SUMMARY_STATS_OPS \
         (0, simdOps::SummaryStatsVariance), \
@@ -625,6 +626,20 @@ template<typename OpType>
             DISPATCH_BY_OPNUM(exec, PARAMS(biasCorrected, x, xShapeInfo, extraParams, result, resultShapeInfoBuffer, dimension, dimensionLength), SUMMARY_STATS_OPS);
 	}
 
+	static void execMasked(
+		const int opNum,
+		const bool biasCorrected,
+		T *x,
+		int *xShapeInfo,
+		T *mask,
+		int *maskShapeInfo,
+		T *condition,
+		T *extraParams,
+		T *result,
+		int *dimension, int dimensionLength, int *tadShapeInfo, int *tadOffsets) {
+            DISPATCH_BY_OPNUM(execMasked, PARAMS(biasCorrected, x, xShapeInfo, mask, maskShapeInfo, condition, extraParams, result, dimension, dimensionLength, tadShapeInfo, tadOffsets), SUMMARY_STATS_OPS);
+	}
+
 	template<typename OpType>
 #ifdef __CUDACC__
 			inline __host__
@@ -766,22 +781,130 @@ template<typename OpType>
 				else {
 					int tadElementWiseStride = shape::elementWiseStride(tad.tadOnlyShapeInfo);
 					int tadLength = shape::length(tad.tadOnlyShapeInfo);
+
+					// few, long tads: split every tad between threads, merge partials in chunk order
+					TadBlockInformation info(resultLength, tadLength);
+					if (info.isSplit()) {
+						SummaryStatsData<T> *partials = new SummaryStatsData<T>[info.numChunks()];
+
+#pragma omp parallel for schedule(static)
+						for (Nd4jIndex c = 0; c < info.numChunks(); c++) {
+							int baseOffset = tad.tadOffsets[c / info.chunksPerTad];
+							int chunk = (int) (c % info.chunksPerTad);
+							Nd4jIndex chunkStart = info.chunkStart(chunk);
+							Nd4jIndex chunkEnd = info.chunkEnd(chunk);
+
+							SummaryStatsData<T> comp;
+							comp.initWithValue(x[baseOffset + tadElementWiseStride * chunkStart]);
+							for (Nd4jIndex j = chunkStart + 1; j < chunkEnd; j++) {
+								SummaryStatsData<T> comp2;
+								comp2.initWithValue(x[baseOffset + tadElementWiseStride * j]);
+								comp = update(comp, comp2, extraParams);
+							}
+
+							partials[c] = comp;
+						}
+
+#pragma omp parallel for if (resultLength > 16)
+						for (int i = 0; i < resultLength; i++) {
+							SummaryStatsData<T> comp = partials[i * info.chunksPerTad];
+							for (int c = 1; c < info.chunksPerTad; c++)
+								comp = update(comp, partials[i * info.chunksPerTad + c], extraParams);
+
+							result[i] = OpType::getValue(biasCorrected, comp);
+						}
+
+						delete[] partials;
+					}
+					else {
 #pragma omp parallel for
-					for (int i = 0; i < resultLength; i++) {
-						int baseOffset = tad.tadOffsets[i];
-						SummaryStatsData<T> comp;
-						comp.initWithValue(x[baseOffset]);
+						for (int i = 0; i < resultLength; i++) {
+							int baseOffset = tad.tadOffsets[i];
+							SummaryStatsData<T> comp;
+							comp.initWithValue(x[baseOffset]);
 #pragma omp simd
-						for (int j = 1; j < tadLength; j++) {
-							SummaryStatsData<T> comp2;
-							comp2.initWithValue(x[baseOffset + tadElementWiseStride * j]);
-							comp = update(comp, comp2, extraParams);
-						}
+							for (int j = 1; j < tadLength; j++) {
+								SummaryStatsData<T> comp2;
+								comp2.initWithValue(x[baseOffset + tadElementWiseStride * j]);
+								comp = update(comp, comp2, extraParams);
+							}
 
-						result[i] = OpType::getValue(biasCorrected, comp);
+							result[i] = OpType::getValue(biasCorrected, comp);
+						}
 					}
+				}
+			}
+
+			/**
+			 * Summary stats of the selected elements of every tad of x,
+			 * elements are selected by a mask array or a condition
+			 * (see mask.h). A tad without selected elements gives 0.
+			 *
+			 * @param biasCorrected whether to apply the bias correction
+			 * @param x the input
+			 * @param xShapeInfo the shape information for the input
+			 * @param mask optional mask of the same shape as x, non zero entries are used
+			 * @param maskShapeInfo the shape information for the mask
+			 * @param condition {compare, eps, mode} as for MatchCondition, used without a mask
+			 * @param extraParams the extra params for the op
+			 * @param result the result buffer, one value per tad
+			 * @param dimension the dimensions to reduce along, null or MAX_DIMENSION for the whole array
+			 * @param dimensionLength the number of dimensions
+			 * @param tadShapeInfo optional precomputed tad shape information for x
+			 * @param tadOffsets optional precomputed tad offsets for x
+			 */
+			template<typename OpType>
+#ifdef __CUDACC__
+			inline __host__
+
+#elif defined(__GNUC__)
 
+#endif
+			static void execMasked(
+				const bool biasCorrected,
+				T *x,
+				int *xShapeInfo,
+				T *mask,
+				int *maskShapeInfo,
+				T *condition,
+				T *extraParams,
+				T *result,
+				int *dimension, int dimensionLength, int *tadShapeInfo, int *tadOffsets) {
+				if (shape::length(xShapeInfo) < 1)
+					return;
+				if (mask != nullptr && !nd4j::mask::MaskedTads<T>::fits(xShapeInfo, maskShapeInfo))
+					return;
+
+				nd4j::mask::MaskedTads<T> tads(xShapeInfo, mask != nullptr ? maskShapeInfo : nullptr, dimension, dimensionLength, tadShapeInfo, tadOffsets, false);
+
+				TadBlockInformation info(tads.numTads, tads.tadLength);
+				SummaryStatsData<T> *partials = new SummaryStatsData<T>[info.numChunks()];
+
+#pragma omp parallel for schedule(guided) if (info.numChunks() > 1)
+				for (Nd4jIndex c = 0; c < info.numChunks(); c++) {
+					int i = (int) (c / info.chunksPerTad);
+					int chunk = (int) (c % info.chunksPerTad);
+					SummaryStatsData<T> comp;
+					auto visitor = [&](T value, Nd4jIndex j) {
+						SummaryStatsData<T> comp2;
+						comp2.initWithValue(value);
+						comp = update(comp, comp2, extraParams);
+					};
+					nd4j::mask::forEachSelected(tads, x, mask, condition, i, info.chunkStart(chunk), info.chunkEnd(chunk), visitor);
+
+					partials[c] = comp;
+				}
+
+#pragma omp parallel for schedule(static) if (tads.numTads > 16)
+				for (int i = 0; i < tads.numTads; i++) {
+					SummaryStatsData<T> comp = partials[(Nd4jIndex) i * info.chunksPerTad];
+					for (int c = 1; c < info.chunksPerTad; c++)
+						comp = update(comp, partials[(Nd4jIndex) i * info.chunksPerTad + c], extraParams);
+
+					result[i] = OpType::getValue(biasCorrected, comp);
 				}
+
+				delete[] partials;
 			}
 		};
 	}
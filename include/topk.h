@@ -0,0 +1,352 @@
+/*
+ * topk.h
+ *
+ * K largest (or smallest) values and their indices along dimensions.
+ */
+
+#ifndef LIBND4J_TOPK_H
+#define LIBND4J_TOPK_H
+
+#include <algorithm>
+#include <dll.h>
+#include <shape.h>
+#include <omp.h>
+#include <stdio.h>
+#include <templatemath.h>
+#include <pairwise_util.h>
+#include <ops.h>
+
+#ifdef __JNI__
+#include <jni.h>
+#endif
+
+/**
+ * Elements checked against the current k-th best value at
+ * once, only blocks holding a candidate touch the heap.
+ */
+#define ND4J_TOPK_BLOCK 64
+
+namespace functions {
+	namespace topk {
+
+		template<typename T>
+		class TopK {
+		public:
+			typedef functions::indexreduce::IndexValue<T> Entry;
+
+			/**
+			 * Finds the k largest (or smallest) elements of every tad of x.
+			 *
+			 * Results are written row by row: values[i * k + j] and
+			 * indices[i * k + j] hold the j-th best element of tad i,
+			 * sorted best first. Indices are positions within the tad
+			 * in c order, ties are resolved in favour of the lower index.
+			 * When k exceeds the tad length every tad is sorted completely
+			 * and the remaining k - tadLength slots of its row get value 0
+			 * and index -1.
+			 *
+			 * Every thread keeps a bounded heap of the k best elements
+			 * seen so far, elements are compared against the k-th best
+			 * value a block at a time so rows are filtered with simd
+			 * loops and the heap is only touched for actual candidates.
+			 * When there are fewer tads than threads, long tads are split
+			 * into chunks whose heaps are merged per tad.
+			 *
+			 * @param x the input
+			 * @param xShapeInfo the shape information for the input
+			 * @param dimension the dimensions to search along, null or MAX_DIMENSION for the whole array
+			 * @param dimensionLength the number of dimensions
+			 * @param k the number of elements to find per tad
+			 * @param largest whether to find the largest or the smallest elements
+			 * @param values the values, numTads * k
+			 * @param indices the indices, numTads * k
+			 * @param tadShapeInfo unused, the tads are described by xShapeInfo
+			 * @param tadOffsets optional precomputed tad offsets for x
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void exec(T *x,
+				int *xShapeInfo,
+				int *dimension,
+				int dimensionLength,
+				int k,
+				bool largest,
+				T *values,
+				T *indices, int *tadShapeInfo, int *tadOffsets) {
+				const Nd4jIndex length = shape::length(xShapeInfo);
+				if (length < 1 || k < 1)
+					return;
+
+				int *xTadOffsets = tadOffsets;
+				shape::TAD *tad = nullptr;
+				int wholeOffset = 0;
+
+				Nd4jIndex tadLength;
+				int numTads;
+
+				if (dimension == nullptr || dimension[0] == MAX_DIMENSION || dimensionLength >= shape::rank(xShapeInfo)) {
+					xTadOffsets = &wholeOffset;
+					tadLength = length;
+					numTads = 1;
+				}
+				else {
+					tadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
+					numTads = (int) (length / tadLength);
+
+					if (xTadOffsets == nullptr) {
+						tad = new shape::TAD(xShapeInfo, dimension, dimensionLength);
+						tad->createTadOnlyShapeInfo();
+						tad->createOffsets();
+						xTadOffsets = tad->tadOffsets;
+					}
+				}
+
+				// rows of the output stay k long, the search is capped at the tad length
+				const int rowLength = k;
+				if (k > tadLength)
+					k = (int) tadLength;
+
+				/*
+				 * The tad is described by the searched dimensions of x itself,
+				 * the first operand of the iterator is the c ordered position
+				 * within the tad: runs are visited in index order and the
+				 * index of an element is the position of its run plus its
+				 * place in the run.
+				 */
+				int xRank = shape::rank(xShapeInfo);
+				int rank = 0;
+				int searched[MAX_RANK];
+				if (numTads == 1) {
+					for (int i = 0; i < xRank; i++)
+						searched[rank++] = i;
+				}
+				else {
+					for (int i = 0; i < dimensionLength; i++)
+						searched[rank++] = dimension[i] < 0 ? dimension[i] + xRank : dimension[i];
+					std::sort(searched, searched + rank);
+				}
+
+				int tadShape[MAX_RANK];
+				int positions[MAX_RANK];
+				int xStrides[MAX_RANK];
+				int position = 1;
+				for (int i = rank - 1; i >= 0; i--) {
+					tadShape[i] = shape::shapeOf(xShapeInfo)[searched[i]];
+					xStrides[i] = shape::stride(xShapeInfo)[searched[i]];
+					positions[i] = position;
+					position *= tadShape[i];
+				}
+
+				StridedIterator tadIter(rank, tadShape, positions, xStrides);
+
+				TadBlockInformation info(numTads, tadLength, k > 8192 ? k : 8192);
+
+				if (info.isSplit()) {
+					Entry *heaps = new Entry[info.numChunks() * k];
+					int *sizes = new int[info.numChunks()];
+
+#pragma omp parallel for schedule(static)
+					for (Nd4jIndex chunk = 0; chunk < info.numChunks(); chunk++) {
+						int i = (int) (chunk / info.chunksPerTad);
+						int c = (int) (chunk % info.chunksPerTad);
+						sizes[chunk] = 0;
+						offerRange(x + xTadOffsets[i], tadIter, info.chunkStart(c), info.chunkEnd(c), k, largest, heaps + chunk * k, sizes[chunk]);
+					}
+
+#pragma omp parallel for schedule(static) if (numTads > 1)
+					for (int i = 0; i < numTads; i++) {
+						Entry *heap = heaps + (Nd4jIndex) i * info.chunksPerTad * k;
+						int size = sizes[i * info.chunksPerTad];
+						for (int c = 1; c < info.chunksPerTad; c++) {
+							Entry *chunkHeap = heaps + ((Nd4jIndex) i * info.chunksPerTad + c) * k;
+							for (int e = 0; e < sizes[i * info.chunksPerTad + c]; e++)
+								offer(heap, size, k, largest, chunkHeap[e]);
+						}
+
+						store(heap, size, rowLength, largest, values + (Nd4jIndex) i * rowLength, indices + (Nd4jIndex) i * rowLength);
+					}
+
+					delete[] heaps;
+					delete[] sizes;
+				}
+				else {
+#pragma omp parallel if (numTads > 1)
+					{
+						Entry *heap = new Entry[k];
+
+#pragma omp for schedule(guided)
+						for (int i = 0; i < numTads; i++) {
+							int size = 0;
+							offerRange(x + xTadOffsets[i], tadIter, 0, tadLength, k, largest, heap, size);
+							store(heap, size, rowLength, largest, values + (Nd4jIndex) i * rowLength, indices + (Nd4jIndex) i * rowLength);
+						}
+
+						delete[] heap;
+					}
+				}
+
+				if (tad != nullptr)
+					delete tad;
+			}
+
+			/**
+			 * Whether a ranks before b
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline bool better(const Entry &a, const Entry &b, bool largest) {
+				if (a.value == b.value)
+					return a.index < b.index;
+
+				return largest ? a.value > b.value : a.value < b.value;
+			}
+
+			/**
+			 * Restores the heap below pos, the worst entry is kept at the root
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void siftDown(Entry *heap, int size, int pos, bool largest) {
+				Entry item = heap[pos];
+				while (true) {
+					int child = 2 * pos + 1;
+					if (child >= size)
+						break;
+
+					if (child + 1 < size && better(heap[child], heap[child + 1], largest))
+						child++;
+
+					if (!better(item, heap[child], largest))
+						break;
+
+					heap[pos] = heap[child];
+					pos = child;
+				}
+
+				heap[pos] = item;
+			}
+
+			/**
+			 * Adds item to a heap holding at most k entries
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static inline void offer(Entry *heap, int &size, int k, bool largest, Entry item) {
+				if (size < k) {
+					int pos = size++;
+					while (pos > 0) {
+						int parent = (pos - 1) / 2;
+						if (!better(heap[parent], item, largest))
+							break;
+
+						heap[pos] = heap[parent];
+						pos = parent;
+					}
+
+					heap[pos] = item;
+				}
+				else if (better(item, heap[0], largest)) {
+					heap[0] = item;
+					siftDown(heap, size, 0, largest);
+				}
+			}
+
+			/**
+			 * Offers elements [start, end) (in c order) of a tad
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void offerRange(T *x, const StridedIterator &tadIter, Nd4jIndex start, Nd4jIndex end, int k, bool largest, Entry *heap, int &size) {
+				StridedIterator iter = tadIter;
+				Nd4jIndex innerLength = iter.innerLength();
+				int xStride = iter.innerStride(1);
+				Nd4jIndex first = start % innerLength;
+				iter.seek(start / innerLength);
+
+				for (Nd4jIndex remaining = end - start; remaining > 0; iter.next()) {
+					Nd4jIndex last = first + remaining < innerLength ? first + remaining : innerLength;
+					offerRun(x + iter.offsets[1], xStride, iter.offsets[0], first, last, k, largest, heap, size);
+					remaining -= last - first;
+					first = 0;
+				}
+			}
+
+			/**
+			 * Offers elements [start, end) of a run whose
+			 * first element has index position
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void offerRun(T *x, int xStride, Nd4jIndex position, Nd4jIndex start, Nd4jIndex end, int k, bool largest, Entry *heap, int &size) {
+				Entry item;
+				Nd4jIndex i = start;
+				for (; i < end && size < k; i++) {
+					item.value = x[i * xStride];
+					item.index = (unsigned int) (position + i);
+					offer(heap, size, k, largest, item);
+				}
+
+				for (; i < end; i += ND4J_TOPK_BLOCK) {
+					Nd4jIndex blockEnd = i + ND4J_TOPK_BLOCK < end ? i + ND4J_TOPK_BLOCK : end;
+					T threshold = heap[0].value;
+					int candidates = 0;
+
+					// equal values never displace an entry with a lower index
+					if (largest) {
+#pragma omp simd reduction(+:candidates)
+						for (Nd4jIndex j = i; j < blockEnd; j++)
+							candidates += x[j * xStride] > threshold ? 1 : 0;
+					}
+					else {
+#pragma omp simd reduction(+:candidates)
+						for (Nd4jIndex j = i; j < blockEnd; j++)
+							candidates += x[j * xStride] < threshold ? 1 : 0;
+					}
+
+					if (candidates == 0)
+						continue;
+
+					for (Nd4jIndex j = i; j < blockEnd; j++) {
+						item.value = x[j * xStride];
+						item.index = (unsigned int) (position + j);
+						offer(heap, size, k, largest, item);
+					}
+				}
+			}
+
+			/**
+			 * Writes the heap out best first and pads the row up
+			 * to rowLength, the heap is destroyed
+			 */
+#ifdef __CUDACC__
+			__host__
+#endif
+			static void store(Entry *heap, int size, int rowLength, bool largest, T *values, T *indices) {
+				for (int last = size - 1; last > 0; last--) {
+					Entry worst = heap[0];
+					heap[0] = heap[last];
+					heap[last] = worst;
+					siftDown(heap, last, 0, largest);
+				}
+
+				for (int j = 0; j < size; j++) {
+					values[j] = heap[j].value;
+					indices[j] = (T) heap[j].index;
+				}
+
+				for (int j = size; j < rowLength; j++) {
+					values[j] = (T) 0.0;
+					indices[j] = (T) -1.0;
+				}
+			}
+		};
+	}
+}
+
+#endif //LIBND4J_TOPK_H
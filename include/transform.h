@@ -21,7 +21,9 @@
 #include <shape.h>
 #include <ops.h>
 #include <special_ops.h>
+#include <permute.h>
 #include <op_boilerplate.h>
+#include <isa_dispatch.h>
 #include "types/float8.h"
 
 #ifdef __CUDACC__
@@ -308,45 +310,8 @@ template<typename OpType>
                     exec<OpType>(dx,xElementWiseStride,result,resultElementWiseStride,extraParams,n);
                 }
                 else {
-                    int shapeIter[MAX_RANK];
-                    int coord[MAX_RANK];
-                    int dim;
-                    int xStridesIter[MAX_RANK];
-                    int resultStridesIter[MAX_RANK];
-                    int *xShape = shape::shapeOf(xShapeInfo);
-                    int *xStride = shape::stride(xShapeInfo);
-                    int *resultStride = shape::stride(resultShapeInfo);
-                    int rank = shape::rank(xShapeInfo);
-                    if(PrepareTwoRawArrayIter<T>(rank,
-                                                 xShape,
-                                                 dx,
-                                                 xStride,
-                                                 result,
-                                                 resultStride,
-                                                 &rank,
-                                                 shapeIter,
-                                                 &dx,
-                                                 xStridesIter,
-                                                 &result,
-                                                 resultStridesIter) >= 0) {
-                        ND4J_RAW_ITER_START(dim, rank, coord, shapeIter);
-                        {
-                            /* Process the innermost dimension */
-                            T *xIter = dx;
-                            T *resultIter = result;
-                            resultIter[0] = OpType::op(xIter[0], extraParams);
-                        }
-                        ND4J_RAW_ITER_TWO_NEXT(dim,
-                                               rank,
-                                               coord,
-                                               shapeIter,
-                                               dx,
-                                               xStridesIter,
-                                               result,
-                                               resultStridesIter);
-
-                    }
-
+                    // different layouts (c <-> f, permuted views): cache blocked
+                    functions::permute::Permute<T>::template exec<OpType>(dx, xShapeInfo, result, resultShapeInfo, extraParams);
                 }
 
             }
@@ -370,6 +335,7 @@ template<typename OpType>
 			}
 
 			template<typename OpType>
+			ND4J_ISA_DISPATCH
 			static void exec(T *dx,
                               int xStride,
                               T *result,
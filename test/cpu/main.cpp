@@ -9,6 +9,13 @@
 #include <indexreducetests.h>
 #include <summarystatsreducetest.h>
 #include <pairwiseutiltests.h>
+#include <deterministicreducetests.h>
+#include <scantests.h>
+#include <randomtests.h>
+#include <topktests.h>
+#include <conv2dtests.h>
+#include <orderstatistictests.h>
+#include <histogramtests.h>
 int main(int ac, char** av) {
 #ifdef __CUDACC__
 	cudaDeviceSetLimit(cudaLimitStackSize,20000);
@@ -26,4 +33,11 @@ IMPORT_TEST_GROUP(Reduce3);
 IMPORT_TEST_GROUP(IndexReduce);
 IMPORT_TEST_GROUP(SummaryStatsReduce);
 IMPORT_TEST_GROUP(PairWiseUtil);
+IMPORT_TEST_GROUP(DeterministicReduce);
+IMPORT_TEST_GROUP(Scan);
+IMPORT_TEST_GROUP(Random);
+IMPORT_TEST_GROUP(TopK);
+IMPORT_TEST_GROUP(Conv2D);
+IMPORT_TEST_GROUP(OrderStatistic);
+IMPORT_TEST_GROUP(Histogram);
 
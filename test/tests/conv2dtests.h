@@ -0,0 +1,162 @@
+//
+// 2d convolution forward and gradients checked
+// against a direct convolution.
+//
+
+#ifndef NATIVEOPERATIONS_CONV2DTESTS_H
+#define NATIVEOPERATIONS_CONV2DTESTS_H
+#include "testhelpers.h"
+#include <cmath>
+#include <vector>
+#include <conv2d.h>
+
+TEST_GROUP(Conv2D) {
+
+    static int output_method(const char* output, ...) {
+        va_list arguments;
+        va_start(arguments, output);
+        va_end(arguments);
+        return 1;
+    }
+    void setup() {
+
+    }
+    void teardown() {
+        omp_set_num_threads(omp_get_num_procs());
+    }
+};
+
+/**
+ * Deterministic values in [-1, 1) that aren't all alike
+ */
+static void conv2dFill(std::vector<double> &values, int seed) {
+    unsigned int state = 2654435761u * (unsigned int) (seed + 1);
+    for (size_t i = 0; i < values.size(); i++) {
+        state = state * 1664525u + 1013904223u;
+        values[i] = (double) (state >> 8) / (double) (1 << 23) - 1.0;
+    }
+}
+
+/**
+ * Runs forward and backward on c ordered [n, c, h, w] input, [outC, c, kH, kW]
+ * weights and a bias, and compares the output and the input, weight and bias
+ * gradients against the direct convolution loops
+ */
+static bool conv2dMatches(int n, int c, int h, int w, int outC, int kH, int kW, int strideH, int strideW, int padH, int padW) {
+    const int outH = (h + 2 * padH - kH) / strideH + 1;
+    const int outW = (w + 2 * padW - kW) / strideW + 1;
+    int inputShape[4] = {n, c, h, w};
+    int weightsShape[4] = {outC, c, kH, kW};
+    int outputShape[4] = {n, outC, outH, outW};
+    int *inputShapeInfo = shape::shapeBuffer(4, inputShape);
+    int *weightsShapeInfo = shape::shapeBuffer(4, weightsShape);
+    int *outputShapeInfo = shape::shapeBuffer(4, outputShape);
+
+    std::vector<double> input(n * c * h * w);
+    std::vector<double> weights(outC * c * kH * kW);
+    std::vector<double> bias(outC);
+    std::vector<double> epsilon(n * outC * outH * outW);
+    conv2dFill(input, 1);
+    conv2dFill(weights, 2);
+    conv2dFill(bias, 3);
+    conv2dFill(epsilon, 4);
+
+    std::vector<double> output(epsilon.size(), -7.0);
+    std::vector<double> inputGrad(input.size(), -7.0);
+    std::vector<double> weightsGrad(weights.size(), -7.0);
+    std::vector<double> biasGrad(outC, -7.0);
+    functions::convolution::Conv2D<double>::forward(&input[0], inputShapeInfo, &weights[0], weightsShapeInfo, &bias[0], &output[0], outputShapeInfo, strideH, strideW, padH, padW);
+    functions::convolution::Conv2D<double>::backward(&input[0], inputShapeInfo, &weights[0], weightsShapeInfo, &epsilon[0], outputShapeInfo, &inputGrad[0], inputShapeInfo, &weightsGrad[0], weightsShapeInfo, &biasGrad[0], strideH, strideW, padH, padW);
+
+    std::vector<double> expectedInputGrad(input.size(), 0.0);
+    std::vector<double> expectedWeightsGrad(weights.size(), 0.0);
+    std::vector<double> expectedBiasGrad(outC, 0.0);
+    bool same = true;
+    for (int e = 0; e < n; e++) {
+        for (int o = 0; o < outC; o++) {
+            for (int oy = 0; oy < outH; oy++) {
+                for (int ox = 0; ox < outW; ox++) {
+                    int outputIndex = ((e * outC + o) * outH + oy) * outW + ox;
+                    double eps = epsilon[outputIndex];
+                    double sum = bias[o];
+                    expectedBiasGrad[o] += eps;
+                    for (int i = 0; i < c; i++) {
+                        for (int ky = 0; ky < kH; ky++) {
+                            for (int kx = 0; kx < kW; kx++) {
+                                int y = oy * strideH - padH + ky;
+                                int x = ox * strideW - padW + kx;
+                                if (y < 0 || y >= h || x < 0 || x >= w)
+                                    continue;
+
+                                int inputIndex = ((e * c + i) * h + y) * w + x;
+                                int weightIndex = ((o * c + i) * kH + ky) * kW + kx;
+                                sum += weights[weightIndex] * input[inputIndex];
+                                expectedInputGrad[inputIndex] += weights[weightIndex] * eps;
+                                expectedWeightsGrad[weightIndex] += input[inputIndex] * eps;
+                            }
+                        }
+                    }
+
+                    if (fabs(output[outputIndex] - sum) > 1e-10) {
+                        printf("Conv2D: output [%d] is %f, expected %f\n", outputIndex, output[outputIndex], sum);
+                        same = false;
+                    }
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < input.size(); i++) {
+        if (fabs(inputGrad[i] - expectedInputGrad[i]) > 1e-10) {
+            printf("Conv2D: inputGrad [%d] is %f, expected %f\n", (int) i, inputGrad[i], expectedInputGrad[i]);
+            same = false;
+        }
+    }
+
+    for (size_t i = 0; i < weights.size(); i++) {
+        if (fabs(weightsGrad[i] - expectedWeightsGrad[i]) > 1e-9) {
+            printf("Conv2D: weightsGrad [%d] is %f, expected %f\n", (int) i, weightsGrad[i], expectedWeightsGrad[i]);
+            same = false;
+        }
+    }
+
+    for (int i = 0; i < outC; i++) {
+        if (fabs(biasGrad[i] - expectedBiasGrad[i]) > 1e-9) {
+            printf("Conv2D: biasGrad [%d] is %f, expected %f\n", i, biasGrad[i], expectedBiasGrad[i]);
+            same = false;
+        }
+    }
+
+    delete[] inputShapeInfo;
+    delete[] weightsShapeInfo;
+    delete[] outputShapeInfo;
+    return same;
+}
+
+TEST(Conv2D,Unpadded) {
+    CHECK(conv2dMatches(2, 3, 7, 6, 5, 3, 3, 1, 1, 0, 0));
+    CHECK(conv2dMatches(1, 2, 5, 5, 3, 1, 1, 1, 1, 0, 0));
+}
+
+/**
+ * Different strides and padding per axis with a non square kernel
+ */
+TEST(Conv2D,StridedPadded) {
+    CHECK(conv2dMatches(2, 3, 9, 8, 5, 3, 2, 2, 1, 1, 2));
+    CHECK(conv2dMatches(3, 4, 10, 11, 9, 2, 5, 3, 2, 2, 1));
+}
+
+/**
+ * c * kH * kW = 480 rows of the im2col matrix is more than one
+ * depth panel (kc), the partial products of the panels have to add
+ * up. Big enough to be split between threads.
+ */
+TEST(Conv2D,DeepPanels) {
+    CHECK(conv2dMatches(3, 40, 11, 13, 20, 3, 4, 2, 2, 1, 1));
+
+    omp_set_num_threads(4);
+    CHECK(conv2dMatches(3, 40, 11, 13, 20, 3, 4, 2, 2, 1, 1));
+    CHECK(conv2dMatches(5, 30, 8, 9, 70, 3, 3, 1, 2, 1, 0));
+}
+
+#endif //NATIVEOPERATIONS_CONV2DTESTS_H
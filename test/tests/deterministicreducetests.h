@@ -0,0 +1,137 @@
+//
+// Reductions in deterministic mode have to give bit identical
+// results for any number of threads.
+//
+
+#ifndef NATIVEOPERATIONS_DETERMINISTICREDUCETESTS_H
+#define NATIVEOPERATIONS_DETERMINISTICREDUCETESTS_H
+#include <string.h>
+#include "testhelpers.h"
+#include <deterministic.h>
+#include <reduce.h>
+#include <reduce3.h>
+
+TEST_GROUP(DeterministicReduce) {
+
+    static int output_method(const char* output, ...) {
+        va_list arguments;
+        va_start(arguments, output);
+        va_end(arguments);
+        return 1;
+    }
+    void setup() {
+
+    }
+    void teardown() {
+        nd4j::reduction::setReductionMode(ND4J_REDUCTION_DEFAULT);
+        omp_set_num_threads(omp_get_num_procs());
+    }
+};
+
+/**
+ * Values spanning a few orders of magnitude, so the result of a sum
+ * depends on the order it is taken in
+ */
+template <typename T>
+static T *deterministicInput(int length) {
+    T *data = new T[length];
+    unsigned int state = 12345;
+    for (int i = 0; i < length; i++) {
+        state = state * 1664525 + 1013904223;
+        data[i] = (T) ((int) (state >> 8) % 20001 - 10000) / (T) (1 + (state & 0xff));
+    }
+
+    return data;
+}
+
+/**
+ * Runs the reductions of a [rows, cols] array (whole array and along
+ * both dimensions) at the given number of threads
+ */
+template <typename T>
+static void deterministicReductions(int opNum, int rows, int cols, int threads, T *x, T *y, T *results) {
+    omp_set_num_threads(threads);
+
+    int shape[2] = {rows, cols};
+    int *shapeInfo = shape::shapeBuffer(2, shape);
+    int rowsShape[2] = {rows, 1};
+    int *rowsShapeInfo = shape::shapeBuffer(2, rowsShape);
+    int colsShape[2] = {1, cols};
+    int *colsShapeInfo = shape::shapeBuffer(2, colsShape);
+    int alongCols = 1;
+    int alongRows = 0;
+    T extraParams[3] = {0.0, 0.0, 0.0};
+
+    if (y == nullptr) {
+        results[0] = functions::reduce::ReduceFunction<T>::execScalar(opNum, x, shapeInfo, extraParams);
+        functions::reduce::ReduceFunction<T>::exec(opNum, x, shapeInfo, extraParams, results + 1, rowsShapeInfo, &alongCols, 1, nullptr, nullptr);
+        functions::reduce::ReduceFunction<T>::exec(opNum, x, shapeInfo, extraParams, results + 1 + rows, colsShapeInfo, &alongRows, 1, nullptr, nullptr);
+    }
+    else {
+        results[0] = functions::reduce3::Reduce3<T>::execScalar(opNum, x, shapeInfo, extraParams, y, shapeInfo);
+        functions::reduce3::Reduce3<T>::exec(opNum, x, shapeInfo, extraParams, y, shapeInfo, results + 1, rowsShapeInfo, &alongCols, 1);
+        functions::reduce3::Reduce3<T>::exec(opNum, x, shapeInfo, extraParams, y, shapeInfo, results + 1 + rows, colsShapeInfo, &alongRows, 1);
+    }
+
+    delete[] shapeInfo;
+    delete[] rowsShapeInfo;
+    delete[] colsShapeInfo;
+}
+
+/**
+ * Compares the bits of the reductions at 1 thread against 2, 3 and 8
+ */
+template <typename T>
+static bool deterministicAcrossThreads(int mode, int opNum, bool pairwise) {
+    const int rows = 3;
+    const int cols = 70001;
+    const int resultLength = 1 + rows + cols;
+    T *x = deterministicInput<T>(rows * cols);
+    T *y = pairwise ? deterministicInput<T>(rows * cols) : nullptr;
+    T *expected = new T[resultLength];
+    T *results = new T[resultLength];
+
+    nd4j::reduction::setReductionMode(mode);
+    deterministicReductions<T>(opNum, rows, cols, 1, x, y, expected);
+
+    bool same = true;
+    int threads[3] = {2, 3, 8};
+    for (int t = 0; t < 3; t++) {
+        deterministicReductions<T>(opNum, rows, cols, threads[t], x, y, results);
+        if (memcmp(expected, results, resultLength * sizeof(T)) != 0) {
+            printf("Op [%d] differs between 1 and %d threads\n", opNum, threads[t]);
+            same = false;
+        }
+    }
+
+    delete[] x;
+    if (y != nullptr)
+        delete[] y;
+    delete[] expected;
+    delete[] results;
+    return same;
+}
+
+TEST(DeterministicReduce,Sum) {
+    CHECK(deterministicAcrossThreads<float>(ND4J_REDUCTION_DETERMINISTIC, 1, false));
+    CHECK(deterministicAcrossThreads<double>(ND4J_REDUCTION_DETERMINISTIC, 1, false));
+}
+
+TEST(DeterministicReduce,Mean) {
+    CHECK(deterministicAcrossThreads<float>(ND4J_REDUCTION_DETERMINISTIC, 0, false));
+    CHECK(deterministicAcrossThreads<double>(ND4J_REDUCTION_DETERMINISTIC, 0, false));
+}
+
+TEST(DeterministicReduce,CompensatedSum) {
+    CHECK(deterministicAcrossThreads<float>(ND4J_REDUCTION_COMPENSATED, 1, false));
+    CHECK(deterministicAcrossThreads<float>(ND4J_REDUCTION_COMPENSATED, 0, false));
+}
+
+TEST(DeterministicReduce,Reduce3) {
+    // Manhattan, Euclidean, Dot
+    CHECK(deterministicAcrossThreads<float>(ND4J_REDUCTION_DETERMINISTIC, 0, true));
+    CHECK(deterministicAcrossThreads<float>(ND4J_REDUCTION_DETERMINISTIC, 1, true));
+    CHECK(deterministicAcrossThreads<double>(ND4J_REDUCTION_DETERMINISTIC, 3, true));
+}
+
+#endif //NATIVEOPERATIONS_DETERMINISTICREDUCETESTS_H
@@ -0,0 +1,141 @@
+//
+// Histograms with equal width bins, explicit bin
+// edges and the range of the data.
+//
+
+#ifndef NATIVEOPERATIONS_HISTOGRAMTESTS_H
+#define NATIVEOPERATIONS_HISTOGRAMTESTS_H
+#include "testhelpers.h"
+#include <histogram.h>
+
+TEST_GROUP(Histogram) {
+
+    static int output_method(const char* output, ...) {
+        va_list arguments;
+        va_start(arguments, output);
+        va_end(arguments);
+        return 1;
+    }
+    void setup() {
+
+    }
+    void teardown() {
+        omp_set_num_threads(omp_get_num_procs());
+    }
+};
+
+/**
+ * Histogram of a vector, compared against the expected counts
+ */
+static bool histogramOfVector(const double *x, int length, int numBins, double min, double max, double *binEdges, const double *expected) {
+    int shape[2] = {1, length};
+    int *shapeInfo = shape::shapeBuffer(2, shape);
+    double *input = new double[length];
+    double *result = new double[numBins];
+    for (int i = 0; i < length; i++)
+        input[i] = x[i];
+
+    functions::histogram::Histogram<double>::exec(input, shapeInfo, nullptr, 0, numBins, min, max, binEdges, result, nullptr, nullptr);
+
+    bool same = true;
+    for (int b = 0; b < numBins; b++) {
+        if (result[b] != expected[b]) {
+            printf("Histogram: bin [%d] is %f, expected %f\n", b, result[b], expected[b]);
+            same = false;
+        }
+    }
+
+    delete[] shapeInfo;
+    delete[] input;
+    delete[] result;
+    return same;
+}
+
+TEST(Histogram,EqualWidth) {
+    // the upper edge belongs to the last bin, values outside and NaN aren't counted
+    double x[9] = {0, 0.5, 1, 1.99, 2, 3.5, 4, 4.5, NAN};
+    double expected[4] = {2, 2, 1, 2};
+    CHECK(histogramOfVector(x, 9, 4, 0.0, 4.0, nullptr, expected));
+}
+
+TEST(Histogram,BinEdges) {
+    double x[10] = {-1, 0, 0.5, 1, 2, 5, 9.99, 10, 11, NAN};
+    double edges[4] = {0, 1, 5, 10};
+    double expected[3] = {2, 2, 3};
+    // min and max are ignored with edges, even if they are reversed
+    CHECK(histogramOfVector(x, 10, 3, 3.0, -3.0, edges, expected));
+}
+
+/**
+ * min == max bins every tad over its own range, a single value
+ * range is widened to [v - 0.5, v + 0.5]
+ */
+TEST(Histogram,DataRange) {
+    double x[6] = {2, 6, 3, 4, 5, 2};
+    double expected[2] = {3, 3};
+    CHECK(histogramOfVector(x, 6, 2, 0.0, 0.0, nullptr, expected));
+
+    double same[3] = {7, 7, 7};
+    double middle[3] = {0, 3, 0};
+    CHECK(histogramOfVector(same, 3, 3, 1.0, 1.0, nullptr, middle));
+
+    // along dimension 1 every row has its own range
+    int shape[2] = {2, 4};
+    int *shapeInfo = shape::shapeBuffer(2, shape);
+    double rows[8] = {0, 1, 2, 3, 10, 10, 10, 40};
+    double result[4];
+    int dimension = 1;
+    functions::histogram::Histogram<double>::exec(rows, shapeInfo, &dimension, 1, 2, 0.0, 0.0, nullptr, result, nullptr, nullptr);
+    DOUBLES_EQUAL(2.0, result[0], 0.0);
+    DOUBLES_EQUAL(2.0, result[1], 0.0);
+    DOUBLES_EQUAL(3.0, result[2], 0.0);
+    DOUBLES_EQUAL(1.0, result[3], 0.0);
+
+    delete[] shapeInfo;
+}
+
+TEST(Histogram,ReversedRange) {
+    double x[3] = {1, 2, 3};
+    double result[2] = {-1, -1};
+    int shape[2] = {1, 3};
+    int *shapeInfo = shape::shapeBuffer(2, shape);
+    functions::histogram::Histogram<double>::exec(x, shapeInfo, nullptr, 0, 2, 3.0, 1.0, nullptr, result, nullptr, nullptr);
+    DOUBLES_EQUAL(-1.0, result[0], 0.0);
+    DOUBLES_EQUAL(-1.0, result[1], 0.0);
+
+    delete[] shapeInfo;
+}
+
+/**
+ * A long vector is binned in chunks when there are spare threads,
+ * the data range and the counts of the chunks have to add up
+ */
+TEST(Histogram,SplitTad) {
+    const int length = 100003;
+    const int numBins = 10;
+    double *x = new double[length];
+    double expected[numBins] = {0};
+    for (int i = 0; i < length; i++) {
+        x[i] = (double) ((i * 37) % 1000);
+        expected[(int) x[i] / 100]++;
+    }
+    x[54321] = NAN;
+    expected[(54321 * 37) % 1000 / 100]--;
+
+    omp_set_num_threads(4);
+    CHECK(histogramOfVector(x, length, numBins, 0.0, 1000.0, nullptr, expected));
+
+    // the data range is [0, 999], min and max are ignored
+    double rangeCounts[numBins] = {0};
+    for (int i = 0; i < length; i++) {
+        if (x[i] != x[i])
+            continue;
+        int b = (int) (x[i] * numBins / 999.0);
+        rangeCounts[b < numBins ? b : numBins - 1]++;
+    }
+    CHECK(histogramOfVector(x, length, numBins, 5.0, 5.0, nullptr, rangeCounts));
+
+    delete[] x;
+}
+
+#endif //NATIVEOPERATIONS_HISTOGRAMTESTS_H
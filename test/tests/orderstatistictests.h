@@ -0,0 +1,172 @@
+//
+// Median and quantile reductions, selected on a copy of
+// every tad, against a sorted reference.
+//
+
+#ifndef NATIVEOPERATIONS_ORDERSTATISTICTESTS_H
+#define NATIVEOPERATIONS_ORDERSTATISTICTESTS_H
+#include "testhelpers.h"
+#include <algorithm>
+#include <vector>
+#include <reduce.h>
+
+TEST_GROUP(OrderStatistic) {
+
+    static int output_method(const char* output, ...) {
+        va_list arguments;
+        va_start(arguments, output);
+        va_end(arguments);
+        return 1;
+    }
+    void setup() {
+
+    }
+    void teardown() {
+        omp_set_num_threads(omp_get_num_procs());
+    }
+};
+
+/**
+ * Quantile q of length values, interpolated between the closest ranks of a sorted copy
+ */
+static double sortedQuantile(const double *x, int length, double q) {
+    std::vector<double> sorted(x, x + length);
+    std::sort(sorted.begin(), sorted.end());
+    double position = q * (length - 1);
+    int rank = (int) position;
+    if (rank + 1 >= length)
+        return sorted[rank];
+
+    return sorted[rank] + (sorted[rank + 1] - sorted[rank]) * (position - rank);
+}
+
+/**
+ * Median (op 13) and quantile q (op 14) of a vector
+ */
+static bool quantileOfVector(const double *x, int length, double q) {
+    int shape[2] = {1, length};
+    int *shapeInfo = shape::shapeBuffer(2, shape);
+    double *input = new double[length];
+    for (int i = 0; i < length; i++)
+        input[i] = x[i];
+
+    double extraParams[3] = {q, 0.0, 0.0};
+    double quantile = functions::reduce::ReduceFunction<double>::execScalar(14, input, shapeInfo, extraParams);
+    double median = functions::reduce::ReduceFunction<double>::execScalar(13, input, shapeInfo, extraParams);
+
+    bool same = true;
+    if (quantile != sortedQuantile(x, length, q)) {
+        printf("Quantile [%f] of [%d] values is %f, expected %f\n", q, length, quantile, sortedQuantile(x, length, q));
+        same = false;
+    }
+
+    if (median != sortedQuantile(x, length, 0.5)) {
+        printf("Median of [%d] values is %f, expected %f\n", length, median, sortedQuantile(x, length, 0.5));
+        same = false;
+    }
+
+    delete[] shapeInfo;
+    delete[] input;
+    return same;
+}
+
+TEST(OrderStatistic,OddAndEvenLength) {
+    double x[6] = {5, 1, 4, 2, 6, 3};
+    CHECK(quantileOfVector(x, 5, 0.5));
+    CHECK(quantileOfVector(x, 6, 0.5));
+    CHECK(quantileOfVector(x, 5, 0.25));
+    CHECK(quantileOfVector(x, 6, 0.3));
+    CHECK(quantileOfVector(x, 1, 0.7));
+}
+
+TEST(OrderStatistic,Ends) {
+    double x[7] = {3, -2, 8, 8, 0, -2, 5};
+    CHECK(quantileOfVector(x, 7, 0.0));
+    CHECK(quantileOfVector(x, 7, 1.0));
+    CHECK(quantileOfVector(x, 6, 0.0));
+    CHECK(quantileOfVector(x, 6, 1.0));
+}
+
+TEST(OrderStatistic,NaN) {
+    int shape[2] = {1, 5};
+    int *shapeInfo = shape::shapeBuffer(2, shape);
+    double x[5] = {1, 2, NAN, 4, 5};
+    double extraParams[3] = {0.0, 0.0, 0.0};
+    double median = functions::reduce::ReduceFunction<double>::execScalar(13, x, shapeInfo, extraParams);
+    double minimum = functions::reduce::ReduceFunction<double>::execScalar(14, x, shapeInfo, extraParams);
+    CHECK(median != median);
+    CHECK(minimum != minimum);
+
+    delete[] shapeInfo;
+}
+
+/**
+ * Medians along both dimensions of an f ordered [3, 4] array,
+ * so the tads along dimension 1 aren't contiguous
+ */
+TEST(OrderStatistic,StridedTads) {
+    int shape[2] = {3, 4};
+    int *shapeInfo = shape::shapeBufferFortran(2, shape);
+    int rowsShape[2] = {3, 1};
+    int *rowsShapeInfo = shape::shapeBuffer(2, rowsShape);
+    int colsShape[2] = {1, 4};
+    int *colsShapeInfo = shape::shapeBuffer(2, colsShape);
+    double x[12] = {7, 1, 4, 2, 9, 6, 5, 3, 0, 8, 11, 10};
+    double extraParams[3] = {0.0, 0.0, 0.0};
+    double result[4];
+
+    int alongCols = 1;
+    functions::reduce::ReduceFunction<double>::exec(13, x, shapeInfo, extraParams, result, rowsShapeInfo, &alongCols, 1, nullptr, nullptr);
+    for (int i = 0; i < 3; i++) {
+        double row[4] = {x[i], x[i + 3], x[i + 6], x[i + 9]};
+        DOUBLES_EQUAL(sortedQuantile(row, 4, 0.5), result[i], 0.0);
+    }
+
+    int alongRows = 0;
+    functions::reduce::ReduceFunction<double>::exec(13, x, shapeInfo, extraParams, result, colsShapeInfo, &alongRows, 1, nullptr, nullptr);
+    for (int j = 0; j < 4; j++)
+        DOUBLES_EQUAL(sortedQuantile(x + j * 3, 3, 0.5), result[j], 0.0);
+
+    delete[] shapeInfo;
+    delete[] rowsShapeInfo;
+    delete[] colsShapeInfo;
+}
+
+/**
+ * Fewer tads than threads, each long enough to be selected by all
+ * threads together, with many repeated values and once with a NaN
+ */
+TEST(OrderStatistic,SplitTads) {
+    const int rows = 2;
+    const int cols = 70001;
+    int shape[2] = {rows, cols};
+    int *shapeInfo = shape::shapeBuffer(2, shape);
+    int rowsShape[2] = {rows, 1};
+    int *rowsShapeInfo = shape::shapeBuffer(2, rowsShape);
+    double *x = new double[rows * cols];
+    for (int i = 0; i < rows * cols; i++)
+        x[i] = (double) (((long long) i * 7919) % 5003);
+
+    omp_set_num_threads(4);
+    int alongCols = 1;
+    double result[rows];
+    double quantiles[3] = {0.0, 0.37, 1.0};
+    for (int q = 0; q < 3; q++) {
+        double extraParams[3] = {quantiles[q], 0.0, 0.0};
+        functions::reduce::ReduceFunction<double>::exec(14, x, shapeInfo, extraParams, result, rowsShapeInfo, &alongCols, 1, nullptr, nullptr);
+        for (int i = 0; i < rows; i++)
+            DOUBLES_EQUAL(sortedQuantile(x + i * cols, cols, quantiles[q]), result[i], 0.0);
+    }
+
+    double extraParams[3] = {0.0, 0.0, 0.0};
+    x[cols + 12345] = NAN;
+    functions::reduce::ReduceFunction<double>::exec(13, x, shapeInfo, extraParams, result, rowsShapeInfo, &alongCols, 1, nullptr, nullptr);
+    DOUBLES_EQUAL(sortedQuantile(x, cols, 0.5), result[0], 0.0);
+    CHECK(result[1] != result[1]);
+
+    delete[] shapeInfo;
+    delete[] rowsShapeInfo;
+    delete[] x;
+}
+
+#endif //NATIVEOPERATIONS_ORDERSTATISTICTESTS_H
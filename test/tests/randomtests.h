@@ -0,0 +1,120 @@
+//
+// The counter based generator against the published known
+// answers, and random ops that don't depend on the number of
+// threads or the order of the arrays.
+//
+
+#ifndef NATIVEOPERATIONS_RANDOMTESTS_H
+#define NATIVEOPERATIONS_RANDOMTESTS_H
+#include "testhelpers.h"
+#include <random.h>
+
+TEST_GROUP(Random) {
+
+    static int output_method(const char* output, ...) {
+        va_list arguments;
+        va_start(arguments, output);
+        va_end(arguments);
+        return 1;
+    }
+    void setup() {
+
+    }
+    void teardown() {
+        omp_set_num_threads(omp_get_num_procs());
+    }
+};
+
+/**
+ * Philox4x32-10 known answers from Random123 (kat_vectors)
+ */
+TEST(Random,PhiloxKnownAnswer) {
+    nd4j::random::uint32 counters[3][4] = {
+            {0x00000000, 0x00000000, 0x00000000, 0x00000000},
+            {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+            {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}};
+    nd4j::random::uint32 keys[3][2] = {
+            {0x00000000, 0x00000000},
+            {0xffffffff, 0xffffffff},
+            {0xa4093822, 0x299f31d0}};
+    nd4j::random::uint32 expected[3][4] = {
+            {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+            {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+            {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+
+    for (int v = 0; v < 3; v++) {
+        nd4j::random::uint32 out[4];
+        nd4j::random::RandomGenerator::philox(counters[v], keys[v], out);
+        for (int w = 0; w < 4; w++)
+            CHECK_EQUAL(expected[v][w], out[w]);
+    }
+}
+
+/**
+ * Runs a random op on a [7, 13, 131] c ordered array at 1 thread and
+ * on an f ordered one at 4 threads, every element has to come out
+ * the same
+ */
+static bool sameAcrossThreadsAndOrders(int opNum, double *extraParams) {
+    int shape[3] = {7, 13, 131};
+    const int length = 7 * 13 * 131;
+    int *cShapeInfo = shape::shapeBuffer(3, shape);
+    int *fShapeInfo = shape::shapeBufferFortran(3, shape);
+    double *x = new double[length];
+    double *xF = new double[length];
+    double *expected = new double[length];
+    double *result = new double[length];
+    for (int i = 0; i < 7; i++) {
+        for (int j = 0; j < 13; j++) {
+            for (int k = 0; k < 131; k++) {
+                x[(i * 13 + j) * 131 + k] = i + j + k + 1;
+                xF[i + 7 * (j + 13 * k)] = i + j + k + 1;
+            }
+        }
+    }
+
+    omp_set_num_threads(1);
+    functions::random::RandomFunction<double>::exec(opNum, 119, 5, x, cShapeInfo, expected, cShapeInfo, extraParams);
+    omp_set_num_threads(4);
+    functions::random::RandomFunction<double>::exec(opNum, 119, 5, xF, fShapeInfo, result, fShapeInfo, extraParams);
+
+    bool same = true;
+    for (int i = 0; i < 7; i++) {
+        for (int j = 0; j < 13; j++) {
+            for (int k = 0; k < 131; k++) {
+                if (expected[(i * 13 + j) * 131 + k] != result[i + 7 * (j + 13 * k)])
+                    same = false;
+            }
+        }
+    }
+
+    if (!same)
+        printf("Random op [%d] differs between threads or orders\n", opNum);
+
+    delete[] cShapeInfo;
+    delete[] fShapeInfo;
+    delete[] x;
+    delete[] xF;
+    delete[] expected;
+    delete[] result;
+    return same;
+}
+
+TEST(Random,Uniform) {
+    double extraParams[2] = {-1.0, 3.0};
+    CHECK(sameAcrossThreadsAndOrders(0, extraParams));
+}
+
+TEST(Random,DropOut) {
+    double extraParams[1] = {0.3};
+    CHECK(sameAcrossThreadsAndOrders(5, extraParams));
+    CHECK(sameAcrossThreadsAndOrders(6, extraParams));
+}
+
+TEST(Random,Gaussian) {
+    double extraParams[2] = {1.0, 2.0};
+    CHECK(sameAcrossThreadsAndOrders(1, extraParams));
+    CHECK(sameAcrossThreadsAndOrders(2, extraParams));
+}
+
+#endif //NATIVEOPERATIONS_RANDOMTESTS_H
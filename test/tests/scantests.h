@@ -0,0 +1,164 @@
+//
+// Inclusive, exclusive and reverse scans along
+// whole arrays and strided tads.
+//
+
+#ifndef NATIVEOPERATIONS_SCANTESTS_H
+#define NATIVEOPERATIONS_SCANTESTS_H
+#include "testhelpers.h"
+#include <scan.h>
+
+TEST_GROUP(Scan) {
+
+    static int output_method(const char* output, ...) {
+        va_list arguments;
+        va_start(arguments, output);
+        va_end(arguments);
+        return 1;
+    }
+    void setup() {
+
+    }
+    void teardown() {
+        omp_set_num_threads(omp_get_num_procs());
+    }
+};
+
+/**
+ * Scans a vector and compares against the expected values
+ */
+static bool scanVector(int opNum, bool exclusive, bool reverse, const double *x, const double *expected, int length) {
+    int shape[2] = {1, length};
+    int *shapeInfo = shape::shapeBuffer(2, shape);
+    double *input = new double[length];
+    double *result = new double[length];
+    for (int i = 0; i < length; i++)
+        input[i] = x[i];
+
+    functions::scan::Scan<double>::exec(opNum, input, shapeInfo, nullptr, result, shapeInfo, nullptr, 0, exclusive, reverse, nullptr, nullptr);
+
+    bool same = true;
+    for (int i = 0; i < length; i++) {
+        if (result[i] != expected[i]) {
+            printf("Scan [%d] exclusive [%d] reverse [%d]: [%d] is %f, expected %f\n", opNum, exclusive, reverse, i, result[i], expected[i]);
+            same = false;
+        }
+    }
+
+    delete[] shapeInfo;
+    delete[] input;
+    delete[] result;
+    return same;
+}
+
+TEST(Scan,CumSum) {
+    double x[5] = {1, 2, 3, 4, 5};
+    double inclusive[5] = {1, 3, 6, 10, 15};
+    double exclusive[5] = {0, 1, 3, 6, 10};
+    double reverseInclusive[5] = {15, 14, 12, 9, 5};
+    double reverseExclusive[5] = {14, 12, 9, 5, 0};
+    CHECK(scanVector(0, false, false, x, inclusive, 5));
+    CHECK(scanVector(0, true, false, x, exclusive, 5));
+    CHECK(scanVector(0, false, true, x, reverseInclusive, 5));
+    CHECK(scanVector(0, true, true, x, reverseExclusive, 5));
+}
+
+TEST(Scan,CumProd) {
+    double x[5] = {1, 2, 3, 4, 5};
+    double inclusive[5] = {1, 2, 6, 24, 120};
+    double exclusive[5] = {1, 1, 2, 6, 24};
+    double reverseInclusive[5] = {120, 120, 60, 20, 5};
+    double reverseExclusive[5] = {120, 60, 20, 5, 1};
+    CHECK(scanVector(1, false, false, x, inclusive, 5));
+    CHECK(scanVector(1, true, false, x, exclusive, 5));
+    CHECK(scanVector(1, false, true, x, reverseInclusive, 5));
+    CHECK(scanVector(1, true, true, x, reverseExclusive, 5));
+}
+
+TEST(Scan,CumMaxMin) {
+    // exclusive max/min start from the first visited element
+    double x[5] = {3, 1, 4, 1, 5};
+    double maxInclusive[5] = {3, 3, 4, 4, 5};
+    double maxExclusive[5] = {3, 3, 3, 4, 4};
+    double maxReverse[5] = {5, 5, 5, 5, 5};
+    double minInclusive[5] = {3, 1, 1, 1, 1};
+    double minExclusive[5] = {3, 3, 1, 1, 1};
+    double minReverseExclusive[5] = {1, 1, 1, 5, 5};
+    CHECK(scanVector(2, false, false, x, maxInclusive, 5));
+    CHECK(scanVector(2, true, false, x, maxExclusive, 5));
+    CHECK(scanVector(2, false, true, x, maxReverse, 5));
+    CHECK(scanVector(3, false, false, x, minInclusive, 5));
+    CHECK(scanVector(3, true, false, x, minExclusive, 5));
+    CHECK(scanVector(3, true, true, x, minReverseExclusive, 5));
+}
+
+/**
+ * Cumulative sum of a [2, 3, 4] array along {0, 2}: every tad is a
+ * [2, 4] view with strides {12, 1}, which isn't linear in memory.
+ * The result is f ordered so its tads have different strides again.
+ */
+TEST(Scan,StridedTad) {
+    int shape[3] = {2, 3, 4};
+    int *xShapeInfo = shape::shapeBuffer(3, shape);
+    int *resultShapeInfo = shape::shapeBufferFortran(3, shape);
+    int dimension[2] = {0, 2};
+    double x[24];
+    double result[24];
+    for (int i = 0; i < 24; i++)
+        x[i] = i + 1;
+
+    for (int reverse = 0; reverse < 2; reverse++) {
+        functions::scan::Scan<double>::exec(0, x, xShapeInfo, nullptr, result, resultShapeInfo, dimension, 2, false, reverse == 1, nullptr, nullptr);
+
+        for (int j = 0; j < 3; j++) {
+            double sum = 0;
+            for (int e = 0; e < 8; e++) {
+                int p = reverse == 1 ? 7 - e : e;
+                int i = p / 4;
+                int k = p % 4;
+                sum += x[i * 12 + j * 4 + k];
+                DOUBLES_EQUAL(sum, result[i + j * 2 + k * 6], 0.0);
+            }
+        }
+    }
+
+    delete[] xShapeInfo;
+    delete[] resultShapeInfo;
+}
+
+/**
+ * A long vector is scanned in chunks when there are spare threads,
+ * the carries have to line up with the single threaded scan
+ */
+TEST(Scan,SplitTad) {
+    const int length = 100003;
+    int shape[2] = {1, length};
+    int *shapeInfo = shape::shapeBuffer(2, shape);
+    double *x = new double[length];
+    double *result = new double[length];
+    for (int i = 0; i < length; i++)
+        x[i] = i % 7;
+
+    omp_set_num_threads(4);
+    functions::scan::Scan<double>::exec(0, x, shapeInfo, nullptr, result, shapeInfo, nullptr, 0, true, false, nullptr, nullptr);
+
+    double sum = 0;
+    for (int i = 0; i < length; i++) {
+        DOUBLES_EQUAL(sum, result[i], 0.0);
+        sum += x[i];
+    }
+
+    functions::scan::Scan<double>::exec(0, x, shapeInfo, nullptr, result, shapeInfo, nullptr, 0, false, true, nullptr, nullptr);
+
+    sum = 0;
+    for (int i = length - 1; i >= 0; i--) {
+        sum += x[i];
+        DOUBLES_EQUAL(sum, result[i], 0.0);
+    }
+
+    delete[] shapeInfo;
+    delete[] x;
+    delete[] result;
+}
+
+#endif //NATIVEOPERATIONS_SCANTESTS_H
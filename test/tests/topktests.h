@@ -0,0 +1,145 @@
+//
+// Top k values and indices along whole arrays
+// and strided tads, with ties and padding.
+//
+
+#ifndef NATIVEOPERATIONS_TOPKTESTS_H
+#define NATIVEOPERATIONS_TOPKTESTS_H
+#include "testhelpers.h"
+#include <algorithm>
+#include <vector>
+#include <topk.h>
+
+TEST_GROUP(TopK) {
+
+    static int output_method(const char* output, ...) {
+        va_list arguments;
+        va_start(arguments, output);
+        va_end(arguments);
+        return 1;
+    }
+    void setup() {
+
+    }
+    void teardown() {
+        omp_set_num_threads(omp_get_num_procs());
+    }
+};
+
+/**
+ * Compares a row of top k output against a stable sort of the tad
+ * (given in c order), so ties go to the lower index. Slots past the
+ * tad length have to hold value 0 and index -1.
+ */
+static bool topKRowMatches(const double *tad, int tadLength, int k, bool largest, const double *values, const double *indices) {
+    std::vector<int> order(tadLength);
+    for (int i = 0; i < tadLength; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return largest ? tad[a] > tad[b] : tad[a] < tad[b];
+    });
+
+    bool same = true;
+    for (int j = 0; j < k; j++) {
+        double value = j < tadLength ? tad[order[j]] : 0.0;
+        double index = j < tadLength ? order[j] : -1.0;
+        if (values[j] != value || indices[j] != index) {
+            printf("TopK largest [%d]: [%d] is %f at %f, expected %f at %f\n", largest, j, values[j], indices[j], value, index);
+            same = false;
+        }
+    }
+
+    return same;
+}
+
+/**
+ * Top k of a vector, checked against the reference
+ */
+static bool topKVector(const double *x, int length, int k, bool largest) {
+    int shape[2] = {1, length};
+    int *shapeInfo = shape::shapeBuffer(2, shape);
+    double *input = new double[length];
+    double *values = new double[k];
+    double *indices = new double[k];
+    for (int i = 0; i < length; i++)
+        input[i] = x[i];
+
+    functions::topk::TopK<double>::exec(input, shapeInfo, nullptr, 0, k, largest, values, indices, nullptr, nullptr);
+    bool same = topKRowMatches(x, length, k, largest, values, indices);
+
+    delete[] shapeInfo;
+    delete[] input;
+    delete[] values;
+    delete[] indices;
+    return same;
+}
+
+TEST(TopK,Ties) {
+    double x[8] = {2, 5, 2, 5, 1, 2, 1, 5};
+    CHECK(topKVector(x, 8, 1, true));
+    CHECK(topKVector(x, 8, 3, true));
+    CHECK(topKVector(x, 8, 4, true));
+    CHECK(topKVector(x, 8, 3, false));
+    CHECK(topKVector(x, 8, 5, false));
+}
+
+/**
+ * k past the tad length sorts the whole tad and pads the row
+ */
+TEST(TopK,KLargerThanTad) {
+    double x[3] = {3, 1, 2};
+    CHECK(topKVector(x, 3, 3, true));
+    CHECK(topKVector(x, 3, 5, true));
+    CHECK(topKVector(x, 3, 5, false));
+}
+
+/**
+ * Top k of a [2, 3, 4] f ordered array along {0, 2}: every tad is
+ * a [2, 4] view with strides {1, 6}, so the c ordered index of an
+ * element isn't its place in memory.
+ */
+TEST(TopK,StridedTad) {
+    int shape[3] = {2, 3, 4};
+    int *xShapeInfo = shape::shapeBufferFortran(3, shape);
+    int dimension[2] = {0, 2};
+    double x[24];
+    for (int i = 0; i < 24; i++)
+        x[i] = (i * 7) % 5;
+
+    const int k = 10;
+    double values[3 * k];
+    double indices[3 * k];
+    for (int largest = 0; largest < 2; largest++) {
+        functions::topk::TopK<double>::exec(x, xShapeInfo, dimension, 2, k, largest == 1, values, indices, nullptr, nullptr);
+
+        for (int j = 0; j < 3; j++) {
+            double tad[8];
+            for (int i = 0; i < 2; i++)
+                for (int e = 0; e < 4; e++)
+                    tad[i * 4 + e] = x[i + j * 2 + e * 6];
+
+            CHECK(topKRowMatches(tad, 8, k, largest == 1, values + j * k, indices + j * k));
+        }
+    }
+
+    delete[] xShapeInfo;
+}
+
+/**
+ * A long vector is searched in chunks when there are spare threads,
+ * merging the chunk heaps has to keep ties in index order
+ */
+TEST(TopK,SplitTad) {
+    const int length = 100003;
+    double *x = new double[length];
+    for (int i = 0; i < length; i++)
+        x[i] = i % 97;
+
+    omp_set_num_threads(4);
+    CHECK(topKVector(x, length, 20, true));
+    CHECK(topKVector(x, length, 20, false));
+
+    delete[] x;
+}
+
+#endif //NATIVEOPERATIONS_TOPKTESTS_H